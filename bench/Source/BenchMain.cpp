@@ -0,0 +1,183 @@
+// pfs_bench: offline DSP cost of one plugin, no DAW and no editor.
+//
+// Built once per plugin against that plugin's shared code (see bench/CMakeLists.txt),
+// so createPluginFilter() is the plugin's own factory. Every combination of sample
+// rate, block size and stimulus runs on a fresh instance: prepare, warm up for half
+// a second, then time each processBlock() call. Results go out as JSON.
+// --profile switches to the worst-case latency profiler (LatencyProfiler.h).
+//
+//   pfs_bench_<Plugin> [--rates=44100,48000] [--blocks=64,512] [--stimuli=noise,drums]
+//                      [--seconds=2] [--output=results.json]
+
+#include "BlockTimes.h"
+#include "Harness.h"
+#include "LatencyProfiler.h"
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+
+struct Settings
+{
+    juce::Array<double> sampleRates { 44100.0, 48000.0, 96000.0, 192000.0 };
+    juce::Array<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    juce::Array<bench::Stimulus> stimuli;  // Empty: whatever fits the plugin
+    double seconds = 2.0;
+    juce::File output;
+};
+
+constexpr double warmUpSeconds = 0.5;
+constexpr int minimumBlocks = 100;  // Enough blocks for a p99 at the largest sizes
+
+Settings parseArguments(const juce::ArgumentList& args)
+{
+    Settings settings;
+
+    if (args.containsOption("--rates"))
+    {
+        settings.sampleRates.clear();
+
+        for (const auto& rate : bench::getListOption(args, "--rates"))
+            settings.sampleRates.add(rate.getDoubleValue());
+    }
+
+    if (args.containsOption("--blocks"))
+    {
+        settings.blockSizes.clear();
+
+        for (const auto& size : bench::getListOption(args, "--blocks"))
+            settings.blockSizes.add(size.getIntValue());
+    }
+
+    if (args.containsOption("--stimuli"))
+    {
+        for (const auto& name : bench::getListOption(args, "--stimuli"))
+            for (const auto stimulus : { bench::Stimulus::noise, bench::Stimulus::sweep, bench::Stimulus::drums, bench::Stimulus::chords })
+                if (name.trim() == bench::getName(stimulus))
+                    settings.stimuli.add(stimulus);
+    }
+
+    if (args.containsOption("--seconds"))
+        settings.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+    if (args.containsOption("--output"))
+        settings.output = args.getFileForOption("--output");
+
+    return settings;
+}
+
+juce::var runConfiguration(bench::Stimulus stimulus, double sampleRate, int blockSize, double seconds)
+{
+    auto processor = bench::createPreparedInstance(sampleRate, blockSize);
+    juce::AudioBuffer<float> buffer(juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels()), blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(4096);
+    bench::StimulusGenerator generator(stimulus, sampleRate);
+
+    const int warmUpBlocks = static_cast<int>(std::ceil(warmUpSeconds * sampleRate / blockSize));
+    const int numBlocks = juce::jmax(minimumBlocks, static_cast<int>(std::ceil(seconds * sampleRate / blockSize)));
+    bench::BlockTimes times;
+    times.reserve(static_cast<size_t>(numBlocks));
+    juce::int64 position = 0;
+
+    for (int block = 0; block < warmUpBlocks + numBlocks; ++block)
+    {
+        generator.render(buffer, midi, position);
+        position += blockSize;
+
+        const auto start = std::chrono::steady_clock::now();
+        processor->processBlock(buffer, midi);
+        const auto end = std::chrono::steady_clock::now();
+
+        if (block >= warmUpBlocks)
+            times.add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    processor->releaseResources();
+
+    const double totalNs = times.total();
+    const double numSamples = static_cast<double>(numBlocks) * blockSize;
+
+    auto* result = new juce::DynamicObject();
+    result->setProperty("stimulus", bench::getName(stimulus));
+    result->setProperty("sampleRate", sampleRate);
+    result->setProperty("blockSize", blockSize);
+    result->setProperty("channels", buffer.getNumChannels());
+    result->setProperty("blocks", numBlocks);
+    result->setProperty("nsPerSample", totalNs / numSamples);
+    result->setProperty("realtimeFactor", totalNs > 0.0 ? numSamples / sampleRate / (totalNs * 1.0e-9) : 0.0);
+
+    // Block times in microseconds, next to the budget a realtime host allows
+    auto* blockTimes = new juce::DynamicObject();
+    blockTimes->setProperty("p50", times.percentile(50.0) * 1.0e-3);
+    blockTimes->setProperty("p99", times.percentile(99.0) * 1.0e-3);
+    blockTimes->setProperty("max", times.max() * 1.0e-3);
+    blockTimes->setProperty("budget", blockSize / sampleRate * 1.0e6);
+    result->setProperty("blockMicros", juce::var(blockTimes));
+
+    return juce::var(result);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // Message manager only (no windows): some processors post async updates
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--profile"))
+        return bench::runLatencyProfile(args);
+
+    const auto settings = parseArguments(args);
+    std::unique_ptr<juce::AudioProcessor> probe(createPluginFilter());
+    const auto stimuli = settings.stimuli.isEmpty() ? bench::stimuliFor(*probe) : settings.stimuli;
+
+    juce::Array<juce::var> runs;
+    double worstRealtimeFactor = std::numeric_limits<double>::max();
+    double worstBlockMicros = 0.0;
+
+    for (const auto stimulus : stimuli)
+    {
+        for (const auto sampleRate : settings.sampleRates)
+        {
+            for (const auto blockSize : settings.blockSizes)
+            {
+                std::cerr << probe->getName() << ": " << bench::getName(stimulus) << " @ " << sampleRate << " Hz, "
+                          << blockSize << " samples" << std::endl;
+
+                auto run = runConfiguration(stimulus, sampleRate, blockSize, settings.seconds);
+                worstRealtimeFactor = juce::jmin(worstRealtimeFactor, static_cast<double>(run["realtimeFactor"]));
+                worstBlockMicros = juce::jmax(worstBlockMicros, static_cast<double>(run["blockMicros"]["max"]));
+                runs.add(run);
+            }
+        }
+    }
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("plugin", probe->getName());
+    report->setProperty("juce", juce::SystemStats::getJUCEVersion());
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("seconds", settings.seconds);
+    report->setProperty("worstRealtimeFactor", runs.isEmpty() ? 0.0 : worstRealtimeFactor);
+    report->setProperty("worstBlockMicros", worstBlockMicros);
+    report->setProperty("runs", runs);
+
+    const auto json = juce::JSON::toString(juce::var(report));
+    probe.reset();
+
+    if (settings.output == juce::File())
+    {
+        std::cout << json << std::endl;
+    }
+    else if (!settings.output.replaceWithText(json))
+    {
+        std::cerr << "Could not write " << settings.output.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Per-block processing times of one run, in nanoseconds. Reserved up front so
+// recording a block never allocates while the plugin is being timed.
+namespace bench
+{
+
+class BlockTimes
+{
+public:
+    void reserve(size_t numBlocks)
+    {
+        times.clear();
+        times.reserve(numBlocks);
+    }
+
+    void add(std::int64_t nanoseconds) noexcept { times.push_back(static_cast<double>(nanoseconds)); }
+
+    size_t size() const noexcept { return times.size(); }
+
+    double total() const noexcept
+    {
+        double sum = 0.0;
+
+        for (const auto time : times)
+            sum += time;
+
+        return sum;
+    }
+
+    // Nearest-rank percentile (p in 0..100); sorts a copy, so call after the run
+    double percentile(double p) const
+    {
+        if (times.empty())
+            return 0.0;
+
+        auto sorted = times;
+        std::sort(sorted.begin(), sorted.end());
+        const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+
+    double max() const noexcept { return times.empty() ? 0.0 : *std::max_element(times.begin(), times.end()); }
+
+private:
+    std::vector<double> times;
+};
+
+} // namespace bench
@@ -0,0 +1,100 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+// pfs_dspbench helpers: timing a stage on its own, and measuring what it aliases.
+namespace bench
+{
+
+// Nanoseconds per call of process(numSamples), per sample: best of several runs of
+// `seconds` of audio each, after a warm-up run, so scheduling noise drops out
+template <typename Process>
+double timeNsPerSample(Process&& process, double sampleRate, double seconds, int blockSize = 512)
+{
+    const auto numBlocks = juce::jmax(1, static_cast<int>(std::ceil(seconds * sampleRate / blockSize)));
+    double best = 0.0;
+
+    for (int run = 0; run < 6; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int block = 0; block < numBlocks; ++block)
+            process(blockSize);
+
+        const auto end = std::chrono::steady_clock::now();
+        const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())
+                        / (static_cast<double>(numBlocks) * blockSize);
+
+        if (run == 1 || (run > 1 && ns < best))  // Run 0 warms up
+            best = ns;
+    }
+
+    return best;
+}
+
+// Share of one core (percent) for `channels` channels of a stage costing nsPerSample
+// per channel sample at sampleRate
+inline double percentOfCore(double nsPerSample, double sampleRate, int channels)
+{
+    return nsPerSample * 1.0e-9 * sampleRate * channels * 100.0;
+}
+
+// Aliasing of a waveshaper driven by a sine on DFT bin `bin` of a
+// `length`-sample period (bin odd, so harmonics and their folds land on distinct
+// bins). Power below maxHz in bins that are not harmonics of the sine, in dB
+// relative to the fundamental. The output must be one steady-state period.
+inline double aliasPowerDb(const std::vector<float>& period, int bin, double sampleRate, double maxHz)
+{
+    const auto length = static_cast<int>(period.size());
+    const auto lastBin = juce::jmin(length / 2 - 1, static_cast<int>(maxHz / sampleRate * length));
+    double fundamental = 0.0, aliases = 0.0;
+
+    // One period of cos/sin; bin k reads it at (k * n) mod length, exact for any k
+    std::vector<double> cosine(static_cast<size_t>(length)), sine(static_cast<size_t>(length));
+
+    for (int n = 0; n < length; ++n)
+    {
+        const double phase = juce::MathConstants<double>::twoPi * n / length;
+        cosine[static_cast<size_t>(n)] = std::cos(phase);
+        sine[static_cast<size_t>(n)] = std::sin(phase);
+    }
+
+    for (int k = 1; k <= lastBin; ++k)
+    {
+        double re = 0.0, im = 0.0;
+        size_t index = 0;
+
+        for (int n = 0; n < length; ++n)
+        {
+            re += period[static_cast<size_t>(n)] * cosine[index];
+            im -= period[static_cast<size_t>(n)] * sine[index];
+            index = (index + static_cast<size_t>(k)) % static_cast<size_t>(length);
+        }
+
+        const double power = re * re + im * im;
+
+        if (k == bin)
+            fundamental = power;
+        else if (k % bin != 0)
+            aliases += power;
+    }
+
+    return 10.0 * std::log10(juce::jmax(aliases, 1.0e-30) / juce::jmax(fundamental, 1.0e-30));
+}
+
+// Fills `length` samples of a sine on DFT bin `bin` of that period
+inline std::vector<float> makeBinSine(int length, int bin, float amplitude)
+{
+    std::vector<float> sine(static_cast<size_t>(length));
+
+    for (int n = 0; n < length; ++n)
+        sine[static_cast<size_t>(n)] = amplitude * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi
+                                                                               * static_cast<double>((static_cast<juce::int64>(bin) * n) % length) / length));
+
+    return sine;
+}
+
+} // namespace bench
@@ -0,0 +1,713 @@
+// pfs_dspbench: times single DSP stages outside any plugin, and measures what the
+// nonlinear ones alias.
+//
+// pfs_bench times whole plugins with their default parameters, so a stage that is
+// off by default, or a small share of its plugin, never shows up there. Each case
+// here runs one stage on a fixed signal and prints a table: cost per sample, share of
+// one core, and for waveshapers the alias power below 20 kHz.
+//
+//   pfs_dspbench                         # every case
+//   pfs_dspbench --case=saturation --seconds=4
+
+#include "DspBench.h"
+#include "dsp/AdaaTanh.h"
+#include "dsp/FdnReverb.h"
+#include "dsp/JilesAthertonHysteresis.h"
+#include "dsp/ModulatedDelayLine.h"
+#include "dsp/QuadratureOscillator.h"
+#include "KickVoice.h"
+#include "MultibandClipper.h"
+#include <cstdio>
+#include <functional>
+#include <utility>
+
+namespace
+{
+
+// ---------------------------------------------------------------------------------
+// saturation: TapeAge's waveshaper, std::tanh against AdaaTanh (first and second
+// order) at TapeAge's 2x rate, with std::tanh at 4x and 8x for reference. Aliasing
+// is measured on the waveshaper output alone (no resampling filters): a 4.9 kHz sine
+// at the rate each variant runs at, power below 20 kHz that is not a harmonic. A
+// second table times the antiderivatives on their own, against the libm and
+// power-series versions AdaaTanh used before.
+
+// The antiderivatives as AdaaTanh first evaluated them, kept for the cost table:
+// libm per sample, and Li2 as a power series of up to 59 terms
+namespace legacy
+{
+double logCosh(double x)
+{
+    const double a = std::abs(x);
+    return a + std::log1p(std::exp(-2.0 * a)) - juce::MathConstants<double>::ln2;
+}
+
+double logCoshIntegral(double x)
+{
+    const double a = std::abs(x);
+    const double u = std::exp(-2.0 * a);
+    const double w = u / (1.0 + u);
+    double power = w;
+    double sum = 0.0;
+
+    for (int k = 1; k < 60; ++k)
+    {
+        const double term = power / static_cast<double>(k * k);
+        sum += term;
+
+        if (term < 1.0e-17)
+            break;
+
+        power *= w;
+    }
+
+    const double l = std::log1p(u);
+    const double negDilog = -sum - 0.5 * l * l;
+    const double pi2over12 = juce::MathConstants<double>::pi * juce::MathConstants<double>::pi / 12.0;
+    const double value = 0.5 * a * a - a * juce::MathConstants<double>::ln2 + 0.5 * (negDilog + pi2over12);
+    return x < 0.0 ? -value : value;
+}
+} // namespace legacy
+
+// Cost of each antiderivative per evaluation over blocks of inputs spread across
+// [-range, range], and its largest difference from the long double reference
+void runAntiderivatives(double seconds, double range)
+{
+    constexpr int blockSize = 512;
+    std::vector<double> inputs(blockSize), results(blockSize);
+
+    for (int i = 0; i < blockSize; ++i)
+        inputs[static_cast<size_t>(i)] = range * (2.0 * (i * 337 % blockSize) / (blockSize - 1) - 1.0);  // Shuffled
+
+    const auto referenceF1 = [](double x)
+    {
+        const long double a = std::abs(static_cast<long double>(x));
+        return static_cast<double>(a + std::log1p(std::exp(-2.0L * a)) - std::log(2.0L));
+    };
+
+    const auto referenceF2 = [](double x)
+    {
+        const long double a = std::abs(static_cast<long double>(x));
+        const long double u = std::exp(-2.0L * a);
+        const long double w = u / (1.0L + u);
+        long double power = w, sum = 0.0L;
+
+        for (int k = 1; k < 400; ++k, power *= w)
+            sum += power / (static_cast<long double>(k) * k);
+
+        const long double l = std::log1p(u);
+        const long double pi = 3.14159265358979323846264338327950288L;
+        const long double value = 0.5L * a * a - a * std::log(2.0L) + 0.5L * (-sum - 0.5L * l * l + pi * pi / 12.0L);
+        return static_cast<double>(x < 0.0 ? -value : value);
+    };
+
+    struct Row
+    {
+        const char* name;
+        std::function<void()> evaluate;
+        std::function<double(double)> reference;
+    };
+
+    const Row rows[] = {
+        { "F1 libm",   [&] { for (int i = 0; i < blockSize; ++i) results[static_cast<size_t>(i)] = legacy::logCosh(inputs[static_cast<size_t>(i)]); }, referenceF1 },
+        { "F1 poly",   [&] { AdaaTanh::logCosh(inputs.data(), results.data(), blockSize); }, referenceF1 },
+        { "F2 series", [&] { for (int i = 0; i < blockSize; ++i) results[static_cast<size_t>(i)] = legacy::logCoshIntegral(inputs[static_cast<size_t>(i)]); }, referenceF2 },
+        { "F2 poly",   [&] { AdaaTanh::logCoshIntegral(inputs.data(), results.data(), blockSize); }, referenceF2 },
+    };
+
+    std::printf("  antiderivatives, inputs in [-%.0f, %.0f]:\n", range, range);
+    std::printf("  %-10s %10s %14s\n", "variant", "ns/eval", "max error");
+
+    for (const auto& row : rows)
+    {
+        const double ns = bench::timeNsPerSample([&](int) { row.evaluate(); }, 96000.0, seconds, blockSize);
+
+        row.evaluate();
+        double maxError = 0.0;
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            const double reference = row.reference(inputs[static_cast<size_t>(i)]);
+            maxError = juce::jmax(maxError, std::abs(results[static_cast<size_t>(i)] - reference) / juce::jmax(1.0, std::abs(reference)));
+        }
+
+        std::printf("  %-10s %10.2f %14.2g\n", row.name, ns, maxError);
+    }
+}
+
+void runSaturation(double seconds)
+{
+    constexpr double baseRate = 48000.0;
+    constexpr int length = 16384;       // Analysis period at 2x
+    constexpr int bin = 837;            // Odd: 837 / 16384 * 96 kHz ~ 4.9 kHz
+    constexpr int settleSamples = 4096; // ADAA history before the analysed period
+
+    struct Variant
+    {
+        const char* name;
+        int factor;   // Rate multiple of baseRate
+        int order;    // 0 = std::tanh, 1 or 2 = AdaaTanh
+    };
+
+    const Variant variants[] = { { "tanh 2x", 2, 0 }, { "ADAA 2x", 2, 1 }, { "ADAA2 2x", 2, 2 },
+                                 { "tanh 4x", 4, 0 }, { "tanh 8x", 8, 0 } };
+
+    std::printf("saturation: TapeAge waveshaper, %.1f kHz sine, aliases below 20 kHz\n", bin * 2.0 * baseRate / length / 1000.0);
+    std::printf("  %-10s %6s %10s %14s %14s\n", "variant", "gain", "ns/sample", "% core stereo", "aliases (dB)");
+
+    for (const float gain : { 4.0f, 20.0f })
+    {
+        const float makeupGain = 1.0f / std::sqrt(gain);
+
+        for (const auto& variant : variants)
+        {
+            const double rate = baseRate * variant.factor;
+            const int periodLength = length * variant.factor / 2;  // Same tone at every rate
+
+            AdaaTanh saturator;
+            saturator.prepare(512);
+            saturator.setOrder(variant.order == 2 ? AdaaTanh::Order::second : AdaaTanh::Order::first);
+
+            auto shape = [&](float* data, int numSamples)
+            {
+                if (variant.order == 0)
+                {
+                    for (int i = 0; i < numSamples; ++i)
+                        data[i] = std::tanh(gain * data[i]) * makeupGain;
+                }
+                else
+                {
+                    saturator.process(data, numSamples, gain, makeupGain);
+                }
+            };
+
+            // Cost: the sine looped through 512-sample blocks (periodLength is a multiple of 512)
+            const auto source = bench::makeBinSine(periodLength, bin, 0.5f);
+            std::vector<float> block(512);
+            int position = 0;
+
+            const double ns = bench::timeNsPerSample([&](int numSamples)
+            {
+                std::copy(source.begin() + position, source.begin() + position + numSamples, block.begin());
+                position = (position + numSamples) % periodLength;
+                shape(block.data(), numSamples);
+            }, rate, seconds);
+
+            // Aliasing: one steady-state period after the history has settled
+            saturator.reset();
+            std::vector<float> settle(source.end() - settleSamples % periodLength, source.end());
+            shape(settle.data(), static_cast<int>(settle.size()));
+            auto period = source;
+            shape(period.data(), periodLength);
+
+            // Timings include copying the sine into the block, the same for every variant
+            std::printf("  %-10s %6.0f %10.2f %14.2f %14.1f\n", variant.name, gain, ns,
+                        bench::percentOfCore(ns, rate, 2),
+                        bench::aliasPowerDb(period, bin, rate, 20000.0));
+        }
+    }
+
+    runAntiderivatives(seconds, 10.0);
+}
+
+// ---------------------------------------------------------------------------------
+// kick: MinimalKick's voice before and after its phase-accumulator core. The old core
+// is kept below as it was: juce::dsp::Oscillator on a 128-point table, retuned every
+// sample from std::exp and std::pow, then std::tanh. Both render back-to-back hits
+// with the default settings, 512 samples per call.
+
+class LegacyKickVoice
+{
+public:
+    LegacyKickVoice() { oscillator.initialise([](float x) { return std::sin(x); }, 128); }
+
+    void prepare(double newSampleRate, int samplesPerBlock)
+    {
+        sampleRate = newSampleRate;
+        oscillator.prepare({ sampleRate, static_cast<juce::uint32>(samplesPerBlock), 1 });
+        envelope.setSampleRate(sampleRate);
+        envelope.reset();
+    }
+
+    void start(int midiNoteNumber, const KickSettings& settings)
+    {
+        currentFrequency = static_cast<float>(juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber));
+        oscillator.reset();
+        pitchEnvelopeSampleCount = 0;
+
+        juce::ADSR::Parameters envParams;
+        envParams.attack = settings.attackMs / 1000.0f;
+        envParams.decay = settings.decayMs / 1000.0f;
+        envParams.sustain = 0.0f;
+        envParams.release = 0.0f;
+        envelope.setParameters(envParams);
+        envelope.noteOn();
+
+        samplesRemaining = KickVoice::getHitLengthSamples(settings, sampleRate);
+    }
+
+    bool isActive() const { return samplesRemaining > 0; }
+
+    float nextSample(const KickSettings& settings)
+    {
+        float pitchDecaySeconds = settings.pitchDecayMs / 1000.0f;
+        float pitchDecayRate = -std::log(0.001f) / pitchDecaySeconds;
+
+        float elapsedSeconds = pitchEnvelopeSampleCount / static_cast<float>(sampleRate);
+        float pitchEnvelopeValue = std::exp(-pitchDecayRate * elapsedSeconds);
+        pitchEnvelopeSampleCount++;
+
+        float pitchOffsetSemitones = pitchEnvelopeValue * settings.sweepSemitones;
+        float frequencyMultiplier = std::pow(2.0f, pitchOffsetSemitones / 12.0f);
+        oscillator.setFrequency(currentFrequency * frequencyMultiplier);
+
+        float envelopedSample = oscillator.processSample(0.0f) * envelope.getNextSample();
+
+        float driveNormalized = settings.drivePercent / 100.0f;
+        float gain = 1.0f + (driveNormalized * 9.0f);
+
+        if (samplesRemaining > 0)
+            --samplesRemaining;
+
+        return std::tanh(gain * envelopedSample);
+    }
+
+private:
+    juce::dsp::Oscillator<float> oscillator;
+    juce::ADSR envelope;
+    double sampleRate { 44100.0 };
+    float currentFrequency { 0.0f };
+    int pitchEnvelopeSampleCount { 0 };
+    int samplesRemaining { 0 };
+};
+
+void runKick(double seconds)
+{
+    const KickSettings settings;
+    constexpr int note = 36;
+    std::vector<float> block(512);
+
+    std::printf("kick: MinimalKick voice, default settings, back-to-back hits\n");
+    std::printf("  %-12s %8s %10s %14s %8s\n", "core", "rate", "ns/sample", "% core/voice", "speedup");
+
+    for (const double rate : { 48000.0, 96000.0 })
+    {
+        LegacyKickVoice legacy;
+        legacy.prepare(rate, 512);
+
+        const double legacyNs = bench::timeNsPerSample([&](int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                if (!legacy.isActive())
+                    legacy.start(note, settings);
+
+                block[static_cast<size_t>(i)] = legacy.nextSample(settings);
+            }
+        }, rate, seconds);
+
+        KickVoice voice;
+        voice.prepare(rate, 512);
+
+        const double ns = bench::timeNsPerSample([&](int numSamples)
+        {
+            for (int done = 0; done < numSamples;)
+            {
+                if (!voice.isActive())
+                    voice.start(note, settings);
+
+                done += voice.renderBlock(block.data() + done, numSamples - done, settings);
+            }
+        }, rate, seconds);
+
+        std::printf("  %-12s %8.0f %10.2f %14.3f\n", "before", rate, legacyNs, bench::percentOfCore(legacyNs, rate, 1));
+        std::printf("  %-12s %8.0f %10.2f %14.3f %7.1fx\n", "after", rate, ns, bench::percentOfCore(ns, rate, 1), legacyNs / ns);
+    }
+}
+
+// ---------------------------------------------------------------------------------
+// hysteresis: TapeAge's Jiles-Atherton stage per solver at its 2x rate, one channel
+// and two (the lanes the stage runs in lockstep), on a 100 Hz sine at drive gain 8.
+
+void runHysteresis(double seconds)
+{
+    constexpr double rate = 96000.0;
+    constexpr int blockSize = 1024;
+    constexpr float gain = 8.0f;
+
+    const auto source = bench::makeBinSine(96000, 100, 0.5f);  // One second, 100 Hz
+    std::vector<float> left(blockSize), right(blockSize);
+    int position = 0;
+
+    const std::pair<const char*, JilesAthertonHysteresis::Solver> solvers[] = {
+        { "rk2", JilesAthertonHysteresis::Solver::rk2 },
+        { "rk4", JilesAthertonHysteresis::Solver::rk4 },
+        { "nr4", JilesAthertonHysteresis::Solver::nr4 },
+        { "nr8", JilesAthertonHysteresis::Solver::nr8 },
+    };
+
+    std::printf("hysteresis: TapeAge Jiles-Atherton stage at %.0f kHz, gain %.0f\n", rate / 1000.0, gain);
+    std::printf("  %-8s %14s %14s %14s %14s\n", "solver", "mono ns", "stereo ns", "stereo/mono", "% core stereo");
+
+    for (const auto& [name, solver] : solvers)
+    {
+        double ns[2] {};
+
+        for (int numChannels = 1; numChannels <= 2; ++numChannels)
+        {
+            JilesAthertonHysteresis hysteresis;
+            hysteresis.prepare(rate);
+            hysteresis.setSolver(solver);
+
+            ns[numChannels - 1] = bench::timeNsPerSample([&](int numSamples)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    left[static_cast<size_t>(i)] = right[static_cast<size_t>(i)] = source[static_cast<size_t>(position)];
+                    position = (position + 1) % static_cast<int>(source.size());
+                }
+
+                float* channels[] = { left.data(), right.data() };
+                hysteresis.process(channels, numChannels, numSamples, gain, 1.0f);
+            }, rate, seconds, blockSize);
+        }
+
+        // ns per frame: mono is one channel sample, stereo two
+        std::printf("  %-8s %14.2f %14.2f %14.2f %14.2f\n", name, ns[0], ns[1], ns[1] / ns[0],
+                    bench::percentOfCore(ns[1], rate, 1));
+    }
+}
+
+// ---------------------------------------------------------------------------------
+// delay: TapeAge's wow/flutter stage, stereo at 48 kHz with its 100 ms center and
+// full-age depth. "before" is the per-sample path it replaced, kept below: two
+// std::sin LFOs per channel sample and juce::dsp::DelayLine's setDelay, pushSample
+// and popSample. "after" is ModulatedDelayLine::process on trajectories from
+// QuadratureOscillator. The delay-only rows read the same precomputed trajectories
+// both ways, so they show the interpolation on its own.
+
+void runDelay(double seconds)
+{
+    constexpr double rate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int numChannels = 2;
+    const int maximumDelay = static_cast<int>(rate * 0.2);
+    const float center = static_cast<float>(rate * 0.1);
+    const float wowDepth = (std::pow(2.0f, 25.0f / 1200.0f) - 1.0f) * static_cast<float>(rate * 0.1);  // Full age
+    const float flutterDepth = 0.2f * wowDepth;
+    constexpr float wowHz = 2.0f, flutterHz = 6.0f;
+
+    std::vector<float> noise[numChannels], buffer[numChannels], trajectories[numChannels];
+    juce::Random random(1);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        noise[channel].resize(blockSize);
+        buffer[channel].resize(blockSize);
+        trajectories[channel].resize(blockSize);
+
+        for (auto& sample : noise[channel])
+            sample = random.nextFloat() - 0.5f;
+    }
+
+    float* channels[] { buffer[0].data(), buffer[1].data() };
+    const float* trajectoryPointers[] { trajectories[0].data(), trajectories[1].data() };
+
+    // Timings include copying the noise into the block, the same for every variant
+    const auto fillInput = [&]
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            std::copy(noise[channel].begin(), noise[channel].end(), buffer[channel].begin());
+    };
+
+    std::printf("delay: TapeAge wow/flutter, stereo, %.0f kHz, %d-sample blocks\n", rate / 1000.0, blockSize);
+    std::printf("  %-44s %10s %10s %8s\n", "variant", "ns/frame", "% core", "speedup");
+
+    // Before: per-sample LFOs and juce::dsp::DelayLine
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> legacyLine(maximumDelay);
+    legacyLine.prepare({ rate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+    float wowPhase[numChannels] { 0.0f, 1.0f }, flutterPhase[numChannels] { 0.5f, 2.0f };
+
+    const double legacyNs = bench::timeNsPerSample([&](int numSamples)
+    {
+        fillInput();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* data = channels[channel];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float modulation = std::sin(wowPhase[channel]) * wowDepth + std::sin(flutterPhase[channel]) * flutterDepth;
+                legacyLine.pushSample(channel, data[i]);
+                data[i] = legacyLine.popSample(channel, center + modulation);
+
+                wowPhase[channel] += wowHz * juce::MathConstants<float>::twoPi / static_cast<float>(rate);
+                if (wowPhase[channel] >= juce::MathConstants<float>::twoPi)
+                    wowPhase[channel] -= juce::MathConstants<float>::twoPi;
+
+                flutterPhase[channel] += flutterHz * juce::MathConstants<float>::twoPi / static_cast<float>(rate);
+                if (flutterPhase[channel] >= juce::MathConstants<float>::twoPi)
+                    flutterPhase[channel] -= juce::MathConstants<float>::twoPi;
+            }
+        }
+    }, rate, seconds, blockSize);
+
+    const auto printRow = [&](const char* name, double ns, double referenceNs)
+    {
+        std::printf("  %-44s %10.2f %10.3f", name, ns, bench::percentOfCore(ns, rate, 1));
+
+        if (referenceNs > 0.0)
+            std::printf(" %7.1fx", referenceNs / ns);
+
+        std::printf("\n");
+    };
+
+    printRow("before: std::sin + dsp::DelayLine", legacyNs, 0.0);
+
+    // After: quadrature LFO trajectories and ModulatedDelayLine
+    for (const auto interpolation : { ModulatedDelayLine::Interpolation::lagrange3rd, ModulatedDelayLine::Interpolation::hermite })
+    {
+        ModulatedDelayLine line;
+        line.prepare(numChannels, maximumDelay, blockSize);
+        line.setInterpolation(interpolation);
+        QuadratureOscillator wow[numChannels], flutter[numChannels];
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            wow[channel].setFrequency(wowHz, rate);
+            wow[channel].setPhase(channel);
+            flutter[channel].setFrequency(flutterHz, rate);
+            flutter[channel].setPhase(0.5 + 1.5 * channel);
+        }
+
+        const double ns = bench::timeNsPerSample([&](int numSamples)
+        {
+            fillInput();
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                float* trajectory = trajectories[channel].data();
+                wow[channel].render(trajectory, numSamples, wowDepth);
+                flutter[channel].renderAdd(trajectory, numSamples, flutterDepth);
+
+                for (int i = 0; i < numSamples; ++i)
+                    trajectory[i] += center;
+            }
+
+            line.process(channels, trajectoryPointers, numChannels, numSamples);
+        }, rate, seconds, blockSize);
+
+        printRow(interpolation == ModulatedDelayLine::Interpolation::lagrange3rd
+                     ? "after: quadrature LFOs + ModulatedDelayLine"
+                     : "after, Hermite", ns, legacyNs);
+    }
+
+    // Delay only, on fixed trajectories (one period of the LFOs would not fit a block)
+    for (int channel = 0; channel < numChannels; ++channel)
+        for (int i = 0; i < blockSize; ++i)
+            trajectories[channel][static_cast<size_t>(i)] = center + wowDepth * std::sin(0.01f * static_cast<float>(i + 100 * channel));
+
+    const double legacyDelayNs = bench::timeNsPerSample([&](int numSamples)
+    {
+        fillInput();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* data = channels[channel];
+            const float* trajectory = trajectoryPointers[channel];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                legacyLine.pushSample(channel, data[i]);
+                data[i] = legacyLine.popSample(channel, trajectory[i]);
+            }
+        }
+    }, rate, seconds, blockSize);
+
+    ModulatedDelayLine line;
+    line.prepare(numChannels, maximumDelay, blockSize);
+
+    const double delayNs = bench::timeNsPerSample([&](int numSamples)
+    {
+        fillInput();
+        line.process(channels, trajectoryPointers, numChannels, numSamples);
+    }, rate, seconds, blockSize);
+
+    printRow("delay only, before: dsp::DelayLine", legacyDelayNs, 0.0);
+    printRow("delay only, after: ModulatedDelayLine", delayNs, legacyDelayNs);
+}
+
+// ---------------------------------------------------------------------------------
+// multiband: AutoClip's multiband stage by crossover and band count, stereo at
+// 48 kHz, crossovers 120 Hz / 1 kHz / 6 kHz, every band clipping noise at -6 dBFS.
+
+void runMultiband(double seconds)
+{
+    constexpr double rate = 48000.0;
+    constexpr int blockSize = 512;
+    std::vector<float> left(blockSize), right(blockSize), referenceLeft(blockSize), referenceRight(blockSize);
+    juce::Random random(1);
+
+    std::printf("multiband: AutoClip multiband stage, stereo, %.0f kHz, %d-sample blocks\n", rate / 1000.0, blockSize);
+    std::printf("  %-16s %6s %10s %10s\n", "crossover", "bands", "ns/frame", "% core");
+
+    for (const auto crossover : { MultibandClipper::Crossover::linkwitzRiley, MultibandClipper::Crossover::linearPhase })
+    {
+        for (const int numBands : { 2, 4 })
+        {
+            MultibandClipper multiband;
+            multiband.prepare(rate, 2);
+            multiband.setBands(numBands, { 120.0f, 1000.0f, 6000.0f }, crossover);
+            multiband.setThresholds({ 0.5f, 0.5f, 0.5f, 0.5f });
+
+            const double ns = bench::timeNsPerSample([&](int numSamples)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    left[static_cast<size_t>(i)] = random.nextFloat() * 2.0f - 1.0f;
+                    right[static_cast<size_t>(i)] = random.nextFloat() * 2.0f - 1.0f;
+                }
+
+                float* channels[] = { left.data(), right.data() };
+                float* reference[] = { referenceLeft.data(), referenceRight.data() };
+                multiband.process(channels, reference, 2, numSamples);
+            }, rate, seconds, blockSize);
+
+            std::printf("  %-16s %6d %10.2f %10.3f\n",
+                        crossover == MultibandClipper::Crossover::linearPhase ? "linear phase" : "Linkwitz-Riley",
+                        numBands, ns, bench::percentOfCore(ns, rate, 1));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------
+// reverb: FdnReverb by quality, modulation and tank rate, against juce::Reverb (the
+// Freeverb it replaced) at the same 100% wet settings. Stereo white noise in.
+
+void runReverb(double seconds)
+{
+    constexpr int blockSize = 512;
+    std::vector<float> left(blockSize), right(blockSize);
+    juce::Random random(1);
+
+    auto fillInput = [&]
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            left[static_cast<size_t>(i)] = 0.25f * (random.nextFloat() * 2.0f - 1.0f);
+            right[static_cast<size_t>(i)] = 0.25f * (random.nextFloat() * 2.0f - 1.0f);
+        }
+    };
+
+    std::printf("reverb: stereo, 100%% wet, %d-sample blocks (rows include \"input only\")\n", blockSize);
+    std::printf("  %-30s %8s %10s %10s\n", "variant", "rate", "ns/frame", "% core");
+
+    auto report = [](const char* name, double rate, double ns)
+    {
+        std::printf("  %-30s %8.0f %10.2f %10.3f\n", name, rate, ns, bench::percentOfCore(ns, rate, 1));
+    };
+
+    struct FdnVariant
+    {
+        const char* name;
+        double rate;
+        FdnReverb::Quality quality;
+        bool modulated;
+        FdnReverb::Rate tankRate;
+    };
+
+    const FdnVariant fdnVariants[] = {
+        { "FdnReverb eco", 48000.0, FdnReverb::Quality::eco, false, FdnReverb::Rate::full },
+        { "FdnReverb standard", 48000.0, FdnReverb::Quality::standard, false, FdnReverb::Rate::full },
+        { "FdnReverb eco, modulated", 48000.0, FdnReverb::Quality::eco, true, FdnReverb::Rate::full },
+        { "FdnReverb standard, modulated", 48000.0, FdnReverb::Quality::standard, true, FdnReverb::Rate::full },
+        { "  full rate", 96000.0, FdnReverb::Quality::standard, true, FdnReverb::Rate::full },
+        { "  half rate", 96000.0, FdnReverb::Quality::standard, true, FdnReverb::Rate::half },
+        { "  quarter rate", 96000.0, FdnReverb::Quality::standard, true, FdnReverb::Rate::quarter },
+    };
+
+    report("input only", 48000.0, bench::timeNsPerSample([&](int) { fillInput(); }, 48000.0, seconds, blockSize));
+
+    for (const double rate : { 48000.0 })
+    {
+        juce::Reverb freeverb;
+        juce::Reverb::Parameters parameters;
+        parameters.wetLevel = 1.0f;
+        parameters.dryLevel = 0.0f;
+        freeverb.setParameters(parameters);
+        freeverb.setSampleRate(rate);
+
+        report("juce::Reverb (Freeverb)", rate, bench::timeNsPerSample([&](int numSamples)
+        {
+            fillInput();
+            freeverb.processStereo(left.data(), right.data(), numSamples);
+        }, rate, seconds, blockSize));
+    }
+
+    for (const auto& variant : fdnVariants)
+    {
+        if (variant.rate != 48000.0 && variant.tankRate == FdnReverb::Rate::full)
+            std::printf("  FdnReverb standard, modulated:\n");
+
+        FdnReverb reverb;
+        reverb.prepare(variant.rate, blockSize);
+        reverb.setQuality(variant.quality);
+        reverb.setRate(variant.tankRate);
+
+        FdnReverb::Parameters parameters;
+        parameters.modulationDepth = variant.modulated ? 0.5f : 0.0f;
+        reverb.setParameters(parameters);
+
+        report(variant.name, variant.rate, bench::timeNsPerSample([&](int numSamples)
+        {
+            fillInput();
+            reverb.process(left.data(), right.data(), numSamples);
+        }, variant.rate, seconds, blockSize));
+    }
+}
+
+struct Case
+{
+    const char* name;
+    std::function<void(double)> run;
+};
+
+const Case cases[] = {
+    { "saturation", runSaturation },
+    { "kick", runKick },
+    { "hysteresis", runHysteresis },
+    { "delay", runDelay },
+    { "multiband", runMultiband },
+    { "reverb", runReverb },
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList args(argc, argv);
+    const auto only = args.getValueForOption("--case");
+    const double seconds = args.containsOption("--seconds")
+                               ? juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue())
+                               : 2.0;
+    bool ran = false;
+
+    for (const auto& benchCase : cases)
+    {
+        if (only.isNotEmpty() && only != benchCase.name)
+            continue;
+
+        benchCase.run(seconds);
+        std::printf("\n");
+        ran = true;
+    }
+
+    if (!ran)
+    {
+        std::printf("unknown case '%s'\n", only.toRawUTF8());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Stimuli.h"
+#include <memory>
+
+// Shared by the harness executables: each is linked against one plugin's shared
+// code, so createPluginFilter() is that plugin's factory.
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace bench
+{
+
+// A fresh instance on its default buses, prepared for the given rate and block size
+inline std::unique_ptr<juce::AudioProcessor> createPreparedInstance(double sampleRate, int blockSize)
+{
+    std::unique_ptr<juce::AudioProcessor> processor(createPluginFilter());
+    processor->setPlayConfigDetails(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels(),
+                                    sampleRate, blockSize);
+    processor->prepareToPlay(sampleRate, blockSize);
+    return processor;
+}
+
+// Audio stimuli for plugins with an input, MIDI stimuli for plugins that take MIDI
+inline juce::Array<Stimulus> stimuliFor(const juce::AudioProcessor& processor)
+{
+    juce::Array<Stimulus> stimuli;
+
+    if (processor.getTotalNumInputChannels() > 0)
+        stimuli.addArray({ Stimulus::noise, Stimulus::sweep });
+
+    if (processor.acceptsMidi())
+        stimuli.addArray({ Stimulus::drums, Stimulus::chords });
+
+    return stimuli;
+}
+
+// "--option=a,b,c" values
+inline juce::StringArray getListOption(const juce::ArgumentList& args, juce::StringRef option)
+{
+    return juce::StringArray::fromTokens(args.getValueForOption(option), ",", {});
+}
+
+} // namespace bench
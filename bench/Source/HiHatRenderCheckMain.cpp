@@ -0,0 +1,173 @@
+// pfs_hihat_render_check: fails if OrganicHats' HiHatSynthesiser or its voices
+// allocate while rendering.
+//
+// Part of the default build and ctest (test hihat_render_allocations), unlike the
+// opt-in rtcheck_<Plugin> tests: the synthesiser and voices render on their own,
+// without the processor around them, under the checker's allocation hooks (malloc,
+// calloc, realloc, free and operator new/delete on Linux, operator new/delete
+// elsewhere). The synthesiser's own lock is not checked here.
+//
+// A fixed script covers what the render path does differently from one block to the
+// next: closed and open hits, chokes at every offset in a block, note-offs, more open
+// hats than voices (stealing), and Tone/Noise Color moving under held notes. It runs
+// at 44.1 and 96kHz, in blocks from 1 to 512 samples and in blocks longer than the
+// voices were prepared for.
+
+#include "HiHatSynthesiser.h"
+#include "PluginProcessor.h"
+#include "RealtimeChecker.h"
+#include <execinfo.h>
+#include <iostream>
+
+namespace
+{
+
+constexpr int openHatNote = 38;  // D1
+constexpr int numBlocks = 400;
+
+bool isAllocation(rtcheck::Kind kind)
+{
+    return kind != rtcheck::Kind::mutexLock && kind != rtcheck::Kind::fileOpen
+        && kind != rtcheck::Kind::fileRead && kind != rtcheck::Kind::fileWrite;
+}
+
+// Block number `block` of the script, events spread over the block
+void addEvents(juce::MidiBuffer& midi, int block, int blockSize)
+{
+    const auto at = [blockSize](int eighth) { return eighth * blockSize / 8; };
+
+    switch (block % 8)
+    {
+        case 0: midi.addEvent(juce::MidiMessage::noteOn(10, openHatNote, 0.8f), at(0)); break;
+        case 1: midi.addEvent(juce::MidiMessage::noteOn(10, HiHatSynthesiser::closedHatNote, 1.0f), at(block % 7)); break;  // Chokes
+        case 2: midi.addEvent(juce::MidiMessage::noteOn(10, openHatNote, 0.5f), at(3));
+                midi.addEvent(juce::MidiMessage::noteOff(10, openHatNote), at(6)); break;
+        case 3: midi.addEvent(juce::MidiMessage::noteOn(10, HiHatSynthesiser::closedHatNote, 0.3f), at(1));
+                midi.addEvent(juce::MidiMessage::noteOff(10, HiHatSynthesiser::closedHatNote), at(2)); break;
+        case 5:
+            // Open hats outnumbering the voices, so the last ones steal
+            for (int hit = 0; hit < HiHatSynthesiser::maxVoices + 4; ++hit)
+                midi.addEvent(juce::MidiMessage::noteOn(10, openHatNote, 0.6f), at(hit % 8));
+            break;
+        case 7: midi.addEvent(juce::MidiMessage::noteOff(10, openHatNote), at(4)); break;
+        default: break;
+    }
+}
+
+void reportAllocation(const rtcheck::Violation& violation, double sampleRate, int blockSize, int block)
+{
+    std::cout << "[hihat] " << rtcheck::getName(violation.kind);
+
+    if (violation.bytes > 0)
+        std::cout << " (" << violation.bytes << " bytes)";
+
+    std::cout << " while rendering, " << sampleRate << " Hz, " << blockSize << "-sample blocks, block " << block << "\n";
+
+    const int numFrames = violation.numFrames - rtcheck::hookFrames;
+    char** symbols = numFrames > 0 ? backtrace_symbols(violation.frames + rtcheck::hookFrames, numFrames) : nullptr;
+
+    for (int frame = 0; symbols != nullptr && frame < numFrames; ++frame)
+        std::cout << "    #" << frame << " " << symbols[frame] << "\n";
+
+    std::free(symbols);
+    std::cout << std::endl;
+}
+
+// Number of allocating blocks over one run of the script
+int runScript(OrganicHatsAudioProcessor& processor, double sampleRate, int preparedBlockSize, int blockSize)
+{
+    ParameterCache<OrganicHatsParameters> parameterCache { processor.parameters,
+                                                           { { "CLOSED_TONE", &OrganicHatsParameters::closedTone },
+                                                             { "CLOSED_DECAY", &OrganicHatsParameters::closedDecay },
+                                                             { "CLOSED_NOISE_COLOR", &OrganicHatsParameters::closedNoiseColor },
+                                                             { "OPEN_TONE", &OrganicHatsParameters::openTone },
+                                                             { "OPEN_RELEASE", &OrganicHatsParameters::openRelease },
+                                                             { "OPEN_NOISE_COLOR", &OrganicHatsParameters::openNoiseColor } } };
+    HiHatSynthesiser synth;
+
+    for (int voice = 0; voice < HiHatSynthesiser::maxVoices; ++voice)
+        synth.addVoice(new HiHatVoice(parameterCache, synth));
+
+    synth.addSound(new HiHatSound());
+    synth.setCurrentPlaybackSampleRate(sampleRate);
+
+    for (int voice = 0; voice < synth.getNumVoices(); ++voice)
+        if (auto* hiHat = dynamic_cast<HiHatVoice*>(synth.getVoice(voice)))
+            hiHat->prepareToPlay(sampleRate, preparedBlockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(4096);
+    juce::Random random { 0x4a75 };
+    int numFailed = 0;
+
+    const char* sweptIDs[] { "CLOSED_TONE", "CLOSED_NOISE_COLOR", "OPEN_TONE", "OPEN_NOISE_COLOR" };
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        // Parameters move every few blocks, as automation would (not checked)
+        if (block % 3 == 0)
+            for (const auto* id : sweptIDs)
+                processor.parameters.getParameter(id)->setValueNotifyingHost(random.nextFloat());
+
+        buffer.clear();
+        midi.clear();
+        addEvents(midi, block, blockSize);
+        rtcheck::clearViolations();
+
+        {
+            rtcheck::ScopedAudioThread audioThread;
+            synth.renderNextBlock(buffer, midi, 0, blockSize);
+        }
+
+        bool allocated = false;
+
+        for (int index = 0; index < rtcheck::getNumViolations(); ++index)
+        {
+            const auto& violation = rtcheck::getViolation(index);
+
+            if (isAllocation(violation.kind))
+            {
+                if (numFailed == 0 && !allocated)
+                    reportAllocation(violation, sampleRate, blockSize, block);
+
+                allocated = true;
+            }
+        }
+
+        if (allocated || rtcheck::getNumDropped() > 0)
+            ++numFailed;
+    }
+
+    return numFailed;
+}
+} // namespace
+
+int main()
+{
+    // Message manager only (no windows): parameter changes post async updates
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    OrganicHatsAudioProcessor processor;
+
+    struct Run { double sampleRate; int preparedBlockSize; int blockSize; };
+    const Run runs[] { { 44100.0, 512, 512 }, { 44100.0, 512, 64 }, { 96000.0, 32, 32 },
+                       { 96000.0, 1, 1 }, { 48000.0, 64, 1000 } };  // Last: longer than prepared
+    int numFailed = 0;
+
+    for (const auto& run : runs)
+    {
+        const int failed = runScript(processor, run.sampleRate, run.preparedBlockSize, run.blockSize);
+
+        if (failed > 0)
+            std::cout << "[hihat] " << failed << " of " << numBlocks << " blocks allocated at " << run.sampleRate
+                      << " Hz, " << run.blockSize << "-sample blocks (prepared for " << run.preparedBlockSize << ")" << std::endl;
+
+        numFailed += failed;
+    }
+
+    if (numFailed > 0)
+        return 1;
+
+    std::cout << "[hihat] no allocations while rendering" << std::endl;
+    return 0;
+}
@@ -0,0 +1,388 @@
+#include "LatencyProfiler.h"
+#include "BlockTimes.h"
+#include "Harness.h"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+
+namespace bench
+{
+namespace
+{
+
+struct Settings
+{
+    juce::Array<double> sampleRates { 48000.0 };
+    juce::Array<int> blockSizes { 128 };
+    int steps = 16;
+    int pairSteps = 4;
+    int blocksPerSetting = 8;
+    bool pairs = false;
+    juce::File output;
+};
+
+constexpr double warmUpSeconds = 0.5;
+constexpr int maxReportedCauses = 20;
+
+// One entry of the sweep: up to two parameters at normalised values, held for
+// blocksPerSetting blocks (parameter -1: unused)
+struct Setting
+{
+    int parameterA = -1;
+    float valueA = 0.0f;
+    int parameterB = -1;
+    float valueB = 0.0f;
+    int group = -1;  // Parameter whose histogram the blocks count towards (pairs: the first)
+};
+
+struct BlockRecord
+{
+    float micros = 0.0f;
+    int setting = 0;
+    bool transition = false;  // First block after the setting changed
+};
+
+// Log-spaced block-time histogram: four bins per octave from 0.25us
+class Histogram
+{
+public:
+    static constexpr int numBins = 96;
+
+    void add(double micros) noexcept
+    {
+        const double position = micros > firstEdge ? 4.0 * std::log2(micros / firstEdge) : 0.0;
+        ++counts[static_cast<size_t>(juce::jlimit(0, numBins - 1, static_cast<int>(position)))];
+    }
+
+    // Non-empty span only: lower bin edges in microseconds and their counts
+    juce::var toVar() const
+    {
+        int first = 0;
+        int last = numBins - 1;
+
+        while (first < numBins && counts[static_cast<size_t>(first)] == 0)
+            ++first;
+
+        while (last > first && counts[static_cast<size_t>(last)] == 0)
+            --last;
+
+        juce::Array<juce::var> edges, values;
+
+        for (int bin = first; bin <= last; ++bin)
+        {
+            edges.add(firstEdge * std::exp2(bin / 4.0));
+            values.add(counts[static_cast<size_t>(bin)]);
+        }
+
+        auto* histogram = new juce::DynamicObject();
+        histogram->setProperty("edgesMicros", edges);
+        histogram->setProperty("counts", values);
+        return juce::var(histogram);
+    }
+
+private:
+    static constexpr double firstEdge = 0.25;
+    std::array<int, numBins> counts {};
+};
+
+Settings parseArguments(const juce::ArgumentList& args)
+{
+    Settings settings;
+
+    if (args.containsOption("--rates"))
+    {
+        settings.sampleRates.clear();
+
+        for (const auto& rate : getListOption(args, "--rates"))
+            settings.sampleRates.add(rate.getDoubleValue());
+    }
+
+    if (args.containsOption("--blocks"))
+    {
+        settings.blockSizes.clear();
+
+        for (const auto& size : getListOption(args, "--blocks"))
+            settings.blockSizes.add(size.getIntValue());
+    }
+
+    if (args.containsOption("--steps"))
+        settings.steps = juce::jmax(1, args.getValueForOption("--steps").getIntValue());
+
+    if (args.containsOption("--pair-steps"))
+        settings.pairSteps = juce::jmax(1, args.getValueForOption("--pair-steps").getIntValue());
+
+    if (args.containsOption("--blocks-per-setting"))
+        settings.blocksPerSetting = juce::jmax(2, args.getValueForOption("--blocks-per-setting").getIntValue());
+
+    settings.pairs = args.containsOption("--pairs");
+
+    if (args.containsOption("--output"))
+        settings.output = args.getFileForOption("--output");
+
+    return settings;
+}
+
+// Normalised values that cover a parameter's range: every legal value of a discrete
+// parameter with few enough of them, else steps + 1 points evenly over the knob travel
+// (so the NormalisableRange's skew places them)
+juce::Array<float> valuesFor(juce::AudioProcessorParameter& parameter, int steps)
+{
+    int numSteps = steps;
+
+    if (parameter.isDiscrete() || parameter.isBoolean())
+        numSteps = juce::jlimit(1, steps, parameter.getNumSteps() - 1);
+
+    if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(&parameter))
+    {
+        const auto& range = ranged->getNormalisableRange();
+
+        if (range.interval > 0.0f)
+            numSteps = juce::jlimit(1, numSteps, juce::roundToInt((range.end - range.start) / range.interval));
+    }
+
+    juce::Array<float> values;
+
+    for (int step = 0; step <= numSteps; ++step)
+        values.add(static_cast<float>(step) / static_cast<float>(numSteps));
+
+    return values;
+}
+
+// Single-parameter sweeps (each ends back at the default), then optional pair grids
+std::vector<Setting> planSweep(const juce::Array<juce::AudioProcessorParameter*>& parameters, const Settings& settings)
+{
+    std::vector<Setting> plan;
+    plan.push_back({});  // Defaults
+
+    for (int a = 0; a < parameters.size(); ++a)
+    {
+        for (const auto value : valuesFor(*parameters[a], settings.steps))
+            plan.push_back({ a, value, -1, 0.0f, a });
+
+        plan.push_back({ a, parameters[a]->getDefaultValue(), -1, 0.0f, a });
+    }
+
+    if (!settings.pairs)
+        return plan;
+
+    for (int a = 0; a < parameters.size(); ++a)
+    {
+        for (int b = a + 1; b < parameters.size(); ++b)
+        {
+            const auto valuesA = valuesFor(*parameters[a], settings.pairSteps);
+            const auto valuesB = valuesFor(*parameters[b], settings.pairSteps);
+
+            for (const auto valueA : valuesA)
+                for (const auto valueB : valuesB)
+                    plan.push_back({ a, valueA, b, valueB, a });
+
+            plan.push_back({ a, parameters[a]->getDefaultValue(), b, parameters[b]->getDefaultValue(), a });
+        }
+    }
+
+    return plan;
+}
+
+juce::String describeValue(juce::AudioProcessorParameter& parameter, float value)
+{
+    return parameter.getText(value, 32) + parameter.getLabel();
+}
+
+juce::String describeSetting(const juce::Array<juce::AudioProcessorParameter*>& parameters, const Setting& setting)
+{
+    if (setting.parameterA < 0)
+        return "defaults";
+
+    auto& a = *parameters[setting.parameterA];
+    juce::String text = a.getName(64) + " = " + describeValue(a, setting.valueA);
+
+    if (setting.parameterB >= 0)
+    {
+        auto& b = *parameters[setting.parameterB];
+        text << ", " << b.getName(64) << " = " << describeValue(b, setting.valueB);
+    }
+
+    return text;
+}
+
+juce::var profileConfiguration(Stimulus stimulus, double sampleRate, int blockSize, const Settings& settings)
+{
+    auto processor = createPreparedInstance(sampleRate, blockSize);
+    const auto& parameters = processor->getParameters();
+    const auto plan = planSweep(parameters, settings);
+
+    juce::AudioBuffer<float> buffer(juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels()), blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(4096);
+    StimulusGenerator generator(stimulus, sampleRate);
+    juce::int64 position = 0;
+
+    auto process = [&]
+    {
+        generator.render(buffer, midi, position);
+        position += blockSize;
+
+        const auto start = std::chrono::steady_clock::now();
+        processor->processBlock(buffer, midi);
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    };
+
+    for (int block = static_cast<int>(std::ceil(warmUpSeconds * sampleRate / blockSize)); --block >= 0;)
+        process();
+
+    std::vector<BlockRecord> records;
+    records.reserve(plan.size() * static_cast<size_t>(settings.blocksPerSetting));
+
+    for (size_t index = 0; index < plan.size(); ++index)
+    {
+        const auto& setting = plan[index];
+
+        if (setting.parameterA >= 0)
+            parameters[setting.parameterA]->setValueNotifyingHost(setting.valueA);
+
+        if (setting.parameterB >= 0)
+            parameters[setting.parameterB]->setValueNotifyingHost(setting.valueB);
+
+        for (int block = 0; block < settings.blocksPerSetting; ++block)
+            records.push_back({ static_cast<float>(process() * 1.0e-3), static_cast<int>(index), block == 0 && index > 0 });
+    }
+
+    processor->releaseResources();
+
+    // Distribution: overall and per parameter
+    BlockTimes all;
+    all.reserve(records.size());
+    Histogram histogram;
+    std::vector<Histogram> parameterHistograms(static_cast<size_t>(parameters.size()));
+    std::vector<BlockTimes> parameterTimes(static_cast<size_t>(parameters.size()));
+
+    for (const auto& record : records)
+    {
+        all.add(static_cast<std::int64_t>(record.micros * 1.0e3f));
+        histogram.add(record.micros);
+
+        if (const int group = plan[static_cast<size_t>(record.setting)].group; group >= 0)
+        {
+            parameterHistograms[static_cast<size_t>(group)].add(record.micros);
+            parameterTimes[static_cast<size_t>(group)].add(static_cast<std::int64_t>(record.micros * 1.0e3f));
+        }
+    }
+
+    const double threshold = all.percentile(99.9) * 1.0e-3;
+
+    // Blocks at or above the p99.9, grouped by what they ran under
+    struct Cause { int count = 0; double maxMicros = 0.0; double sumMicros = 0.0; };
+    std::map<juce::String, Cause> causes;
+
+    for (const auto& record : records)
+    {
+        if (record.micros < threshold)
+            continue;
+
+        auto key = describeSetting(parameters, plan[static_cast<size_t>(record.setting)]);
+
+        if (record.transition)
+            key = describeSetting(parameters, plan[static_cast<size_t>(record.setting - 1)]) + " -> " + key;
+
+        auto& cause = causes[key];
+        ++cause.count;
+        cause.maxMicros = juce::jmax(cause.maxMicros, static_cast<double>(record.micros));
+        cause.sumMicros += record.micros;
+    }
+
+    std::vector<std::pair<juce::String, Cause>> worst(causes.begin(), causes.end());
+    std::sort(worst.begin(), worst.end(), [](const auto& a, const auto& b) { return a.second.maxMicros > b.second.maxMicros; });
+
+    juce::Array<juce::var> worstCauses;
+
+    for (size_t index = 0; index < juce::jmin(worst.size(), static_cast<size_t>(maxReportedCauses)); ++index)
+    {
+        auto* cause = new juce::DynamicObject();
+        cause->setProperty("cause", worst[index].first);
+        cause->setProperty("transition", worst[index].first.contains(" -> "));
+        cause->setProperty("blocks", worst[index].second.count);
+        cause->setProperty("maxMicros", worst[index].second.maxMicros);
+        cause->setProperty("meanMicros", worst[index].second.sumMicros / worst[index].second.count);
+        worstCauses.add(juce::var(cause));
+    }
+
+    juce::Array<juce::var> perParameter;
+
+    for (int index = 0; index < parameters.size(); ++index)
+    {
+        const auto& times = parameterTimes[static_cast<size_t>(index)];
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("parameter", parameters[index]->getName(64));
+        entry->setProperty("p50Micros", times.percentile(50.0) * 1.0e-3);
+        entry->setProperty("p999Micros", times.percentile(99.9) * 1.0e-3);
+        entry->setProperty("maxMicros", times.max() * 1.0e-3);
+        entry->setProperty("histogram", parameterHistograms[static_cast<size_t>(index)].toVar());
+        perParameter.add(juce::var(entry));
+    }
+
+    auto* result = new juce::DynamicObject();
+    result->setProperty("stimulus", getName(stimulus));
+    result->setProperty("sampleRate", sampleRate);
+    result->setProperty("blockSize", blockSize);
+    result->setProperty("settings", static_cast<int>(plan.size()));
+    result->setProperty("blocks", static_cast<int>(records.size()));
+    result->setProperty("budgetMicros", blockSize / sampleRate * 1.0e6);
+    result->setProperty("p50Micros", all.percentile(50.0) * 1.0e-3);
+    result->setProperty("p99Micros", all.percentile(99.0) * 1.0e-3);
+    result->setProperty("p999Micros", threshold);
+    result->setProperty("maxMicros", all.max() * 1.0e-3);
+    result->setProperty("histogram", histogram.toVar());
+    result->setProperty("worstCauses", worstCauses);
+    result->setProperty("parameters", perParameter);
+    return juce::var(result);
+}
+
+} // namespace
+
+int runLatencyProfile(const juce::ArgumentList& args)
+{
+    const auto settings = parseArguments(args);
+    std::unique_ptr<juce::AudioProcessor> probe(createPluginFilter());
+    juce::Array<juce::var> runs;
+
+    for (const auto stimulus : stimuliFor(*probe))
+    {
+        for (const auto sampleRate : settings.sampleRates)
+        {
+            for (const auto blockSize : settings.blockSizes)
+            {
+                std::cerr << probe->getName() << ": profiling " << getName(stimulus) << " @ " << sampleRate << " Hz, "
+                          << blockSize << " samples" << (settings.pairs ? " (with pairs)" : "") << std::endl;
+                runs.add(profileConfiguration(stimulus, sampleRate, blockSize, settings));
+            }
+        }
+    }
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("plugin", probe->getName());
+    report->setProperty("mode", "profile");
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("pairs", settings.pairs);
+    report->setProperty("runs", runs);
+
+    const auto json = juce::JSON::toString(juce::var(report));
+    probe.reset();
+
+    if (settings.output == juce::File())
+    {
+        std::cout << json << std::endl;
+    }
+    else if (!settings.output.replaceWithText(json))
+    {
+        std::cerr << "Could not write " << settings.output.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+} // namespace bench
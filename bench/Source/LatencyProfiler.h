@@ -0,0 +1,21 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// pfs_bench --profile: worst-case block latency across parameter space.
+//
+// Average cost hides the blocks that cause dropouts: a window regenerated when a
+// parameter moves, a sample load, a mode switch. The profiler walks each parameter
+// across its range (and, with --pairs, a coarse grid of every parameter pair), a
+// few blocks per setting, timing every block. A block's cause is the setting it
+// ran under, or the transition into it for the first block after a change. Blocks
+// at or above the p99.9 are grouped by cause and the worst causes reported, with
+// histograms overall and per parameter.
+//
+//   pfs_bench_<Plugin> --profile [--pairs] [--rates=48000] [--blocks=128] [--steps=16]
+//                      [--pair-steps=4] [--blocks-per-setting=8] [--output=profile.json]
+namespace bench
+{
+
+int runLatencyProfile(const juce::ArgumentList& args);
+
+} // namespace bench
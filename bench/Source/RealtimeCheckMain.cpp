@@ -0,0 +1,315 @@
+// pfs_rtcheck: fails if a plugin allocates, locks or touches files inside processBlock().
+//
+// Built per plugin like pfs_bench, plus the process-wide hooks of RealtimeChecker.cpp.
+// Every stimulus that fits the plugin runs on a fresh instance: a stretch at the
+// default settings, then each parameter swept from 0 to 1 in steps (as automation
+// would move it) and put back. Only processBlock() is checked; prepareToPlay(),
+// parameter changes and the harness itself run unchecked. Each distinct violation
+// (kind and call stack) is reported once with the settings that first hit it.
+//
+// --allow-locks names functions whose own locks are accepted (a lock violation whose
+// first caller outside juce::CriticalSection is in one of them): JUCE's
+// Synthesiser locks itself on every block, uncontended unless voices or sounds are
+// being changed. Those are counted and listed, but do not fail the check.
+//
+//   pfs_rtcheck_<Plugin> [--rates=48000] [--blocks=32,512] [--steps=16]
+//                        [--allow-locks=juce::Synthesiser::]
+
+#include "Harness.h"
+#include "RealtimeChecker.h"
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <iostream>
+#include <map>
+
+namespace
+{
+
+constexpr int defaultBlocks = 64;
+constexpr int blocksPerStep = 4;
+constexpr int reportedFrames = 16;
+
+// What the plugin was doing when a violation happened
+struct Context
+{
+    bench::Stimulus stimulus = bench::Stimulus::noise;
+    double sampleRate = 0.0;
+    int blockSize = 0;
+    juce::int64 block = 0;
+    juce::String sweeping;  // "Name = value" of the parameter being moved, if any
+};
+
+// "binary(mangled+0x1c) [0x...]" -> "demangled", or empty without a symbol name
+juce::String getFunctionName(const juce::String& text)
+{
+    const auto open = text.indexOfChar('(');
+    const auto plus = text.indexOfChar(open, '+');
+
+    if (open < 0 || plus < 0 || plus == open + 1)
+        return {};
+
+    const auto mangled = text.substring(open + 1, plus);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.toRawUTF8(), nullptr, nullptr, &status);
+    const juce::String name = status == 0 && demangled != nullptr ? juce::String(demangled) : mangled;
+    std::free(demangled);
+
+    return name;
+}
+
+// "binary(mangled+0x1c) [0x...]" -> "demangled +0x1c (binary)"
+juce::String describeFrame(const char* symbol)
+{
+    const juce::String text(symbol);
+    const auto open = text.indexOfChar('(');
+    const auto plus = text.indexOfChar(open, '+');
+    const auto close = text.indexOfChar(open, ')');
+    const auto name = getFunctionName(text);
+
+    if (name.isEmpty() || close < plus)
+        return text;
+
+    return name + " " + text.substring(plus, close) + " (" + text.substring(0, open) + ")";
+}
+
+// The function that took a lock: its first caller outside juce::CriticalSection
+juce::String getLockOwner(const rtcheck::Violation& violation)
+{
+    const int numFrames = violation.numFrames - rtcheck::hookFrames;
+
+    if (numFrames <= 0)
+        return {};
+
+    char** symbols = backtrace_symbols(violation.frames + rtcheck::hookFrames, numFrames);
+    juce::String owner;
+
+    for (int frame = 0; symbols != nullptr && frame < numFrames && owner.isEmpty(); ++frame)
+    {
+        const auto name = getFunctionName(symbols[frame]);
+
+        if (!name.startsWith("juce::CriticalSection::"))
+            owner = name;
+    }
+
+    std::free(symbols);
+    return owner;
+}
+
+juce::StringArray describeStack(const rtcheck::Violation& violation)
+{
+    juce::StringArray lines;
+    const int numFrames = juce::jmin(violation.numFrames - rtcheck::hookFrames, reportedFrames);
+
+    if (numFrames <= 0)
+        return lines;
+
+    char** symbols = backtrace_symbols(violation.frames + rtcheck::hookFrames, numFrames);
+
+    for (int frame = 0; frame < numFrames; ++frame)
+        lines.add("#" + juce::String(frame) + " " + (symbols != nullptr ? describeFrame(symbols[frame]) : juce::String()));
+
+    std::free(symbols);
+    return lines;
+}
+
+juce::String describeParameter(juce::AudioProcessorParameter& parameter)
+{
+    return parameter.getName(64) + " = " + parameter.getText(parameter.getValue(), 64) + parameter.getLabel();
+}
+
+class Checker
+{
+public:
+    explicit Checker(juce::StringArray lockOwnersToAllow) : allowedLockOwners(std::move(lockOwnersToAllow)) {}
+
+    int getNumDistinct() const noexcept { return static_cast<int>(seen.size()); }
+    int getNumTotal() const noexcept { return total; }
+    const std::map<juce::String, int>& getAllowedLocks() const noexcept { return allowedLocks; }
+
+    // Checks one block and reports anything it did that a realtime thread must not
+    void processBlock(juce::AudioProcessor& processor, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi, const Context& context)
+    {
+        rtcheck::clearViolations();
+
+        {
+            rtcheck::ScopedAudioThread audioThread;
+            processor.processBlock(buffer, midi);
+        }
+
+        const int numViolations = rtcheck::getNumViolations();
+        total += rtcheck::getNumDropped();
+
+        for (int index = 0; index < numViolations; ++index)
+        {
+            const auto& violation = rtcheck::getViolation(index);
+
+            if (isAllowed(violation))
+                continue;
+
+            ++total;
+            report(processor, violation, context);
+        }
+    }
+
+private:
+    bool isAllowed(const rtcheck::Violation& violation)
+    {
+        if (violation.kind != rtcheck::Kind::mutexLock || allowedLockOwners.isEmpty())
+            return false;
+
+        const auto owner = getLockOwner(violation);
+
+        for (const auto& allowed : allowedLockOwners)
+        {
+            // Function templates demangle with their return type first
+            if (owner.startsWith(allowed) || owner.contains(" " + allowed))
+            {
+                ++allowedLocks[owner];
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void report(juce::AudioProcessor& processor, const rtcheck::Violation& violation, const Context& context)
+    {
+        // Same kind from the same place: counted, not repeated
+        juce::String key(rtcheck::getName(violation.kind));
+
+        for (int frame = rtcheck::hookFrames; frame < juce::jmin(violation.numFrames, rtcheck::hookFrames + reportedFrames); ++frame)
+            key << ":" << juce::String::toHexString(reinterpret_cast<juce::pointer_sized_int>(violation.frames[frame]));
+
+        if (++seen[key] > 1)
+            return;
+
+        std::cout << "[rtcheck] " << processor.getName() << ": " << rtcheck::getName(violation.kind);
+
+        if (violation.bytes > 0)
+            std::cout << " (" << violation.bytes << " bytes)";
+
+        std::cout << " in processBlock\n"
+                  << "  " << bench::getName(context.stimulus) << ", " << context.sampleRate << " Hz, "
+                  << context.blockSize << "-sample blocks, block " << context.block << "\n";
+
+        if (context.sweeping.isNotEmpty())
+            std::cout << "  while sweeping " << context.sweeping << "\n";
+
+        std::cout << "  parameters:";
+
+        for (auto* parameter : processor.getParameters())
+            std::cout << " [" << describeParameter(*parameter) << "]";
+
+        std::cout << "\n  stack:\n";
+
+        for (const auto& line : describeStack(violation))
+            std::cout << "    " << line << "\n";
+
+        std::cout << std::endl;
+    }
+
+    juce::StringArray allowedLockOwners;
+    std::map<juce::String, int> allowedLocks;  // Lock owner -> times taken
+    std::map<juce::String, int> seen;
+    int total = 0;
+};
+
+void runStimulus(Checker& checker, bench::Stimulus stimulus, double sampleRate, int blockSize, int steps)
+{
+    auto processor = bench::createPreparedInstance(sampleRate, blockSize);
+    juce::AudioBuffer<float> buffer(juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels()), blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(4096);
+    bench::StimulusGenerator generator(stimulus, sampleRate);
+    Context context { stimulus, sampleRate, blockSize, 0, {} };
+
+    auto runBlocks = [&](int numBlocks)
+    {
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            generator.render(buffer, midi, context.block * blockSize);
+            checker.processBlock(*processor, buffer, midi, context);
+            ++context.block;
+        }
+    };
+
+    runBlocks(defaultBlocks);
+
+    for (auto* parameter : processor->getParameters())
+    {
+        const float defaultValue = parameter->getDefaultValue();
+
+        for (int step = 0; step <= steps; ++step)
+        {
+            parameter->setValueNotifyingHost(static_cast<float>(step) / static_cast<float>(steps));
+            context.sweeping = describeParameter(*parameter);
+            runBlocks(blocksPerStep);
+        }
+
+        parameter->setValueNotifyingHost(defaultValue);
+        context.sweeping = describeParameter(*parameter) + " (back to default)";
+        runBlocks(blocksPerStep);
+        context.sweeping = {};
+    }
+
+    processor->releaseResources();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // Message manager only (no windows): some processors post async updates
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args(argc, argv);
+
+    juce::Array<double> sampleRates { 48000.0 };
+    juce::Array<int> blockSizes { 32, 512 };
+    int steps = 16;
+
+    if (args.containsOption("--rates"))
+    {
+        sampleRates.clear();
+
+        for (const auto& rate : bench::getListOption(args, "--rates"))
+            sampleRates.add(rate.getDoubleValue());
+    }
+
+    if (args.containsOption("--blocks"))
+    {
+        blockSizes.clear();
+
+        for (const auto& size : bench::getListOption(args, "--blocks"))
+            blockSizes.add(size.getIntValue());
+    }
+
+    if (args.containsOption("--steps"))
+        steps = juce::jmax(1, args.getValueForOption("--steps").getIntValue());
+
+    juce::StringArray allowedLockOwners;
+
+    if (args.containsOption("--allow-locks"))
+        allowedLockOwners = bench::getListOption(args, "--allow-locks");
+
+    std::unique_ptr<juce::AudioProcessor> probe(createPluginFilter());
+    const auto stimuli = bench::stimuliFor(*probe);
+    Checker checker(allowedLockOwners);
+
+    for (const auto stimulus : stimuli)
+        for (const auto sampleRate : sampleRates)
+            for (const auto blockSize : blockSizes)
+                runStimulus(checker, stimulus, sampleRate, blockSize, steps);
+
+    for (const auto& [owner, count] : checker.getAllowedLocks())
+        std::cout << "[rtcheck] " << probe->getName() << ": allowed lock in " << owner << " (" << count << " times)\n";
+
+    std::cout << "[rtcheck] " << probe->getName() << ": ";
+
+    if (checker.getNumTotal() == 0)
+    {
+        std::cout << "no realtime violations" << std::endl;
+        return 0;
+    }
+
+    std::cout << checker.getNumDistinct() << " distinct realtime violations (" << checker.getNumTotal() << " in total)" << std::endl;
+    return 1;
+}
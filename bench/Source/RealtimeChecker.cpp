@@ -0,0 +1,338 @@
+// Process-wide hooks for the realtime-safety checker (see RealtimeChecker.h).
+// Defined in the executable, these take precedence over glibc's for every library
+// in the process; allocations forward to glibc's __libc_* entry points, the rest
+// to the next definition via dlsym(RTLD_NEXT). Other platforms get the operator
+// new/delete hooks only, forwarding to malloc and free.
+
+// The fortified inline wrappers of open/read would clash with the definitions below
+#undef _FORTIFY_SOURCE
+
+#include "RealtimeChecker.h"
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+extern "C"
+{
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void __libc_free(void*);
+}
+#endif
+
+namespace rtcheck
+{
+namespace
+{
+thread_local bool armed = false;
+thread_local bool recording = false;  // The recorder's own calls are not violations
+
+std::array<Violation, maxViolations> violations;
+std::atomic<int> numViolations { 0 };
+std::atomic<int> numDropped { 0 };
+
+// One frame deep from the hook, so hookFrames holds
+__attribute__((noinline)) void record(Kind kind, std::size_t bytes) noexcept
+{
+    if (!armed || recording)
+        return;
+
+    recording = true;
+    const int index = numViolations.load(std::memory_order_relaxed);
+
+    if (index < maxViolations)
+    {
+        auto& violation = violations[static_cast<size_t>(index)];
+        violation.kind = kind;
+        violation.bytes = bytes;
+        violation.numFrames = backtrace(violation.frames, maxFrames);
+        numViolations.store(index + 1, std::memory_order_relaxed);
+    }
+    else
+    {
+        numDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    recording = false;
+}
+
+template <typename Function>
+Function next(Function& cached, const char* name) noexcept
+{
+    if (cached == nullptr)
+        cached = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+
+    return cached;
+}
+
+// backtrace() loads its unwinder (and allocates) on first use: do that up front
+const bool unwinderLoaded = []
+{
+    void* frame = nullptr;
+    return backtrace(&frame, 1) >= 0;
+}();
+} // namespace
+
+const char* getName(Kind kind) noexcept
+{
+    switch (kind)
+    {
+        case Kind::malloc:         return "malloc";
+        case Kind::calloc:         return "calloc";
+        case Kind::realloc:        return "realloc";
+        case Kind::free:           return "free";
+        case Kind::operatorNew:    return "operator new";
+        case Kind::operatorDelete: return "operator delete";
+        case Kind::mutexLock:      return "pthread_mutex_lock";
+        case Kind::fileOpen:       return "file open";
+        case Kind::fileRead:       return "file read";
+        case Kind::fileWrite:      return "file write";
+    }
+
+    return "";
+}
+
+ScopedAudioThread::ScopedAudioThread() noexcept { armed = true; }
+ScopedAudioThread::~ScopedAudioThread() noexcept { armed = false; }
+
+int getNumViolations() noexcept { return std::min(numViolations.load(), maxViolations); }
+int getNumDropped() noexcept { return numDropped.load(); }
+const Violation& getViolation(int index) noexcept { return violations[static_cast<size_t>(index)]; }
+
+void clearViolations() noexcept
+{
+    numViolations = 0;
+    numDropped = 0;
+}
+
+} // namespace rtcheck
+
+using rtcheck::Kind;
+
+//==============================================================================
+// Allocation
+
+#if defined(__linux__)
+extern "C"
+{
+void* malloc(size_t size)
+{
+    rtcheck::record(Kind::malloc, size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    rtcheck::record(Kind::calloc, count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+    rtcheck::record(Kind::realloc, size);
+    return __libc_realloc(pointer, size);
+}
+
+void free(void* pointer)
+{
+    if (pointer != nullptr)
+        rtcheck::record(Kind::free, 0);
+
+    __libc_free(pointer);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+    rtcheck::record(Kind::malloc, size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+    rtcheck::record(Kind::malloc, size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size)
+{
+    rtcheck::record(Kind::malloc, size);
+    *result = __libc_memalign(alignment, size);
+    return *result != nullptr || size == 0 ? 0 : ENOMEM;
+}
+}
+#endif
+
+namespace
+{
+#if defined(__linux__)
+void* systemAllocate(std::size_t size, std::size_t alignment) noexcept
+{
+    return alignment > alignof(std::max_align_t) ? __libc_memalign(alignment, size) : __libc_malloc(size);
+}
+
+void systemFree(void* pointer) noexcept { __libc_free(pointer); }
+#else
+void* systemAllocate(std::size_t size, std::size_t alignment) noexcept
+{
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+
+    void* pointer = nullptr;
+    return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+}
+
+void systemFree(void* pointer) noexcept { std::free(pointer); }
+#endif
+
+void* allocate(std::size_t size, std::size_t alignment = 0)
+{
+    rtcheck::record(Kind::operatorNew, size);
+    size = size > 0 ? size : 1;
+
+    if (auto* pointer = systemAllocate(size, alignment))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* allocateNoThrow(std::size_t size, std::size_t alignment = 0) noexcept
+{
+    try { return allocate(size, alignment); }
+    catch (...) { return nullptr; }
+}
+
+void deallocate(void* pointer) noexcept
+{
+    if (pointer != nullptr)
+        rtcheck::record(Kind::operatorDelete, 0);
+
+    systemFree(pointer);
+}
+} // namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocateNoThrow(size); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateNoThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateNoThrow(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+
+//==============================================================================
+// Locks and file I/O
+
+#if defined(__linux__)
+extern "C"
+{
+int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    static int (*function)(pthread_mutex_t*) = nullptr;
+    rtcheck::record(Kind::mutexLock, 0);
+    return rtcheck::next(function, "pthread_mutex_lock")(mutex);
+}
+
+int open(const char* path, int flags, ...)
+{
+    static int (*function)(const char*, int, ...) = nullptr;
+    mode_t mode = 0;
+
+    if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE)
+    {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, unsigned int));
+        va_end(args);
+    }
+
+    rtcheck::record(Kind::fileOpen, 0);
+    return rtcheck::next(function, "open")(path, flags, mode);
+}
+
+int open64(const char* path, int flags, ...)
+{
+    static int (*function)(const char*, int, ...) = nullptr;
+    mode_t mode = 0;
+
+    if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE)
+    {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, unsigned int));
+        va_end(args);
+    }
+
+    rtcheck::record(Kind::fileOpen, 0);
+    return rtcheck::next(function, "open64")(path, flags, mode);
+}
+
+int openat(int directory, const char* path, int flags, ...)
+{
+    static int (*function)(int, const char*, int, ...) = nullptr;
+    mode_t mode = 0;
+
+    if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE)
+    {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, unsigned int));
+        va_end(args);
+    }
+
+    rtcheck::record(Kind::fileOpen, 0);
+    return rtcheck::next(function, "openat")(directory, path, flags, mode);
+}
+
+FILE* fopen(const char* path, const char* mode)
+{
+    static FILE* (*function)(const char*, const char*) = nullptr;
+    rtcheck::record(Kind::fileOpen, 0);
+    return rtcheck::next(function, "fopen")(path, mode);
+}
+
+FILE* fopen64(const char* path, const char* mode)
+{
+    static FILE* (*function)(const char*, const char*) = nullptr;
+    rtcheck::record(Kind::fileOpen, 0);
+    return rtcheck::next(function, "fopen64")(path, mode);
+}
+
+ssize_t read(int descriptor, void* buffer, size_t size)
+{
+    static ssize_t (*function)(int, void*, size_t) = nullptr;
+    rtcheck::record(Kind::fileRead, size);
+    return rtcheck::next(function, "read")(descriptor, buffer, size);
+}
+
+ssize_t write(int descriptor, const void* buffer, size_t size)
+{
+    static ssize_t (*function)(int, const void*, size_t) = nullptr;
+    rtcheck::record(Kind::fileWrite, size);
+    return rtcheck::next(function, "write")(descriptor, buffer, size);
+}
+}
+#endif
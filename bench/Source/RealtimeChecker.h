@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+
+// Realtime-safety checker for the test harness (full check opt-in: -DPFS_RT_CHECK=ON, Linux/glibc).
+//
+// RealtimeChecker.cpp replaces malloc/calloc/realloc/free, every operator new and
+// delete, pthread_mutex_lock and the file calls (open, fopen, read, write) for the
+// whole process. They forward to glibc as usual; on a thread inside a ScopedAudioThread
+// they also record a violation with its call stack. Recording never allocates (fixed
+// storage), so the harness turns violations into reports after the block.
+//
+// What it cannot see: lock-free shared state that is merely unsafe to share
+// (juce::Random::getSystemRandom() is one such), spin locks, and system calls made
+// without going through these functions. Off Linux only operator new and delete are
+// hooked: containers and new-expressions are caught, juce::HeapBlock's malloc is not.
+namespace rtcheck
+{
+
+enum class Kind { malloc, calloc, realloc, free, operatorNew, operatorDelete, mutexLock, fileOpen, fileRead, fileWrite };
+
+const char* getName(Kind kind) noexcept;
+
+constexpr int maxFrames = 32;
+constexpr int maxViolations = 256;
+
+struct Violation
+{
+    Kind kind = Kind::malloc;
+    std::size_t bytes = 0;  // Allocations only
+    int numFrames = 0;
+    void* frames[maxFrames] {};
+};
+
+// Arms the checks for the calling thread while in scope (not nestable)
+class ScopedAudioThread
+{
+public:
+    ScopedAudioThread() noexcept;
+    ~ScopedAudioThread() noexcept;
+
+    ScopedAudioThread(const ScopedAudioThread&) = delete;
+    ScopedAudioThread& operator=(const ScopedAudioThread&) = delete;
+};
+
+// Violations since the last clear (storage holds maxViolations; the rest are only counted)
+int getNumViolations() noexcept;
+int getNumDropped() noexcept;
+const Violation& getViolation(int index) noexcept;
+void clearViolations() noexcept;
+
+// Frames of the recorded stack to skip so a report starts at the caller of the hook
+constexpr int hookFrames = 2;
+
+} // namespace rtcheck
@@ -0,0 +1,142 @@
+// pfs_stability: fails if a plugin's output goes non-finite or blows up at the corners
+// of its parameter space.
+//
+// Built per plugin like pfs_bench. Filters that are only unstable at extreme
+// settings (a crossover pushed past Nyquist, a feedback gain at its maximum) stay
+// out of a parameter sweep that moves one parameter at a time from the defaults, so
+// this runs the corners instead: every parameter at its maximum, then each one in
+// turn at its minimum with the rest at maximum, and the same the other way round.
+// Each corner plays every stimulus that fits the plugin on a fresh instance.
+//
+//   pfs_stability_<Plugin> [--rates=44100,48000,96000] [--blocks=512] [--seconds=1]
+
+#include "Harness.h"
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+
+// +36dBFS: far above anything a stable plugin makes from the stimuli
+constexpr float blowUpLevel = 64.0f;
+
+// Every parameter at high or low, except the one at index flipped (-1 for none)
+void setCorner(juce::AudioProcessor& processor, bool high, int flipped)
+{
+    const auto& parameters = processor.getParameters();
+
+    for (int index = 0; index < parameters.size(); ++index)
+        parameters[index]->setValueNotifyingHost((index == flipped) != high ? 1.0f : 0.0f);
+}
+
+juce::String describeCorner(juce::AudioProcessor& processor, bool high, int flipped)
+{
+    juce::String text(high ? "all at maximum" : "all at minimum");
+
+    if (flipped >= 0)
+        text << ", " << processor.getParameters()[flipped]->getName(64) << (high ? " at minimum" : " at maximum");
+
+    return text;
+}
+
+// Plays one corner; the first bad sample, if any, is reported
+bool runCorner(bench::Stimulus stimulus, double sampleRate, int blockSize, double seconds, bool high, int flipped)
+{
+    auto processor = bench::createPreparedInstance(sampleRate, blockSize);
+    setCorner(*processor, high, flipped);
+
+    juce::AudioBuffer<float> buffer(juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels()), blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(4096);
+    bench::StimulusGenerator generator(stimulus, sampleRate);
+
+    const auto numBlocks = static_cast<int>(std::ceil(seconds * sampleRate / blockSize));
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        generator.render(buffer, midi, static_cast<juce::int64>(block) * blockSize);
+        processor->processBlock(buffer, midi);
+
+        for (int channel = 0; channel < processor->getTotalNumOutputChannels(); ++channel)
+        {
+            const float* data = buffer.getReadPointer(channel);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                if (std::isfinite(data[i]) && std::abs(data[i]) < blowUpLevel)
+                    continue;
+
+                std::cout << "[stability] " << processor->getName() << ": output " << data[i] << " on channel " << channel
+                          << " at " << (static_cast<double>(block) * blockSize + i) / sampleRate << "s\n"
+                          << "  " << bench::getName(stimulus) << ", " << sampleRate << " Hz, " << blockSize << "-sample blocks\n"
+                          << "  " << describeCorner(*processor, high, flipped) << std::endl;
+
+                processor->releaseResources();
+                return false;
+            }
+        }
+    }
+
+    processor->releaseResources();
+    return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // Message manager only (no windows): some processors post async updates
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args(argc, argv);
+
+    juce::Array<double> sampleRates { 44100.0, 48000.0, 96000.0 };
+    juce::Array<int> blockSizes { 512 };
+    double seconds = 1.0;
+
+    if (args.containsOption("--rates"))
+    {
+        sampleRates.clear();
+
+        for (const auto& rate : bench::getListOption(args, "--rates"))
+            sampleRates.add(rate.getDoubleValue());
+    }
+
+    if (args.containsOption("--blocks"))
+    {
+        blockSizes.clear();
+
+        for (const auto& size : bench::getListOption(args, "--blocks"))
+            blockSizes.add(size.getIntValue());
+    }
+
+    if (args.containsOption("--seconds"))
+        seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+    std::unique_ptr<juce::AudioProcessor> probe(createPluginFilter());
+    const auto stimuli = bench::stimuliFor(*probe);
+    const int numParameters = probe->getParameters().size();
+    int numFailed = 0;
+    int numCorners = 0;
+
+    for (const bool high : { true, false })
+        for (int flipped = -1; flipped < numParameters; ++flipped)
+            for (const auto stimulus : stimuli)
+                for (const auto sampleRate : sampleRates)
+                    for (const auto blockSize : blockSizes)
+                    {
+                        ++numCorners;
+
+                        if (!runCorner(stimulus, sampleRate, blockSize, seconds, high, flipped))
+                            ++numFailed;
+                    }
+
+    std::cout << "[stability] " << probe->getName() << ": ";
+
+    if (numFailed == 0)
+    {
+        std::cout << "finite output at all " << numCorners << " corners" << std::endl;
+        return 0;
+    }
+
+    std::cout << numFailed << " of " << numCorners << " corners blew up" << std::endl;
+    return 1;
+}
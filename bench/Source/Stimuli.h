@@ -0,0 +1,139 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+
+// Standard test signals for the benchmark harness.
+//
+// Each stimulus fills one block at a time at an absolute sample position, so a
+// run can be cut into any block size and still see the same signal. Everything is
+// deterministic (fixed noise seed, fixed patterns) so runs compare across builds.
+// Audio stimuli write every channel of the buffer and leave the MIDI empty; MIDI
+// stimuli clear the audio and add the events that fall inside the block.
+namespace bench
+{
+
+enum class Stimulus { noise, sweep, drums, chords };
+
+inline const char* getName(Stimulus stimulus)
+{
+    switch (stimulus)
+    {
+        case Stimulus::noise:  return "noise";
+        case Stimulus::sweep:  return "sweep";
+        case Stimulus::drums:  return "drums";
+        case Stimulus::chords: return "chords";
+    }
+
+    return "";
+}
+
+inline bool isMidi(Stimulus stimulus) { return stimulus == Stimulus::drums || stimulus == Stimulus::chords; }
+
+class StimulusGenerator
+{
+public:
+    StimulusGenerator(Stimulus type, double sampleRate) : stimulus(type), rate(sampleRate) {}
+
+    void render(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi, juce::int64 position)
+    {
+        midi.clear();
+
+        switch (stimulus)
+        {
+            case Stimulus::noise:  renderNoise(buffer); break;
+            case Stimulus::sweep:  renderSweep(buffer, position); break;
+            case Stimulus::drums:  buffer.clear(); renderDrums(midi, position, buffer.getNumSamples()); break;
+            case Stimulus::chords: buffer.clear(); renderChords(midi, position, buffer.getNumSamples()); break;
+        }
+    }
+
+private:
+    // White noise at -12dBFS, independent per channel
+    void renderNoise(juce::AudioBuffer<float>& buffer)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* data = buffer.getWritePointer(channel);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = 0.25f * (2.0f * random.nextFloat() - 1.0f);
+        }
+    }
+
+    // Exponential sine sweep 20Hz to 20kHz (or just under Nyquist) once a second at -6dBFS
+    void renderSweep(juce::AudioBuffer<float>& buffer, juce::int64 position)
+    {
+        const double length = rate;
+        const double startFrequency = 20.0;
+        const double ratio = juce::jmin(20000.0, 0.45 * rate) / startFrequency;
+        const double k = length / std::log(ratio);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            const double t = static_cast<double>((position + i) % static_cast<juce::int64>(length));
+            const double phase = juce::MathConstants<double>::twoPi * startFrequency * k / rate * (std::exp(t / k) - 1.0);
+            const float sample = 0.5f * static_cast<float>(std::sin(phase));
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.setSample(channel, i, sample);
+        }
+    }
+
+    // One bar of 16ths at 120 BPM on the General MIDI drum map: kick, snare, clap,
+    // closed and open hats, toms. Each hit is released a 32nd later.
+    void renderDrums(juce::MidiBuffer& midi, juce::int64 position, int numSamples)
+    {
+        struct Hit { int step; int note; juce::uint8 velocity; };
+        static constexpr Hit pattern[] {
+            { 0, 36, 120 }, { 0, 42, 90 }, { 2, 42, 60 }, { 4, 38, 110 }, { 4, 39, 80 }, { 4, 42, 90 },
+            { 6, 42, 60 }, { 7, 36, 90 }, { 8, 36, 120 }, { 8, 42, 90 }, { 10, 46, 80 }, { 12, 38, 110 },
+            { 12, 42, 90 }, { 13, 45, 100 }, { 14, 48, 100 }, { 15, 42, 50 }
+        };
+
+        const double stepLength = rate * 60.0 / 120.0 / 4.0;
+
+        for (const auto& hit : pattern)
+        {
+            addRepeating(midi, juce::MidiMessage::noteOn(10, hit.note, hit.velocity), hit.step * stepLength, 16.0 * stepLength, position, numSamples);
+            addRepeating(midi, juce::MidiMessage::noteOff(10, hit.note), (hit.step + 0.5) * stepLength, 16.0 * stepLength, position, numSamples);
+        }
+    }
+
+    // Four-note chords, one per bar at 120 BPM (Cmaj7, Am7, Fmaj7, G7), held for
+    // the whole bar so voices overlap through their release
+    void renderChords(juce::MidiBuffer& midi, juce::int64 position, int numSamples)
+    {
+        static constexpr int chords[4][4] { { 48, 52, 55, 59 }, { 45, 48, 52, 55 }, { 41, 45, 48, 52 }, { 43, 47, 50, 53 } };
+        const double barLength = rate * 2.0;
+
+        for (int chord = 0; chord < 4; ++chord)
+        {
+            for (const int note : chords[chord])
+            {
+                addRepeating(midi, juce::MidiMessage::noteOn(1, note, static_cast<juce::uint8>(100)), chord * barLength, 4.0 * barLength, position, numSamples);
+                addRepeating(midi, juce::MidiMessage::noteOff(1, note), (chord + 0.95) * barLength, 4.0 * barLength, position, numSamples);
+            }
+        }
+    }
+
+    // Adds message at offset + n * period for every n that lands in [position, position + numSamples)
+    static void addRepeating(juce::MidiBuffer& midi, const juce::MidiMessage& message, double offset, double period,
+                             juce::int64 position, int numSamples)
+    {
+        const auto periodSamples = static_cast<juce::int64>(period);
+        const auto offsetSamples = static_cast<juce::int64>(offset);
+        auto first = position - (position % periodSamples) + offsetSamples;
+
+        if (first < position)
+            first += periodSamples;
+
+        for (auto time = first; time < position + numSamples; time += periodSamples)
+            midi.addEvent(message, static_cast<int>(time - position));
+    }
+
+    Stimulus stimulus;
+    double rate;
+    juce::Random random { 0x5eed };
+};
+
+} // namespace bench
@@ -74,6 +74,13 @@ AngelGrainAudioProcessor::AngelGrainAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "delayTime", &AngelGrainParameters::delayTime },
+                                   { "grainSize", &AngelGrainParameters::grainSize },
+                                   { "feedback", &AngelGrainParameters::feedback },
+                                   { "chaos", &AngelGrainParameters::chaos },
+                                   { "character", &AngelGrainParameters::character },
+                                   { "mix", &AngelGrainParameters::mix },
+                                   { "tempoSync", &AngelGrainParameters::tempoSync } })
 {
 }
 
@@ -92,9 +99,7 @@ void AngelGrainAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
 
     // Prepare grain buffer with stereo spec (preserves stereo field)
     int maxDelaySamples = static_cast<int>(sampleRate * maxDelaySeconds);
-    grainBuffer.setMaximumDelayInSamples(maxDelaySamples);
-    grainBuffer.prepare(spec);
-    grainBuffer.reset();
+    grainBuffer.prepare(2, maxDelaySamples, samplesPerBlock);
 
     // Note: Using manual linear dry/wet mixing instead of DryWetMixer
     // for more intuitive behavior at 50% (full dry + full wet)
@@ -125,26 +130,68 @@ void AngelGrainAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     feedbackSampleR = 0.0f;
 
     // Calculate initial grain interval from delayTime parameter
-    auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
-    float delayTimeMs = delayTimeParam->load();
+    float delayTimeMs = parameterCache.load().delayTime;
     nextGrainInterval = static_cast<int>((delayTimeMs / 1000.0f) * sampleRate);
 
     // Pre-allocate stereo buffers for real-time safety
     wetBuffer.setSize(2, samplesPerBlock);
     dryBuffer.setSize(2, samplesPerBlock);
+
+    silenceDetector.prepare(sampleRate);
 }
 
 void AngelGrainAudioProcessor::releaseResources()
 {
 }
 
+double AngelGrainAudioProcessor::computeTailSeconds() const
+{
+    const auto params = parameterCache.load();
+    const float delayTimeMs = params.delayTime;
+    const float grainSizeMs = params.grainSize;
+    const float characterAmount = params.character / 100.0f;
+    const double feedbackGain = params.feedback / 100.0 * 0.95;
+
+    // Overlapping grains add up: at short intervals the loop gain can reach 1 and the
+    // tanh-limited feedback keeps ringing (infinite tail). Tempo sync can move the delay
+    // anywhere in the buffer, so each pass is taken as the full buffer plus one grain.
+    const float intervalMs = delayTimeMs / (1.0f + characterAmount * 3.0f);
+    const double overlap = juce::jlimit(1.0, static_cast<double>(maxGrainVoices), static_cast<double>(grainSizeMs / intervalMs));
+
+    return SilenceDetector::feedbackTailSeconds(maxDelaySeconds + grainSizeMs / 1000.0, feedbackGain * overlap);
+}
+
 void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("AngelGrain", "processBlock");
     juce::ignoreUnused(midiMessages);
 
     const int numSamples = buffer.getNumSamples();
 
+    // Skip the grain engine once the input has been silent for longer than the tail
+    silenceDetector.setTailSeconds(computeTailSeconds());
+    const auto activity = silenceDetector.update(buffer.getArrayOfReadPointers(),
+                                                 juce::jmin(getTotalNumInputChannels(), buffer.getNumChannels()),
+                                                 numSamples);
+
+    if (activity != SilenceDetector::State::processing)
+    {
+        // Start the next sound from an empty grain buffer (new grains fade in on their window)
+        if (activity == SilenceDetector::State::enteringSleep)
+        {
+            grainBuffer.reset();
+            feedbackSampleL = 0.0f;
+            feedbackSampleR = 0.0f;
+
+            for (auto& voice : grainVoices)
+                voice.active = false;
+        }
+
+        buffer.clear();
+        return;
+    }
+
     // Ensure buffers are large enough (in case host uses different block size)
     if (wetBuffer.getNumSamples() < numSamples)
     {
@@ -152,20 +199,15 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         dryBuffer.setSize(2, numSamples, false, false, true);
     }
 
-    // Read parameters atomically
-    auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
-    auto* mixParam = parameters.getRawParameterValue("mix");
-    auto* feedbackParam = parameters.getRawParameterValue("feedback");
-    auto* characterParam = parameters.getRawParameterValue("character");
-    auto* chaosParam = parameters.getRawParameterValue("chaos");
-    auto* tempoSyncParam = parameters.getRawParameterValue("tempoSync");
-
-    float delayTimeMs = delayTimeParam->load();
-    float mixValue = mixParam->load() / 100.0f;
-    float feedbackGain = (feedbackParam->load() / 100.0f) * 0.95f;  // Map 0-100% to 0-0.95
-    float characterAmount = characterParam->load() / 100.0f;
-    float chaosAmount = chaosParam->load() / 100.0f;
-    bool tempoSyncEnabled = tempoSyncParam->load() > 0.5f;
+    // Read parameters atomically (one snapshot for the block, grains spawned in it included)
+    const auto params = parameterCache.load();
+
+    float delayTimeMs = params.delayTime;
+    float mixValue = params.mix / 100.0f;
+    float feedbackGain = (params.feedback / 100.0f) * 0.95f;  // Map 0-100% to 0-0.95
+    float characterAmount = params.character / 100.0f;
+    float chaosAmount = params.chaos / 100.0f;
+    bool tempoSyncEnabled = params.tempoSync;
 
     // Tempo sync: quantize delay time to note divisions
     if (tempoSyncEnabled)
@@ -215,7 +257,9 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         dryBuffer.setSample(1, i, inputR[i]);
     }
 
-    // Process sample by sample
+    // Process sample by sample (traced to the end of the block, mix included)
+    PFS_TRACE_SCOPE("AngelGrain", "grain engine");
+
     for (int sample = 0; sample < numSamples; ++sample)
     {
         // Mix feedback with input before writing to grain buffer (stereo)
@@ -223,8 +267,8 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         float inputWithFeedbackR = inputR[sample] + feedbackSampleR;
 
         // Write to grain buffer (stereo input + feedback)
-        grainBuffer.pushSample(0, inputWithFeedbackL);
-        grainBuffer.pushSample(1, inputWithFeedbackR);
+        const float inputFrame[2] { inputWithFeedbackL, inputWithFeedbackR };
+        grainBuffer.write(inputFrame, 2);
 
         // Calculate grain interval with chaos timing jitter
         int currentInterval = nextGrainInterval;
@@ -239,7 +283,7 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         samplesSinceLastGrain++;
         if (samplesSinceLastGrain >= currentInterval && currentInterval > 0)
         {
-            spawnGrain();
+            spawnGrain(params);
             samplesSinceLastGrain = 0;
         }
 
@@ -252,10 +296,10 @@ void AngelGrainAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
             if (!voice.active)
                 continue;
 
-            // Read from delay buffer with interpolation (stereo)
-            float delaySamples = std::max(0.0f, voice.readPosition);
-            float grainSampleL = grainBuffer.popSample(0, delaySamples, false);
-            float grainSampleR = grainBuffer.popSample(1, delaySamples, false);
+            // Read from delay buffer with interpolation (stereo, one set of weights for both channels)
+            auto tap = grainBuffer.makeTap(voice.readPosition);
+            float grainSampleL = grainBuffer.read(0, tap);
+            float grainSampleR = grainBuffer.read(1, tap);
 
             // Apply window envelope with Tukey alpha (character control)
             float windowGain = getWindowSample(voice.windowPosition, tukeyAlpha);
@@ -341,8 +385,10 @@ void AngelGrainAudioProcessor::setStateInformation(const void* data, int sizeInB
         parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
 }
 
-void AngelGrainAudioProcessor::spawnGrain()
+void AngelGrainAudioProcessor::spawnGrain(const AngelGrainParameters& params)
 {
+    PFS_TRACE_SCOPE("AngelGrain", "spawnGrain");
+
     // Find a free voice
     int voiceIndex = findFreeVoice();
     if (voiceIndex < 0)
@@ -350,14 +396,10 @@ void AngelGrainAudioProcessor::spawnGrain()
 
     auto& voice = grainVoices[static_cast<size_t>(voiceIndex)];
 
-    // Read parameters
-    auto* grainSizeParam = parameters.getRawParameterValue("grainSize");
-    auto* delayTimeParam = parameters.getRawParameterValue("delayTime");
-    auto* chaosParam = parameters.getRawParameterValue("chaos");
-
-    float grainSizeMs = grainSizeParam->load();
-    float delayTimeMs = delayTimeParam->load();
-    float chaosAmount = chaosParam->load() / 100.0f;  // Normalize to 0.0-1.0
+    // Parameters from the block's snapshot
+    float grainSizeMs = params.grainSize;
+    float delayTimeMs = params.delayTime;
+    float chaosAmount = params.chaos / 100.0f;  // Normalize to 0.0-1.0
 
     // Calculate grain length in samples
     voice.grainLengthSamples = static_cast<int>((grainSizeMs / 1000.0f) * currentSampleRate);
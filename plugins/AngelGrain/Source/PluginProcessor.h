@@ -1,6 +1,10 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/ModulatedDelayLine.h"
+#include "dsp/SilenceDetector.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
 
 // Grain voice structure for polyphonic grain management
 struct GrainVoice
@@ -14,6 +18,18 @@ struct GrainVoice
     bool active = false;            // Whether this voice is currently playing
 };
 
+// Parameter values for one block (raw units: ms and %)
+struct AngelGrainParameters
+{
+    float delayTime;
+    float grainSize;
+    float feedback;
+    float chaos;
+    float character;
+    float mix;
+    bool tempoSync;
+};
+
 class AngelGrainAudioProcessor : public juce::AudioProcessor
 {
 public:
@@ -31,7 +47,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return computeTailSeconds(); }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -47,11 +63,14 @@ public:
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<AngelGrainParameters> parameterCache;
+
     // DSP Components
     juce::dsp::ProcessSpec spec;
 
     // Grain buffer (circular delay line)
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> grainBuffer;
+    ModulatedDelayLine grainBuffer;  // Lagrange3rd; one tap per grain serves both channels
     static constexpr int maxDelaySeconds = 2;
     int writePosition = 0;
 
@@ -83,13 +102,20 @@ private:
     float feedbackSampleL = 0.0f;
     float feedbackSampleR = 0.0f;
 
+    // Sleeps once the input has been silent for longer than the tail
+    SilenceDetector silenceDetector;
+    double computeTailSeconds() const;
+
     // Helper methods
-    void spawnGrain();
+    void spawnGrain(const AngelGrainParameters& params);
     float getWindowSample(float normalizedPosition, float tukeyAlpha);
     int findFreeVoice();
     int selectPitchShift(float chaosAmount);
     float calculatePlaybackRate(int semitones);
     float quantizeDelayTimeToTempo(float delayTimeMs, double bpm);
 
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("AngelGrain");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AngelGrainAudioProcessor)
 };
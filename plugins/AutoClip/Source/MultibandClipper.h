@@ -0,0 +1,609 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+// AutoClip's multiband stage: splits the signal into 2-4 bands, hard-clips each at
+// its own threshold and sums them back.
+//
+// Two crossovers:
+//   linkwitzRiley - 4th-order Linkwitz-Riley splits, no latency. Each band is a chain
+//                   of three sections (per split: the low-pass, the high-pass or the
+//                   allpass their sum makes), so every band depends only on the input
+//                   and the four bands run side by side as the lanes of one vector:
+//                   six biquad steps per sample for all bands at once, then the four
+//                   clips and the sum. The bands sum to an allpass of the input.
+//   linearPhase   - windowed-sinc FIR bands, each the difference of two adjacent
+//                   low-passes, so they telescope to the input delayed by half the
+//                   filter. The low-passes run as uniformly partitioned FFT convolution
+//                   (overlap-save, 16 partitions): one forward FFT per partition shared
+//                   by all of them, one inverse each. Latency is one partition plus
+//                   half the filter (48ms at 48kHz). Moving a crossover redesigns the
+//                   filters one partition per partition, a few microseconds at a time,
+//                   and swaps them in once complete (about 85ms later). Moves made
+//                   while a design runs wait for it and queue only the latest target,
+//                   so a sweep steps through designs every 85ms rather than never
+//                   finishing one.
+//
+// process() also outputs the unclipped sum (the input with the crossover's phase
+// response and delay), the reference the clip solo and the loudness match compare
+// against. The reconstruction is checked in debug builds.
+class MultibandClipper
+{
+public:
+    enum class Crossover { linkwitzRiley, linearPhase };
+
+    static constexpr int maxBands = 4;
+    static constexpr int maxChannels = 2;
+
+    // Allocates (not on the audio thread)
+    void prepare(double newSampleRate, int numChannels)
+    {
+        sampleRate = newSampleRate;
+        channels = juce::jlimit(1, maxChannels, numChannels);
+
+        // FIR of 2^n - 1 taps spanning about 80ms, in 16 partitions
+        firLength = juce::nextPowerOfTwo(static_cast<int>(0.08 * sampleRate)) - 1;
+        partitionSize = (firLength + 1) / numPartitions;
+        centreTap = (firLength - 1) / 2;
+        spectrumSize = partitionSize + 1;
+
+        const int fftSize = 2 * partitionSize;
+        fft = std::make_unique<juce::dsp::FFT>(static_cast<int>(std::log2(fftSize)));
+        fftBuffer.assign(static_cast<size_t>(2 * fftSize), 0.0f);
+        accumulator.assign(static_cast<size_t>(2 * fftSize), 0.0f);
+
+        window.resize(static_cast<size_t>(firLength));
+
+        for (int n = 0; n < firLength; ++n)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * n / (firLength - 1);
+            window[static_cast<size_t>(n)] = static_cast<float>(0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase));  // Blackman
+        }
+
+        for (auto& set : lowPassSpectra)
+            set.assign(static_cast<size_t>((maxBands - 1) * numPartitions * 2 * spectrumSize), 0.0f);
+
+        for (int channel = 0; channel < maxChannels; ++channel)
+        {
+            auto& state = firState[static_cast<size_t>(channel)];
+            state.input.assign(static_cast<size_t>(fftSize), 0.0f);
+            state.dry.assign(static_cast<size_t>(centreTap + partitionSize), 0.0f);
+            state.output.assign(static_cast<size_t>(partitionSize), 0.0f);
+            state.reference.assign(static_cast<size_t>(partitionSize), 0.0f);
+            state.spectra.assign(static_cast<size_t>(numPartitions * 2 * spectrumSize), 0.0f);
+        }
+
+        lowPassOutput.assign(static_cast<size_t>((maxBands - 1) * partitionSize), 0.0f);
+
+        // Design the current crossover in full, so the FIR mode starts ready
+        updateLinkwitzRiley();
+        designing = false;
+        designQueued = false;
+        startDesign();
+
+        while (designing)
+            designNextPartition();
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& channel : lrState)
+            channel = {};
+
+        for (auto& state : firState)
+        {
+            std::fill(state.input.begin(), state.input.end(), 0.0f);
+            std::fill(state.dry.begin(), state.dry.end(), 0.0f);
+            std::fill(state.output.begin(), state.output.end(), 0.0f);
+            std::fill(state.reference.begin(), state.reference.end(), 0.0f);
+            std::fill(state.spectra.begin(), state.spectra.end(), 0.0f);
+        }
+
+        fifoPosition = 0;
+        newestPartition = 0;
+    }
+
+    // Crossover frequencies are sorted into ascending bands at least a third of an
+    // octave apart, as far as 0.45 of the sample rate allows: splits pushed past it
+    // stay there (and coincide). A new crossover type starts from clean state.
+    void setBands(int newNumBands, const std::array<float, maxBands - 1>& newCrossoverHz, Crossover newType) noexcept
+    {
+        newNumBands = juce::jlimit(1, maxBands, newNumBands);
+        std::array<float, maxBands - 1> frequencies {};
+        const float highest = 0.45f * static_cast<float>(sampleRate);
+
+        for (size_t split = 0; split < frequencies.size(); ++split)
+        {
+            const float lowest = split == 0 ? 20.0f : juce::jmin(frequencies[split - 1] * 1.26f, highest);
+            frequencies[split] = juce::jlimit(lowest, highest, newCrossoverHz[split]);
+        }
+
+        if (newType != type)
+        {
+            type = newType;
+            reset();
+        }
+
+        if (newNumBands == numBands && frequencies == crossoverHz)
+            return;
+
+        numBands = newNumBands;
+        crossoverHz = frequencies;
+        updateLinkwitzRiley();
+        startDesign();
+    }
+
+    // Linear clip levels per band
+    void setThresholds(const std::array<float, maxBands>& newThresholds) noexcept { thresholds = newThresholds; }
+
+    int getNumBands() const noexcept { return numBands; }
+
+    int getLatencySamples() const noexcept
+    {
+        return type == Crossover::linearPhase ? partitionSize + centreTap : 0;
+    }
+
+    int getMaximumLatencySamples() const noexcept { return partitionSize + centreTap; }
+
+    // In place: band-split, clipped and summed. reference receives the unclipped sum.
+    void process(float* const* data, float* const* reference, int numChannels, int numSamples) noexcept
+    {
+        numChannels = juce::jmin(numChannels, channels);
+
+        if (type == Crossover::linkwitzRiley)
+            processLinkwitzRiley(data, reference, numChannels, numSamples);
+        else
+            processLinearPhase(data, reference, numChannels, numSamples);
+    }
+
+    // Largest deviation (dB) of the unclipped band sum from a perfect reconstruction:
+    // flat magnitude for Linkwitz-Riley (measured on the designed responses, 20Hz to
+    // 20kHz). Linear-phase bands sum to the delayed input by construction, so for
+    // them it is the designed bands' error at DC and Nyquist, which only the lowest
+    // and the highest band respectively should pass (measured at each swap).
+    float getReconstructionErrorDb() const noexcept
+    {
+        if (type == Crossover::linearPhase)
+            return lastReconstructionErrorDb;
+
+        float worst = 0.0f;
+
+        for (int point = 0; point < 64; ++point)
+        {
+            const double hz = 20.0 * std::pow(1000.0, point / 63.0);
+
+            if (hz >= 0.45 * sampleRate)
+                break;
+
+            const auto z = std::polar(1.0, -juce::MathConstants<double>::twoPi * hz / sampleRate);  // z^-1
+            std::complex<double> sum;
+
+            for (int lane = 0; lane < maxBands; ++lane)
+            {
+                std::complex<double> response(1.0);
+
+                for (const auto& c : lrCoefficients)
+                    response *= (double(c.b0[lane]) + double(c.b1[lane]) * z + double(c.b2[lane]) * z * z)
+                              / (1.0 + double(c.a1[lane]) * z + double(c.a2[lane]) * z * z);
+
+                sum += response;
+            }
+
+            worst = juce::jmax(worst, std::abs(static_cast<float>(20.0 * std::log10(std::abs(sum)))));
+        }
+
+        return worst;
+    }
+
+private:
+    static constexpr int numSections = maxBands - 1;  // One per split
+    static constexpr int numBiquads = 2 * numSections;
+    static constexpr int numPartitions = 16;
+
+    //==========================================================================
+    // Linkwitz-Riley
+
+    // One biquad for all bands: lane b is band b
+    struct LaneCoefficients
+    {
+        float b0[maxBands] {}, b1[maxBands] {}, b2[maxBands] {}, a1[maxBands] {}, a2[maxBands] {};
+    };
+
+    struct LaneState
+    {
+        float s1[maxBands] {}, s2[maxBands] {};
+    };
+
+    enum class Section { lowPass, highPass, allPass, identity };
+
+    // RBJ biquads at Butterworth Q, normalised: {b0, b1, b2, a1, a2}
+    std::array<float, 5> makeBiquad(Section section, float hz) const noexcept
+    {
+        if (section == Section::identity)
+            return { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+        const double w = juce::MathConstants<double>::twoPi * hz / sampleRate;
+        const double cosW = std::cos(w);
+        const double alpha = std::sin(w) / (2.0 * 0.7071067811865476);
+        const double a0 = 1.0 + alpha;
+
+        std::array<double, 3> b {};
+
+        if (section == Section::lowPass)
+            b = { (1.0 - cosW) / 2.0, 1.0 - cosW, (1.0 - cosW) / 2.0 };
+        else if (section == Section::highPass)
+            b = { (1.0 + cosW) / 2.0, -(1.0 + cosW), (1.0 + cosW) / 2.0 };
+        else
+            b = { 1.0 - alpha, -2.0 * cosW, 1.0 + alpha };
+
+        return { static_cast<float>(b[0] / a0), static_cast<float>(b[1] / a0), static_cast<float>(b[2] / a0),
+                 static_cast<float>(-2.0 * cosW / a0), static_cast<float>((1.0 - alpha) / a0) };
+    }
+
+    // Band b, split j: high-pass below the band (j < b), low-pass at its top (j == b),
+    // and the split's allpass above it (j > b), which keeps the bands in phase
+    void updateLinkwitzRiley() noexcept
+    {
+        for (int lane = 0; lane < maxBands; ++lane)
+        {
+            for (int split = 0; split < numSections; ++split)
+            {
+                Section section = Section::identity;
+
+                if (split < numBands - 1)
+                    section = split < lane ? Section::highPass : split == lane ? Section::lowPass : Section::allPass;
+
+                // LR4 is the Butterworth section twice; the allpass is second order
+                const auto first = makeBiquad(section, crossoverHz[static_cast<size_t>(split)]);
+                const auto second = makeBiquad(section == Section::allPass ? Section::identity : section,
+                                               crossoverHz[static_cast<size_t>(split)]);
+
+                for (int half = 0; half < 2; ++half)
+                {
+                    const auto& c = half == 0 ? first : second;
+                    auto& lanes = lrCoefficients[static_cast<size_t>(2 * split + half)];
+                    const bool active = lane < numBands;
+
+                    lanes.b0[lane] = active ? c[0] : 0.0f;
+                    lanes.b1[lane] = active ? c[1] : 0.0f;
+                    lanes.b2[lane] = active ? c[2] : 0.0f;
+                    lanes.a1[lane] = active ? c[3] : 0.0f;
+                    lanes.a2[lane] = active ? c[4] : 0.0f;
+                }
+            }
+        }
+
+        jassert(type != Crossover::linkwitzRiley || getReconstructionErrorDb() < 0.01f);
+    }
+
+    // The lane loops have a fixed trip count of 4: one vector instruction each
+    void processLinkwitzRiley(float* const* data, float* const* reference, int numChannels, int numSamples) noexcept
+    {
+        float lower[maxBands], upper[maxBands];
+
+        for (int lane = 0; lane < maxBands; ++lane)
+        {
+            upper[lane] = thresholds[static_cast<size_t>(lane)];
+            lower[lane] = -upper[lane];
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto state = lrState[static_cast<size_t>(channel)];
+            float* x = data[channel];
+            float* ref = reference[channel];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float v[maxBands];
+
+                for (int lane = 0; lane < maxBands; ++lane)
+                    v[lane] = x[i];
+
+                for (int biquad = 0; biquad < numBiquads; ++biquad)
+                {
+                    const auto& c = lrCoefficients[static_cast<size_t>(biquad)];
+                    auto& s = state[static_cast<size_t>(biquad)];
+
+                    for (int lane = 0; lane < maxBands; ++lane)
+                    {
+                        const float y = c.b0[lane] * v[lane] + s.s1[lane];
+                        s.s1[lane] = c.b1[lane] * v[lane] - c.a1[lane] * y + s.s2[lane];
+                        s.s2[lane] = c.b2[lane] * v[lane] - c.a2[lane] * y;
+                        v[lane] = y;
+                    }
+                }
+
+                float clipped[maxBands];
+
+                for (int lane = 0; lane < maxBands; ++lane)
+                {
+                    const float low = v[lane] < lower[lane] ? lower[lane] : v[lane];
+                    clipped[lane] = low > upper[lane] ? upper[lane] : low;
+                }
+
+                // Unused lanes have zero coefficients and add nothing
+                ref[i] = (v[0] + v[1]) + (v[2] + v[3]);
+                x[i] = (clipped[0] + clipped[1]) + (clipped[2] + clipped[3]);
+            }
+
+            lrState[static_cast<size_t>(channel)] = state;
+        }
+    }
+
+    //==========================================================================
+    // Linear phase
+
+    struct FirChannel
+    {
+        std::vector<float> input;      // Overlap-save window: previous partition, then the one filling
+        std::vector<float> dry;        // Input history for the centre-tap delay, then the partition
+        std::vector<float> output;     // Clipped sum of the last partition, played out while the next fills
+        std::vector<float> reference;  // Unclipped sum, likewise
+        std::vector<float> spectra;    // Frequency-domain delay line, numPartitions spectra
+    };
+
+    float* spectrum(std::vector<float>& buffer, int index) noexcept
+    {
+        return buffer.data() + static_cast<size_t>(index * 2 * spectrumSize);
+    }
+
+    float* lowPassSpectrum(int set, int lowPass, int partition) noexcept
+    {
+        return spectrum(lowPassSpectra[static_cast<size_t>(set)], lowPass * numPartitions + partition);
+    }
+
+    void processLinearPhase(float* const* data, float* const* reference, int numChannels, int numSamples) noexcept
+    {
+        for (int offset = 0; offset < numSamples;)
+        {
+            const int n = juce::jmin(numSamples - offset, partitionSize - fifoPosition);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto& state = firState[static_cast<size_t>(channel)];
+                float* x = data[channel] + offset;
+
+                std::copy(x, x + n, state.input.begin() + partitionSize + fifoPosition);
+                std::copy(x, x + n, state.dry.begin() + centreTap + fifoPosition);
+                std::copy(state.output.begin() + fifoPosition, state.output.begin() + fifoPosition + n, x);
+                std::copy(state.reference.begin() + fifoPosition, state.reference.begin() + fifoPosition + n,
+                          reference[channel] + offset);
+            }
+
+            offset += n;
+            fifoPosition += n;
+
+            if (fifoPosition == partitionSize)
+            {
+                fifoPosition = 0;
+                runPartition(numChannels);
+            }
+        }
+    }
+
+    void runPartition(int numChannels) noexcept
+    {
+        if (designing)
+            designNextPartition();
+
+        const int numLowPasses = activeNumBands - 1;
+        newestPartition = (newestPartition + numPartitions - 1) % numPartitions;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto& state = firState[static_cast<size_t>(channel)];
+
+            // Spectrum of the window into the delay line, then slide the window
+            std::copy(state.input.begin(), state.input.end(), fftBuffer.begin());
+            fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+            std::copy(fftBuffer.begin(), fftBuffer.begin() + 2 * spectrumSize, spectrum(state.spectra, newestPartition));
+            std::copy(state.input.begin() + partitionSize, state.input.end(), state.input.begin());
+
+            // Each low-pass: sum over partitions of delayed input spectrum x filter partition
+            for (int lowPass = 0; lowPass < numLowPasses; ++lowPass)
+            {
+                std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+
+                for (int partition = 0; partition < numPartitions; ++partition)
+                    multiplyAccumulate(spectrum(state.spectra, (newestPartition + partition) % numPartitions),
+                                       lowPassSpectrum(activeSet, lowPass, partition));
+
+                fft->performRealOnlyInverseTransform(accumulator.data());
+
+                const float scale = lowPassScale[static_cast<size_t>(activeSet)][static_cast<size_t>(lowPass)];
+                float* out = lowPassOutput.data() + lowPass * partitionSize;
+
+                for (int i = 0; i < partitionSize; ++i)
+                    out[i] = accumulator[static_cast<size_t>(partitionSize + i)] * scale;
+            }
+
+            // Bands telescope: low-pass 0, then differences, then the delayed input minus the top low-pass
+            const float* delayed = state.dry.data();
+
+            for (int i = 0; i < partitionSize; ++i)
+            {
+                float previous = 0.0f;
+                float sum = 0.0f;
+                float unclipped = 0.0f;
+
+                for (int band = 0; band < activeNumBands; ++band)
+                {
+                    const float current = band < numLowPasses ? lowPassOutput[static_cast<size_t>(band * partitionSize + i)] : delayed[i];
+                    const float value = current - previous;
+                    const float threshold = thresholds[static_cast<size_t>(band)];
+                    sum += juce::jlimit(-threshold, threshold, value);
+                    unclipped += value;
+                    previous = current;
+                }
+
+                state.output[static_cast<size_t>(i)] = sum;
+                state.reference[static_cast<size_t>(i)] = unclipped;
+            }
+
+            std::copy(state.dry.begin() + partitionSize, state.dry.end(), state.dry.begin());
+        }
+    }
+
+    // Interleaved complex: accumulator += x * h over the non-negative bins
+    void multiplyAccumulate(const float* x, const float* h) noexcept
+    {
+        float* acc = accumulator.data();
+
+        for (int bin = 0; bin < spectrumSize; ++bin)
+        {
+            const float xr = x[2 * bin], xi = x[2 * bin + 1];
+            const float hr = h[2 * bin], hi = h[2 * bin + 1];
+            acc[2 * bin] += xr * hr - xi * hi;
+            acc[2 * bin + 1] += xr * hi + xi * hr;
+        }
+    }
+
+    // The new design goes into the set not being played; the bands it was made for
+    // take effect with it. A design in progress runs to completion first.
+    void startDesign() noexcept
+    {
+        if (designing)
+        {
+            designQueued = true;
+            return;
+        }
+
+        designing = true;
+        designPartition = 0;
+        designNumBands = numBands;
+        designCrossoverHz = crossoverHz;
+        designSums.fill(0.0);
+    }
+
+    // One partition of every low-pass: windowed sinc taps, then their spectrum
+    void designNextPartition() noexcept
+    {
+        const int set = 1 - activeSet;
+
+        for (int lowPass = 0; lowPass < designNumBands - 1; ++lowPass)
+        {
+            const double cutoff = 2.0 * designCrossoverHz[static_cast<size_t>(lowPass)] / sampleRate;  // Of Nyquist
+            std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
+
+            for (int i = 0; i < partitionSize; ++i)
+            {
+                const int n = designPartition * partitionSize + i;
+
+                if (n >= firLength)
+                    break;
+
+                const double t = juce::MathConstants<double>::pi * (n - centreTap);
+                const double sinc = n == centreTap ? cutoff : std::sin(cutoff * t) / t;
+                const float tap = static_cast<float>(sinc) * window[static_cast<size_t>(n)];
+
+                fftBuffer[static_cast<size_t>(i)] = tap;
+                designSums[static_cast<size_t>(lowPass)] += tap;
+            }
+
+            fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+            std::copy(fftBuffer.begin(), fftBuffer.begin() + 2 * spectrumSize, lowPassSpectrum(set, lowPass, designPartition));
+        }
+
+        if (++designPartition < numPartitions)
+            return;
+
+        // Complete: unity gain at DC, then swap
+        for (int lowPass = 0; lowPass < maxBands - 1; ++lowPass)
+            lowPassScale[static_cast<size_t>(set)][static_cast<size_t>(lowPass)] =
+                designSums[static_cast<size_t>(lowPass)] != 0.0 ? static_cast<float>(1.0 / designSums[static_cast<size_t>(lowPass)]) : 0.0f;
+
+        activeSet = set;
+        activeNumBands = designNumBands;
+        designing = false;
+
+        checkLinearPhaseBands();
+
+        // Crossovers moved meanwhile: design their latest position
+        if (designQueued)
+        {
+            designQueued = false;
+            startDesign();
+        }
+    }
+
+    // The active set's bands at DC and Nyquist, from the partition spectra the
+    // convolution runs on: a low-pass responds with the sum of its partitions' bin 0
+    // (or bin partitionSize, the partitions being an even length apart), scaled
+    void checkLinearPhaseBands() noexcept
+    {
+        const int numLowPasses = activeNumBands - 1;
+        float worstError = 0.0f;
+
+        for (const int bin : { 0, partitionSize })
+        {
+            float previous = 0.0f;
+
+            for (int band = 0; band < activeNumBands; ++band)
+            {
+                float current = 1.0f;  // The delayed input, above the top low-pass
+
+                if (band < numLowPasses)
+                {
+                    double response = 0.0;
+
+                    for (int partition = 0; partition < numPartitions; ++partition)
+                        response += lowPassSpectrum(activeSet, band, partition)[2 * bin];
+
+                    current = static_cast<float>(response) * lowPassScale[static_cast<size_t>(activeSet)][static_cast<size_t>(band)];
+                }
+
+                const bool passes = bin == 0 ? band == 0 : band == activeNumBands - 1;
+                worstError = juce::jmax(worstError, std::abs(current - previous - (passes ? 1.0f : 0.0f)));
+                previous = current;
+            }
+        }
+
+        lastReconstructionErrorDb = juce::Decibels::gainToDecibels(1.0f + worstError);
+        jassert(lastReconstructionErrorDb < 0.01f);
+    }
+
+    //==========================================================================
+    double sampleRate = 44100.0;
+    int channels = maxChannels;
+    Crossover type = Crossover::linkwitzRiley;
+    int numBands = 1;
+    std::array<float, maxBands - 1> crossoverHz { 120.0f, 1000.0f, 6000.0f };
+    std::array<float, maxBands> thresholds { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    std::array<LaneCoefficients, numBiquads> lrCoefficients;
+    std::array<std::array<LaneState, numBiquads>, maxChannels> lrState {};
+
+    int firLength = 4095;
+    int partitionSize = 256;
+    int centreTap = 2047;
+    int spectrumSize = 257;  // Non-negative bins of a 2 * partitionSize FFT
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> fftBuffer;
+    std::vector<float> accumulator;
+    std::vector<float> window;
+    std::vector<float> lowPassOutput;
+    std::array<FirChannel, maxChannels> firState;
+    int fifoPosition = 0;
+    int newestPartition = 0;
+    float lastReconstructionErrorDb = 0.0f;
+
+    // Two sets of low-pass spectra: the one playing and the one being designed
+    std::array<std::vector<float>, 2> lowPassSpectra;
+    std::array<std::array<float, maxBands - 1>, 2> lowPassScale {};
+    int activeSet = 0;
+    int activeNumBands = 1;
+
+    bool designing = false;
+    bool designQueued = false;
+    int designPartition = 0;
+    int designNumBands = 1;
+    std::array<float, maxBands - 1> designCrossoverHz {};
+    std::array<double, maxBands - 1> designSums {};
+};
@@ -0,0 +1,269 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// AutoClip's hard clipper, optionally run at 2x/4x/8x so the harmonics the clip
+// creates above Nyquist are filtered out instead of folding back, and the peaks
+// between host-rate samples are clipped too.
+//
+// Oversampling only runs while the clipper is working. The caller gives, per sample,
+// the peak of the input about to arrive (it knows from the lookahead): the crossfade
+// to the oversampled path starts on the sample where that peak first goes over the
+// threshold, and 100ms after the last such sample the clipper falls back to a
+// host-rate clip of the input, delayed to match the oversampled path. Before taking
+// over again the filters are warmed up on the last inputs, and both hand-overs
+// crossfade over 2ms, so the switch is inaudible. The latency is that of the
+// selected mode (whole samples) whether oversampling runs or not.
+class OversampledClipper
+{
+public:
+    enum class Factor { off, x2, x4, x8 };
+    enum class Filter { lowLatency, linearPhase };  // Polyphase IIR / FIR equiripple halfbands
+
+    static constexpr int maxChannels = 2;
+
+    // Allocates (not on the audio thread)
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels)
+    {
+        channels = juce::jlimit(1, maxChannels, numChannels);
+        maxBlock = juce::jmax(1, maximumBlockSize);
+        maxLatency = 0;
+
+        for (size_t index = 0; index < oversamplers.size(); ++index)
+        {
+            const bool linearPhase = index >= 3;
+            auto& oversampler = oversamplers[index];
+
+            oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
+                static_cast<size_t>(channels), index % 3 + 1,
+                linearPhase ? juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple
+                            : juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+                linearPhase, true);  // FIR at max quality; whole-sample latency for both
+            oversampler->initProcessing(static_cast<size_t>(juce::jmax(maxBlock, warmUpSamples)));
+            maxLatency = juce::jmax(maxLatency, static_cast<int>(std::ceil(oversampler->getLatencyInSamples())));
+        }
+
+        history = maxLatency + warmUpSamples;
+
+        for (int channel = 0; channel < maxChannels; ++channel)
+        {
+            work[static_cast<size_t>(channel)].assign(static_cast<size_t>(history + maxBlock), 0.0f);
+            fallback[static_cast<size_t>(channel)].assign(static_cast<size_t>(maxBlock), 0.0f);
+        }
+
+        mixRamp.assign(static_cast<size_t>(maxBlock), 0.0f);
+
+        holdSamples = static_cast<int>(0.1 * sampleRate);
+        fadeStep = 1.0f / static_cast<float>(juce::jmax(1.0, 0.002 * sampleRate));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& oversampler : oversamplers)
+            if (oversampler != nullptr)
+                oversampler->reset();
+
+        for (auto& channel : work)
+            std::fill(channel.begin(), channel.end(), 0.0f);
+
+        lastNumSamples = 0;
+        running = false;
+        mix = 0.0f;
+        holdRemaining = 0;
+    }
+
+    // Resets when the mode changes (the latency changes with it)
+    void setMode(Factor newFactor, Filter newFilter) noexcept
+    {
+        if (newFactor != factor || newFilter != filter)
+        {
+            factor = newFactor;
+            filter = newFilter;
+            reset();
+        }
+    }
+
+    // Delay of the output in host-rate samples for the selected mode
+    int getLatencySamples() const noexcept
+    {
+        const auto* oversampler = getOversampler();
+        return oversampler != nullptr ? static_cast<int>(std::ceil(oversampler->getLatencyInSamples())) : 0;
+    }
+
+    // Largest latency of any mode (sizes the caller's delay buffers)
+    int getMaximumLatencySamples() const noexcept { return maxLatency; }
+
+    bool isOversampling() const noexcept { return running; }
+
+    // In place: clips to +-threshold. lookaheadPeak[i]: the largest input magnitude
+    // that reaches the clipper within the caller's lookahead of sample i (nullptr: none
+    // coming). numSamples <= the prepared block size.
+    void process(float* const* data, int numChannels, int numSamples, float threshold, const float* lookaheadPeak) noexcept
+    {
+        jassert(numSamples <= maxBlock);
+        numChannels = juce::jmin(numChannels, channels);
+        numSamples = juce::jmin(numSamples, maxBlock);
+
+        // Keep the newest inputs of the last call for the delay and the warm-up
+        for (int channel = 0; channel < lastNumChannels; ++channel)
+        {
+            float* channelWork = work[static_cast<size_t>(channel)].data();
+            std::copy(channelWork + lastNumSamples, channelWork + lastNumSamples + history, channelWork);
+        }
+
+        lastNumChannels = numChannels;
+        lastNumSamples = numSamples;
+
+        const int latency = getLatencySamples();
+
+        // Host-rate path: the input delayed to match, then clipped
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* channelWork = work[static_cast<size_t>(channel)].data();
+            std::copy(data[channel], data[channel] + numSamples, channelWork + history);
+            juce::FloatVectorOperations::clip(fallback[static_cast<size_t>(channel)].data(),
+                                              channelWork + history - latency, -threshold, threshold, numSamples);
+        }
+
+        // Per sample: hold 100ms after each sample whose lookahead goes over the
+        // threshold, and ramp the mix towards the oversampled path while holding
+        const bool canRun = factor != Factor::off;
+        float* ramp = mixRamp.data();
+        bool anyOversampled = false;
+        bool allOversampled = true;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (lookaheadPeak != nullptr && lookaheadPeak[i] > threshold)
+                holdRemaining = holdSamples;
+            else if (holdRemaining > 0)
+                --holdRemaining;
+
+            const bool shouldRun = canRun && holdRemaining > 0;
+            mix = juce::jlimit(0.0f, 1.0f, mix + (shouldRun ? fadeStep : -fadeStep));
+            ramp[i] = mix;
+            anyOversampled = anyOversampled || mix > 0.0f;
+            allOversampled = allOversampled && mix == 1.0f;
+        }
+
+        if (anyOversampled && !running)
+        {
+            warmUp(numChannels, threshold);
+            running = true;
+        }
+
+        if (running)
+            processOversampled(data, numChannels, numSamples, threshold);
+
+        // out = fallback + mix * (oversampled - fallback)
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float* host = fallback[static_cast<size_t>(channel)].data();
+            float* out = data[channel];
+
+            if (!running)
+            {
+                std::copy(host, host + numSamples, out);
+            }
+            else if (!allOversampled)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = host[i] + ramp[i] * (out[i] - host[i]);
+            }
+        }
+
+        // Faded out: stop (the filters are warmed up again before the next run)
+        if (running && mix == 0.0f)
+            running = false;
+    }
+
+private:
+    static constexpr int warmUpSamples = 256;  // Covers the longest filter memory (8x FIR)
+
+    juce::dsp::Oversampling<float>* getOversampler() const noexcept
+    {
+        if (factor == Factor::off)
+            return nullptr;
+
+        const auto index = static_cast<size_t>(static_cast<int>(factor) - 1 + (filter == Filter::linearPhase ? 3 : 0));
+        return oversamplers[index].get();
+    }
+
+    // Up, clip, down: input is the newest numSamples in the work buffers (already
+    // copied in, or the warm-up history), output goes to destination
+    void runOversampler(const float* const* input, float* const* destination, int numChannels, int numSamples, float threshold) noexcept
+    {
+        auto& oversampler = *getOversampler();
+
+        juce::dsp::AudioBlock<const float> inputBlock(input, static_cast<size_t>(numChannels), static_cast<size_t>(numSamples));
+        auto oversampledBlock = oversampler.processSamplesUp(inputBlock);
+
+        for (size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
+        {
+            float* samples = oversampledBlock.getChannelPointer(channel);
+            juce::FloatVectorOperations::clip(samples, samples, -threshold, threshold, static_cast<int>(oversampledBlock.getNumSamples()));
+        }
+
+        juce::dsp::AudioBlock<float> outputBlock(destination, static_cast<size_t>(numChannels), static_cast<size_t>(numSamples));
+        oversampler.processSamplesDown(outputBlock);
+    }
+
+    void processOversampled(float* const* data, int numChannels, int numSamples, float threshold) noexcept
+    {
+        const float* input[maxChannels] {};
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            input[channel] = work[static_cast<size_t>(channel)].data() + history;
+
+        runOversampler(input, data, numChannels, numSamples, threshold);
+    }
+
+    // Runs the filters from reset over the inputs just before this block, so their
+    // state is what it would be had they never stopped. The output is discarded.
+    void warmUp(int numChannels, float threshold) noexcept
+    {
+        auto* oversampler = getOversampler();
+
+        if (oversampler == nullptr)
+            return;
+
+        oversampler->reset();
+
+        const float* input[maxChannels] {};
+        float* output[maxChannels] {};
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            input[channel] = work[static_cast<size_t>(channel)].data() + history - warmUpSamples;
+            output[channel] = warmUpScratch[static_cast<size_t>(channel)].data();
+        }
+
+        runOversampler(input, output, numChannels, warmUpSamples, threshold);
+    }
+
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, 6> oversamplers;  // IIR 2x/4x/8x, FIR 2x/4x/8x
+    Factor factor = Factor::off;
+    Filter filter = Filter::lowLatency;
+
+    std::array<std::vector<float>, maxChannels> work;      // Input history, then the current block
+    std::array<std::vector<float>, maxChannels> fallback;  // Host-rate clip of the delayed input
+    std::vector<float> mixRamp;                            // Per-sample mix for the current block
+    std::array<std::array<float, warmUpSamples>, maxChannels> warmUpScratch {};
+
+    int channels = maxChannels;
+    int maxBlock = 1;
+    int maxLatency = 0;
+    int history = warmUpSamples;
+    int lastNumChannels = 0;
+    int lastNumSamples = 0;
+
+    bool running = false;
+    float mix = 0.0f;  // 0 = host-rate path, 1 = oversampled path
+    float fadeStep = 1.0f;
+    int holdSamples = 0;
+    int holdRemaining = 0;
+};
@@ -116,30 +116,15 @@ void AutoClipAudioProcessorEditor::timerCallback()
     if (!webView)
         return;
 
-    // Read parameters
-    auto* clipThresholdParam = processorRef.parameters.getRawParameterValue("clipThreshold");
-    float clipThresholdPercent = clipThresholdParam->load();
-    float clipThreshold = clipThresholdPercent * 0.01f;  // Convert 0-100% to 0.0-1.0
-
-    // Simple peak detection from last processed buffer
-    // Note: Real implementation would use atomic<float> in processor for thread-safe access
-    // For now, use smoothed approximation based on parameters
-
-    // Estimate input peak (assume normalized signal)
-    float estimatedInputPeak = 0.7f;  // Placeholder - would read from processor
-
-    // Estimate output peak (if clipping, output clamped to threshold)
-    float estimatedOutputPeak = (clipThreshold > 0.01f && clipThreshold < 1.0f)
-                                ? clipThreshold
-                                : estimatedInputPeak;
+    // Peaks since the last tick, from the audio thread
+    const float inputPeak = processorRef.takeInputPeak();
+    const float outputTruePeak = processorRef.takeOutputTruePeak();
+    const bool isClipping = processorRef.takeClipping();
 
     // Smooth peaks for visual stability (exponential smoothing)
     const float smoothingFactor = 0.3f;
-    smoothedInputPeak += (estimatedInputPeak - smoothedInputPeak) * smoothingFactor;
-    smoothedOutputPeak += (estimatedOutputPeak - smoothedOutputPeak) * smoothingFactor;
-
-    // Detect clipping (occurs when threshold < 1.0 and signal would exceed it)
-    bool isClipping = (clipThreshold < 0.99f && estimatedInputPeak > clipThreshold);
+    smoothedInputPeak += (inputPeak - smoothedInputPeak) * smoothingFactor;
+    smoothedOutputPeak += (outputTruePeak - smoothedOutputPeak) * smoothingFactor;
 
     // Send meter data to JavaScript via custom event
     // JavaScript listens for 'meterUpdate' event
@@ -147,6 +132,9 @@ void AutoClipAudioProcessorEditor::timerCallback()
     meterData->setProperty("inputPeak", smoothedInputPeak);
     meterData->setProperty("outputPeak", smoothedOutputPeak);
     meterData->setProperty("isClipping", isClipping);
+    meterData->setProperty("truePeakDb", juce::Decibels::gainToDecibels(outputTruePeak, -100.0f));  // Unsmoothed
+    meterData->setProperty("inputLoudness", processorRef.getInputLoudness());  // LUFS, short-term
+    meterData->setProperty("outputLoudness", processorRef.getOutputLoudness());
 
     webView->emitEventIfBrowserIsVisible("meterUpdate", juce::var(meterData.release()));
 }
@@ -24,6 +24,64 @@ juce::AudioProcessorValueTreeState::ParameterLayout AutoClipAudioProcessor::crea
         false
     ));
 
+    // oversampling - Choice (clip at the host rate, or oversampled while clipping)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "oversampling", 1 },
+        "Oversampling",
+        juce::StringArray { "Off", "2x", "4x", "8x" },
+        0
+    ));
+
+    // oversamplingFilter - Choice (halfband filters of the oversampler)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "oversamplingFilter", 1 },
+        "Oversampling Filter",
+        juce::StringArray { "Low Latency (IIR)", "Linear Phase (FIR)" },
+        0
+    ));
+
+    // bands - Choice (1 = single-band clipping)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "bands", 1 },
+        "Bands",
+        juce::StringArray { "1", "2", "3", "4" },
+        0
+    ));
+
+    // crossoverMode - Choice (zero-latency IIR, or linear phase at ~50ms latency)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "crossoverMode", 1 },
+        "Crossover Mode",
+        juce::StringArray { "Linkwitz-Riley", "Linear Phase" },
+        0
+    ));
+
+    // crossover1-3 - Float (20-20000 Hz, skewed), splits between bands 1-2, 2-3, 3-4
+    const float crossoverDefaults[] { 120.0f, 1000.0f, 6000.0f };
+
+    for (int split = 0; split < 3; ++split)
+    {
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID { "crossover" + juce::String(split + 1), 1 },
+            "Crossover " + juce::String(split + 1),
+            juce::NormalisableRange<float>(20.0f, 20000.0f, 0.1f, 0.3f),
+            crossoverDefaults[split],
+            "Hz"
+        ));
+    }
+
+    // band1Threshold-band4Threshold - Float (-24 to +6 dB), offset from the clip threshold
+    for (int band = 0; band < 4; ++band)
+    {
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID { "band" + juce::String(band + 1) + "Threshold", 1 },
+            "Band " + juce::String(band + 1) + " Threshold",
+            juce::NormalisableRange<float>(-24.0f, 6.0f, 0.1f, 1.0f),
+            0.0f,
+            "dB"
+        ));
+    }
+
     return layout;
 }
 
@@ -35,11 +93,58 @@ AutoClipAudioProcessor::AutoClipAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "clipThreshold", &AutoClipParameters::clipThreshold },
+                                   { "soloClipped", &AutoClipParameters::soloClipped },
+                                   { "oversampling", &AutoClipParameters::oversampling },
+                                   { "oversamplingFilter", &AutoClipParameters::oversamplingFilter },
+                                   { "bands", &AutoClipParameters::bands },
+                                   { "crossoverMode", &AutoClipParameters::crossoverMode },
+                                   { "crossover1", &AutoClipParameters::crossover1 },
+                                   { "crossover2", &AutoClipParameters::crossover2 },
+                                   { "crossover3", &AutoClipParameters::crossover3 },
+                                   { "band1Threshold", &AutoClipParameters::band1Threshold },
+                                   { "band2Threshold", &AutoClipParameters::band2Threshold },
+                                   { "band3Threshold", &AutoClipParameters::band3Threshold },
+                                   { "band4Threshold", &AutoClipParameters::band4Threshold } })
 {
+    startTimerHz(10);  // Latency changes from the audio thread reach the host within 100ms
 }
 
 AutoClipAudioProcessor::~AutoClipAudioProcessor()
 {
+    stopTimer();
+}
+
+void AutoClipAudioProcessor::timerCallback()
+{
+    const int latency = pendingLatencySamples.load();
+
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void AutoClipAudioProcessor::updateMultiband(const AutoClipParameters& params, float threshold)
+{
+    const int numBands = params.bands + 1;
+    const bool linearPhase = params.crossoverMode;
+
+    multiband.setBands(numBands,
+                       { params.crossover1, params.crossover2, params.crossover3 },
+                       linearPhase ? MultibandClipper::Crossover::linearPhase : MultibandClipper::Crossover::linkwitzRiley);
+
+    multiband.setThresholds({ threshold * juce::Decibels::decibelsToGain(params.band1Threshold),
+                              threshold * juce::Decibels::decibelsToGain(params.band2Threshold),
+                              threshold * juce::Decibels::decibelsToGain(params.band3Threshold),
+                              threshold * juce::Decibels::decibelsToGain(params.band4Threshold) });
+}
+
+void AutoClipAudioProcessor::updateClipperMode(const AutoClipParameters& params)
+{
+    const int factor = params.oversampling;
+    const int filter = params.oversamplingFilter;
+
+    clipper.setMode(static_cast<OversampledClipper::Factor>(juce::jlimit(0, 3, factor)),
+                    filter == 1 ? OversampledClipper::Filter::linearPhase : OversampledClipper::Filter::lowLatency);
 }
 
 //==============================================================================
@@ -47,125 +152,234 @@ AutoClipAudioProcessor::~AutoClipAudioProcessor()
 //==============================================================================
 void AutoClipAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // Phase 4.1: Prepare lookahead delay lines (5ms fixed delay)
+    // Phase 4.1: Prepare lookahead delay line (5ms fixed delay)
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
     lookaheadSamples = static_cast<int>(0.005 * sampleRate);  // 5ms in samples
 
-    lookaheadDelayL.prepare(spec);
-    lookaheadDelayR.prepare(spec);
-    lookaheadDelayL.setMaximumDelayInSamples(lookaheadSamples);
-    lookaheadDelayR.setMaximumDelayInSamples(lookaheadSamples);
-    lookaheadDelayL.reset();
-    lookaheadDelayR.reset();
-
-    // Phase 4.2: Prepare gain smoothing (50ms time constant)
-    smoothedGain.reset(sampleRate, 0.05);  // 50ms smoothing
-    smoothedGain.setCurrentAndTargetValue(1.0f);  // Default gain = 1.0
-
-    // Phase 4.3: Preallocate original buffer for clip solo
-    originalBuffer.setSize(getTotalNumOutputChannels(), samplesPerBlock);
-    originalBuffer.clear();
+    lookaheadDelay.prepare(spec);
+    lookaheadDelay.setMaximumDelayInSamples(lookaheadSamples);
+    lookaheadDelay.setDelay(static_cast<float>(lookaheadSamples));
+    lookaheadDelay.reset();
+
+    // Phase 4.4: Oversampled clipper, built for every mode so switching never allocates
+    const auto params = parameterCache.load();
+    clipper.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    updateClipperMode(params);
+
+    // Phase 4.5: Multiband clipping, both crossovers ready
+    multiband.prepare(sampleRate, getTotalNumOutputChannels());
+    updateMultiband(params, thresholdFromPercent(params.clipThreshold));
+
+    referenceBuffer.setSize(getTotalNumOutputChannels(), samplesPerBlock);
+    referenceDelay.prepare(spec);
+    referenceDelay.setMaximumDelayInSamples(juce::jmax(1, clipper.getMaximumLatencySamples()));
+    referenceDelay.reset();
+
+    // Window long enough for the lookahead plus the slowest crossover
+    lookaheadPeak.prepare(lookaheadSamples + multiband.getMaximumLatencySamples() + 1);
+    lookaheadPeak.setWindowLength(getLookaheadWindow());
+    lookaheadPeaks.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
+
+    // The output is the input 5ms late, plus the crossover and clipper filters: tell
+    // the host so it can compensate
+    currentTotalLatency = lookaheadSamples + getMultibandLatency() + clipper.getLatencySamples();
+    pendingLatencySamples.store(currentTotalLatency);
+    setLatencySamples(currentTotalLatency);
+
+    // Phase 4.2: Loudness-matched makeup gain
+    inputLoudness.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    clippedLoudness.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    makeupGain.reset(sampleRate, 0.1);
+    makeupGain.setCurrentAndTargetValue(1.0f);
+    gainBuffer.assign(static_cast<size_t>(samplesPerBlock), 1.0f);
+
+    // Phase 5.3: Metering
+    outputTruePeak.prepare(getTotalNumOutputChannels(), samplesPerBlock);
 }
 
 void AutoClipAudioProcessor::releaseResources()
 {
-    // Release large buffers to save memory when plugin not in use
-    originalBuffer.setSize(0, 0);
+    multiband.reset();
+    lookaheadPeak.reset();
+    clipper.reset();
+    inputLoudness.reset();
+    clippedLoudness.reset();
+    outputTruePeak.reset();
 }
 
 void AutoClipAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("AutoClip", "processBlock");
     juce::ignoreUnused(midiMessages);
 
-    // Read parameters (atomic, real-time safe)
-    auto* clipThresholdParam = parameters.getRawParameterValue("clipThreshold");
-    float clipThresholdPercent = clipThresholdParam->load();
-    float clipThreshold = clipThresholdPercent * 0.01f;  // Convert 0-100% to 0.0-1.0
+    // Read parameters (one atomic snapshot, real-time safe)
+    const auto params = parameterCache.load();
+    float clipThreshold = thresholdFromPercent(params.clipThreshold);
+    bool soloClipped = params.soloClipped;
+
+    // A new oversampling mode or crossover changes the latency: setLatencySamples
+    // notifies the host, so the message thread picks it up from the timer
+    updateClipperMode(params);
+    updateMultiband(params, clipThreshold);
+    const int totalLatency = lookaheadSamples + getMultibandLatency() + clipper.getLatencySamples();
 
-    auto* soloClippedParam = parameters.getRawParameterValue("soloClipped");
-    bool soloClipped = soloClippedParam->load() > 0.5f;
+    if (totalLatency != currentTotalLatency)
+    {
+        currentTotalLatency = totalLatency;
+        pendingLatencySamples.store(totalLatency);
+    }
+
+    // The crossover delays what reaches the clipper: the window covers that too
+    if (getLookaheadWindow() != lookaheadPeak.getWindowLength())
+        lookaheadPeak.setWindowLength(getLookaheadWindow());
 
+    // Work in chunks of at most the prepared block size (the scratch buffers' size)
     const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
+    const int maxChunk = juce::jmax(1, static_cast<int>(gainBuffer.size()));
+
+    for (int offset = 0; offset < numSamples; offset += maxChunk)
+        processChunk(buffer, offset, juce::jmin(maxChunk, numSamples - offset), clipThreshold, soloClipped);
+
+    // Phase 5.3: Output meter, as true peak (the clipper's oversampled path keeps
+    // it at the threshold; the host-rate path can overshoot between samples)
+    const float truePeak = outputTruePeak.process(buffer.getArrayOfReadPointers(), buffer.getNumChannels(), numSamples);
+
+    if (truePeak > outputTruePeakLevel.load(std::memory_order_relaxed))
+        outputTruePeakLevel.store(truePeak, std::memory_order_relaxed);
+}
+
+void AutoClipAudioProcessor::processChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                                          float threshold, bool soloClipped)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), OversampledClipper::maxChannels);
+
+    // Phase 4.1: The undelayed input tells the clipper what is coming
+    const float inputPeak = scanLookahead(buffer, startSample, numSamples);
+
+    if (inputPeak > inputPeakLevel.load(std::memory_order_relaxed))
+        inputPeakLevel.store(inputPeak, std::memory_order_relaxed);
+
+    if (inputPeak > threshold)
+        clippingFlag.store(true, std::memory_order_relaxed);
+
+    // Phase 4.1: Delay the audio by the lookahead
+    auto block = juce::dsp::AudioBlock<float>(buffer).getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                                                     .getSubBlock(static_cast<size_t>(startSample), static_cast<size_t>(numSamples));
+    lookaheadDelay.process(juce::dsp::ProcessContextReplacing<float>(block));
+
+    float* channels[OversampledClipper::maxChannels] {};
+    float* reference[OversampledClipper::maxChannels] {};
 
-    // Phase 4.3: Store original signal before processing
-    originalBuffer.setSize(numChannels, numSamples, false, false, true);
     for (int channel = 0; channel < numChannels; ++channel)
     {
-        originalBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+        channels[channel] = buffer.getWritePointer(channel, startSample);
+        reference[channel] = referenceBuffer.getWritePointer(channel);
     }
 
-    // Phase 4.1 & 4.2: Process each channel
-    for (int channel = 0; channel < numChannels; ++channel)
+    // Phase 4.5: Per-band clipping; the unclipped band sum becomes the reference
+    if (multiband.getNumBands() > 1)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        auto& delayLine = (channel == 0) ? lookaheadDelayL : lookaheadDelayR;
+        PFS_TRACE_SCOPE("AutoClip", "multiband");
+        multiband.process(channels, reference, numChannels, numSamples);
+    }
+    else
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::copy(reference[channel], channels[channel], numSamples);
+    }
 
-        // Reset peak detectors for this block
-        inputPeak = 0.0f;
-        outputPeak = 0.0f;
+    // Phase 4.4: Hard clipping at the threshold (oversampled while it is being hit)
+    {
+        PFS_TRACE_SCOPE("AutoClip", "clipper");
+        clipper.process(channels, numChannels, numSamples, threshold, lookaheadPeaks.data());
+    }
 
-        // Process sample by sample
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Phase 4.1: Push input to lookahead buffer
-            delayLine.pushSample(channel, channelData[sample]);
+    // The clipper's output is late by its latency: so is the reference it is compared with
+    auto referenceBlock = juce::dsp::AudioBlock<float>(referenceBuffer).getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                                                                       .getSubBlock(0, static_cast<size_t>(numSamples));
+    referenceDelay.setDelay(static_cast<float>(clipper.getLatencySamples()));
+    referenceDelay.process(juce::dsp::ProcessContextReplacing<float>(referenceBlock));
 
-            // Phase 4.2: Analyze input peak from lookahead buffer (before clipping)
-            // Get delayed sample from lookahead
-            float delayedSample = delayLine.popSample(channel, lookaheadSamples);
-            inputPeak = juce::jmax(inputPeak, std::abs(delayedSample));
+    // Phase 4.2: Loudness of what went in and what came out, same samples
+    const bool inputStepped = inputLoudness.process(reference, numChannels, numSamples);
+    const bool clippedStepped = clippedLoudness.process(channels, numChannels, numSamples);
 
-            // Phase 4.1: Apply hard clipping
-            float clippedSample = juce::jlimit(-clipThreshold, clipThreshold, delayedSample);
+    if (inputStepped || clippedStepped)
+        updateMakeupGain();
 
-            // Phase 4.2: Analyze output peak from clipped signal
-            outputPeak = juce::jmax(outputPeak, std::abs(clippedSample));
+    const bool applyGain = makeupGain.isSmoothing() || makeupGain.getTargetValue() != 1.0f;
 
-            // Store clipped sample (will apply gain in second pass)
-            channelData[sample] = clippedSample;
-        }
-    }
+    if (applyGain && !soloClipped)
+        for (int sample = 0; sample < numSamples; ++sample)
+            gainBuffer[static_cast<size_t>(sample)] = makeupGain.getNextValue();
+    else
+        makeupGain.skip(numSamples);
 
-    // Phase 4.2: Calculate gain compensation (after analyzing all channels)
-    float targetGain = 1.0f;
-    if (outputPeak > 0.001f && inputPeak > 0.001f)
+    for (int channel = 0; channel < numChannels; ++channel)
     {
-        targetGain = inputPeak / outputPeak;  // Restore to input peak level
+        if (soloClipped)
+        {
+            // Phase 4.3: Difference signal = original - clipped: only what the clipper removed
+            juce::FloatVectorOperations::subtract(channels[channel], reference[channel], channels[channel], numSamples);
+        }
+        else if (applyGain)
+        {
+            // Phase 4.2: Sample-accurate gain compensation (skipped while it rests at unity)
+            juce::FloatVectorOperations::multiply(channels[channel], gainBuffer.data(), numSamples);
+        }
     }
-    smoothedGain.setTargetValue(targetGain);
+}
 
-    // Apply smoothed gain to all channels
-    for (int channel = 0; channel < numChannels; ++channel)
+float AutoClipAudioProcessor::scanLookahead(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    float* peaks = lookaheadPeaks.data();
+
+    // Stereo-linked magnitude of each new input sample
+    juce::FloatVectorOperations::abs(peaks, buffer.getReadPointer(0, startSample), numSamples);
+
+    for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
+        const float* input = buffer.getReadPointer(channel, startSample);
 
         for (int sample = 0; sample < numSamples; ++sample)
-        {
-            float currentGain = smoothedGain.getNextValue();
-            channelData[sample] *= currentGain;
-        }
+            peaks[sample] = juce::jmax(peaks[sample], std::abs(input[sample]));
     }
 
-    // Phase 4.3: Clip solo routing (output difference signal if enabled)
-    if (soloClipped)
+    const float inputPeak = juce::FloatVectorOperations::findMaximum(peaks, numSamples);
+
+    // Then the peak of the window ending at each of them (O(1) per sample)
+    for (int sample = 0; sample < numSamples; ++sample)
+        peaks[sample] = lookaheadPeak.push(peaks[sample]);
+
+    return inputPeak;
+}
+
+void AutoClipAudioProcessor::updateMakeupGain() noexcept
+{
+    const double inputPower = inputLoudness.getMeanSquare();
+    const double clippedPower = clippedLoudness.getMeanSquare();
+
+    const float inputLufs = ShortTermLoudness::loudnessFromMeanSquare(inputPower);
+    inputLoudnessLevel.store(inputLufs, std::memory_order_relaxed);
+
+    // Below the BS.1770 absolute gate (-70 LUFS) there is nothing to match: hold the gain
+    if (inputLufs > -70.0f && clippedPower > 0.0)
     {
-        for (int channel = 0; channel < numChannels; ++channel)
-        {
-            auto* outputData = buffer.getWritePointer(channel);
-            auto* originalData = originalBuffer.getReadPointer(channel);
-
-            for (int sample = 0; sample < numSamples; ++sample)
-            {
-                // Difference signal = original - clipped_with_gain
-                outputData[sample] = originalData[sample] - outputData[sample];
-            }
-        }
+        float target = juce::jlimit(0.0625f, 16.0f, static_cast<float>(std::sqrt(inputPower / clippedPower)));  // +-24dB
+
+        // Unclipped, both measure the same samples: settle at exactly unity
+        if (std::abs(target - 1.0f) < 1.0e-4f)
+            target = 1.0f;
+
+        makeupGain.setTargetValue(target);
     }
+
+    outputLoudnessLevel.store(ShortTermLoudness::loudnessFromMeanSquare(clippedPower * makeupGain.getTargetValue() * makeupGain.getTargetValue()),
+                              std::memory_order_relaxed);
 }
 
 //==============================================================================
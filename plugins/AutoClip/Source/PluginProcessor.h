@@ -1,8 +1,31 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/ShortTermLoudness.h"
+#include "dsp/SlidingMax.h"
+#include "dsp/TruePeakMeter.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
+#include "MultibandClipper.h"
+#include "OversampledClipper.h"
+#include <atomic>
 
-class AutoClipAudioProcessor : public juce::AudioProcessor
+// Parameter values for one block (thresholds in % and dB, crossovers in Hz; choices
+// are indices)
+struct AutoClipParameters
+{
+    float clipThreshold;
+    bool soloClipped;
+    int oversampling;
+    int oversamplingFilter;
+    int bands;
+    bool crossoverMode;
+    float crossover1, crossover2, crossover3;
+    float band1Threshold, band2Threshold, band3Threshold, band4Threshold;
+};
+
+class AutoClipAudioProcessor : public juce::AudioProcessor,
+                               private juce::Timer
 {
 public:
     AutoClipAudioProcessor();
@@ -33,23 +56,85 @@ public:
     // Public APVTS for editor binding
     juce::AudioProcessorValueTreeState parameters;
 
+    // clipThreshold (0-100%) to clip level: 0% = 1.0 (no clipping), 100% = 0.01 (-40 dB)
+    static float thresholdFromPercent(float percent) noexcept
+    {
+        return juce::jmax(0.01f, 1.0f - percent * 0.01f);
+    }
+
+    // Meter readings since the previous call (message thread): linear peaks, the
+    // output one measured as true peak (BS.1770)
+    float takeInputPeak() noexcept { return inputPeakLevel.exchange(0.0f); }
+    float takeOutputTruePeak() noexcept { return outputTruePeakLevel.exchange(0.0f); }
+    bool takeClipping() noexcept { return clippingFlag.exchange(false); }
+
+    // Short-term loudness (LUFS, 400ms) of the input and of the output (the clipped
+    // signal with its makeup gain; clip solo aside)
+    float getInputLoudness() const noexcept { return inputLoudnessLevel.load(); }
+    float getOutputLoudness() const noexcept { return outputLoudnessLevel.load(); }
+
 private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<AutoClipParameters> parameterCache;
+
     // DSP Components (Phase 4.1: Core Processing)
     juce::dsp::ProcessSpec spec;
-    juce::dsp::DelayLine<float> lookaheadDelayL { 48000 };  // Max 1 second at 48kHz
-    juce::dsp::DelayLine<float> lookaheadDelayR { 48000 };
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> lookaheadDelay;  // 5ms, all channels
     int lookaheadSamples = 0;
 
     // Phase 4.2: Automatic Gain Matching
-    juce::SmoothedValue<float> smoothedGain;
-    float inputPeak = 0.0f;
-    float outputPeak = 0.0f;
+    // Loudness-matched: the makeup gain is the ratio of the K-weighted short-term
+    // loudness (400ms) of the reference (below) to that of the clipped signal, so
+    // bypass and clipped A/B at the same loudness.
+    // It glides over 100ms between the 10ms loudness steps.
+    ShortTermLoudness inputLoudness;
+    ShortTermLoudness clippedLoudness;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> makeupGain { 1.0f };
+    std::vector<float> gainBuffer;  // Per-sample makeup gain for the current chunk
+
+    // Lookahead: running peak (stereo-linked) of the undelayed input over everything
+    // between it and the clipper, so the clipper knows sample by sample what is coming
+    SlidingMax lookaheadPeak;
+    std::vector<float> lookaheadPeaks;  // Per sample of the current chunk
+    int getLookaheadWindow() const noexcept { return lookaheadSamples + getMultibandLatency() + 1; }
+
+    void processChunk(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, float threshold, bool soloClipped);
+    float scanLookahead(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+    void updateMakeupGain() noexcept;
+
+    // Multiband clipping (2-4 bands, each clipped at its own offset from the threshold)
+    // ahead of the main clipper, which then holds the summed bands to the threshold
+    MultibandClipper multiband;
+    void updateMultiband(const AutoClipParameters& params, float threshold);
+    int getMultibandLatency() const noexcept { return multiband.getNumBands() > 1 ? multiband.getLatencySamples() : 0; }
+
+    // Oversampled clipping: runs while the threshold is being hit, crossfading with a
+    // host-rate clip otherwise. The lookahead peak starts the crossfade 5ms before the
+    // first peak reaches the clipper, so it has finished when the peak arrives.
+    OversampledClipper clipper;
+    void updateClipperMode(const AutoClipParameters& params);
+
+    // What the clipping is compared with (clip solo, loudness match): the input after
+    // the lookahead and the crossover's unclipped band sum, delayed by the clipper
+    juce::AudioBuffer<float> referenceBuffer;
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> referenceDelay;
+    void timerCallback() override;  // Reports latency changes to the host
+    int currentTotalLatency = 0;
+    std::atomic<int> pendingLatencySamples { 0 };  // Audio thread → message thread timer
+
+    // Metering (audio thread → editor)
+    TruePeakMeter outputTruePeak;
+    std::atomic<float> inputPeakLevel { 0.0f };
+    std::atomic<float> outputTruePeakLevel { 0.0f };
+    std::atomic<bool> clippingFlag { false };
+    std::atomic<float> inputLoudnessLevel { -100.0f };
+    std::atomic<float> outputLoudnessLevel { -100.0f };
 
-    // Phase 4.3: Clip Solo (Delta Monitoring)
-    juce::AudioBuffer<float> originalBuffer;
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("AutoClip");
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutoClipAudioProcessor)
 };
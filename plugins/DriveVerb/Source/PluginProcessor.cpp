@@ -58,6 +58,28 @@ juce::AudioProcessorValueTreeState::ParameterLayout DriveVerbAudioProcessor::cre
         1.0f
     ));
 
+    // ECO - Reverb with 8 delay lines instead of 16 (about half the reverb CPU)
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { "eco", 1 },
+        "Eco",
+        false
+    ));
+
+    // DRIVE MODE - Drive anti-aliasing: Fast (host rate), ADAA, 2x or 4x oversampled
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "driveMode", 1 },
+        "Drive Mode",
+        juce::StringArray { "Fast", "ADAA", "2x", "4x" },
+        2  // Default: 2x
+    ));
+
+    // LOW RATE - Run the reverb tank at 44.1/48kHz in 88.2kHz+ sessions (no effect below)
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { "lowRate", 1 },
+        "Low-Rate Reverb",
+        false
+    ));
+
     return layout;
 }
 
@@ -66,11 +88,50 @@ DriveVerbAudioProcessor::DriveVerbAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "size", &DriveVerbParameters::size },
+                                   { "decay", &DriveVerbParameters::decay },
+                                   { "dryWet", &DriveVerbParameters::dryWet },
+                                   { "drive", &DriveVerbParameters::drive },
+                                   { "filter", &DriveVerbParameters::filter },
+                                   { "filterPosition", &DriveVerbParameters::filterPosition },
+                                   { "eco", &DriveVerbParameters::eco },
+                                   { "driveMode", &DriveVerbParameters::driveMode },
+                                   { "lowRate", &DriveVerbParameters::lowRate } })
 {
+    startTimerHz(10);  // Latency changes from the audio thread reach the host within 100ms
 }
 
 DriveVerbAudioProcessor::~DriveVerbAudioProcessor()
 {
+    stopTimer();
+}
+
+void DriveVerbAudioProcessor::timerCallback()
+{
+    const int latency = pendingLatencySamples.load();
+
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void DriveVerbAudioProcessor::updateLatency(const DriveVerbParameters& params, double sampleRate) noexcept
+{
+    // LOW_RATE and the drive mode each reset their stage when they change
+    reverb.setRate(params.lowRate ? FdnReverb::reducedRateFor(sampleRate) : FdnReverb::Rate::full);
+    driveStage.setMode(static_cast<TanhDrive::Mode>(params.driveMode));
+
+    // Dry path waits for the reverb's resampling filters and the drive stage (fractional);
+    // the host gets the nearest whole sample
+    const float wetLatency = static_cast<float>(reverb.getLatencySamples()) + driveStage.getLatencySamples();
+    dryWetMixer.setWetLatency(wetLatency);
+
+    const int totalLatency = juce::roundToInt(wetLatency);
+
+    if (totalLatency != currentTotalLatency)
+    {
+        currentTotalLatency = totalLatency;
+        pendingLatencySamples.store(totalLatency);
+    }
 }
 
 void DriveVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
@@ -81,63 +142,100 @@ void DriveVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlo
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
-    // Prepare reverb
-    reverb.prepare(spec);
+    // Prepare reverb (allocates its delay lines)
+    reverb.prepare(sampleRate, samplesPerBlock);
 
     // Prepare dry/wet mixer
     dryWetMixer.prepare(spec);
     dryWetMixer.setMixingRule(juce::dsp::DryWetMixingRule::balanced); // Equal-power mixing
 
-    // Prepare drive waveshaper with tanh transfer function (Stage 4.2)
-    driveShaper.prepare(spec);
-    driveShaper.functionToUse = [](float sample) { return std::tanh(sample); };
+    // Prepare drive stage (Stage 4.2) at the current drive (no ramp on start)
+    const auto params = parameterCache.load();
+    driveStage.setMode(static_cast<TanhDrive::Mode>(params.driveMode));
+    driveStage.setDriveDecibels(params.drive);
+    driveStage.prepare(sampleRate, samplesPerBlock, static_cast<int>(spec.numChannels));
+
+    // Prepare DJ-style filter (Stage 4.3) at the current position (no sweep on start)
+    djFilter.setPosition(params.filter / 100.0f);
+    djFilter.prepare(sampleRate, static_cast<int>(spec.numChannels));
+
+    silenceDetector.prepare(sampleRate);
 
-    // Prepare DJ-style filter (Stage 4.3)
-    filterProcessor.prepare(spec);
+    updateLatency(params, sampleRate);
+    pendingLatencySamples.store(currentTotalLatency);
+    setLatencySamples(currentTotalLatency);
 }
 
 void DriveVerbAudioProcessor::releaseResources()
 {
     reverb.reset();
     dryWetMixer.reset();
-    driveShaper.reset();
-    filterProcessor.reset();
+    driveStage.reset();
+    djFilter.reset();
+}
+
+double DriveVerbAudioProcessor::computeTailSeconds() const
+{
+    // Drive boosts the tail by up to 24dB before the tanh, so it has further to fall
+    const auto params = parameterCache.load();
+    const float driveDb = params.drive;
+    const double reverbTail = SilenceDetector::reverbTailSeconds(params.decay, SilenceDetector::defaultThresholdDb - driveDb);
+
+    const double sampleRate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    return reverbTail + reverb.getLatencySamples() / sampleRate;
 }
 
 void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("DriveVerb", "processBlock");
     juce::ignoreUnused(midiMessages);
 
-    // Get current parameter values (atomic reads, real-time safe)
-    auto* sizeParam = parameters.getRawParameterValue("size");
-    auto* decayParam = parameters.getRawParameterValue("decay");
-    auto* dryWetParam = parameters.getRawParameterValue("dryWet");
-    auto* driveParam = parameters.getRawParameterValue("drive");
-    auto* filterParam = parameters.getRawParameterValue("filter");
-    auto* filterPositionParam = parameters.getRawParameterValue("filterPosition");
-
-    float sizeValue = sizeParam->load();      // 0-100%
-    float decayValue = decayParam->load();    // 0.5-10s
-    float dryWetValue = dryWetParam->load();  // 0-100%
-    float driveValue = driveParam->load();    // 0-24dB
-    float filterValue = filterParam->load();  // -100% to +100%
-    bool isPostMode = filterPositionParam->load() > 0.5f;  // false=PRE, true=POST
-
-    // Update reverb parameters
-    juce::dsp::Reverb::Parameters reverbParams;
-    reverbParams.roomSize = sizeValue / 100.0f;  // Normalize to 0-1
-    reverbParams.damping = 0.5f;                  // Fixed for now (could add parameter later)
-    reverbParams.wetLevel = 1.0f;                 // Full wet (dry/wet mixer handles blend)
-    reverbParams.dryLevel = 0.0f;                 // No dry in reverb (dry/wet mixer handles it)
-    reverbParams.width = 1.0f;                    // Full stereo width
-    reverbParams.freezeMode = 0.0f;               // No freeze
+    // Get current parameter values (one atomic snapshot, real-time safe)
+    const auto params = parameterCache.load();
+
+    // Latency follows LOW_RATE and the drive mode even while asleep: setLatencySamples
+    // notifies the host, so the message thread picks it up from the timer
+    updateLatency(params, getSampleRate());
+
+    // Skip the whole chain once the input has been silent for longer than the tail
+    silenceDetector.setTailSeconds(computeTailSeconds());
+    const auto activity = silenceDetector.update(buffer.getArrayOfReadPointers(),
+                                                 juce::jmin(getTotalNumInputChannels(), buffer.getNumChannels()),
+                                                 buffer.getNumSamples());
+
+    if (activity != SilenceDetector::State::processing)
+    {
+        // Start the next sound from an empty reverb and filter
+        if (activity == SilenceDetector::State::enteringSleep)
+        {
+            reverb.reset();
+            dryWetMixer.reset();
+            driveStage.reset();
+            djFilter.reset();
+        }
 
-    // Map decay time to reverb parameters (decay affects both room size and damping)
-    // Longer decay = larger room + less damping
-    reverbParams.roomSize = juce::jlimit(0.0f, 1.0f, reverbParams.roomSize + (decayValue / 20.0f));
-    reverbParams.damping = juce::jlimit(0.0f, 1.0f, 1.0f - (decayValue / 10.0f));
+        buffer.clear();
+        driveOutputLevelDB.store(-60.0f);
+        return;
+    }
+
+    float sizeValue = params.size;      // 0-100%
+    float decayValue = params.decay;    // 0.5-10s
+    float dryWetValue = params.dryWet;  // 0-100%
+    float driveValue = params.drive;    // 0-24dB
+    float filterValue = params.filter;  // -100% to +100%
+    bool isPostMode = params.filterPosition > 0.5f;  // false=PRE, true=POST
+
+    // Update reverb parameters: size sets the room dimensions, decay is the actual RT60
+    FdnReverb::Parameters reverbParams;
+    reverbParams.size = sizeValue / 100.0f;      // Normalize to 0-1
+    reverbParams.decaySeconds = decayValue;
+    reverbParams.damping = 0.5f;                  // HF decays ~1.8x faster than LF
+    reverbParams.modulationDepth = 0.0f;          // Static lines: cheapest path, drive supplies the grit
+    reverbParams.width = 1.0f;                    // Full stereo width
 
+    reverb.setQuality(params.eco ? FdnReverb::Quality::eco : FdnReverb::Quality::standard);
     reverb.setParameters(reverbParams);
 
     // Update dry/wet mix (normalize 0-100% to 0-1)
@@ -145,64 +243,48 @@ void DriveVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juc
 
     // Create audio block for DSP processing
     juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
 
     // Push dry signal into mixer
     dryWetMixer.pushDrySamples(block);
 
-    // Process reverb
-    reverb.process(context);
+    // Process reverb (100% wet, in place)
+    {
+        PFS_TRACE_SCOPE("DriveVerb", "reverb");
+        reverb.process(buffer.getWritePointer(0),
+                       buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr,
+                       buffer.getNumSamples());
+    }
 
     // Stage 4.4: PRE/POST routing - apply drive and filter in different orders
     // PRE mode (filterPosition=0.0): Filter → Drive
     // POST mode (filterPosition=1.0): Drive → Filter
 
+    PFS_TRACE_SCOPE("DriveVerb", "drive and filter");
+
     if (isPostMode)
     {
         // POST MODE: Drive → Filter (drive affects harmonics, then filter shapes them)
-        applyDrive(block, context, driveValue);
-        applyFilter(block, context, filterValue);
+        applyDrive(block, driveValue);
+        applyFilter(block, filterValue);
     }
     else
     {
         // PRE MODE: Filter → Drive (filter shapes frequency content, then drive adds harmonics)
-        applyFilter(block, context, filterValue);
-        applyDrive(block, context, driveValue);
+        applyFilter(block, filterValue);
+        applyDrive(block, driveValue);
     }
 
     // Mix dry and wet signals
     dryWetMixer.mixWetSamples(block);
 }
 
-void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float driveValue)
+void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, float driveValue)
 {
     // Apply drive to wet signal (Stage 4.2)
-    // Convert dB to linear gain: gain = 10^(dB/20)
-    float driveGain = std::pow(10.0f, driveValue / 20.0f);
-
-    // Apply gain before waveshaping (increases saturation with higher drive)
-    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
-    {
-        auto* channelData = block.getChannelPointer(channel);
-        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
-        {
-            channelData[sample] *= driveGain;
-        }
-    }
-
-    // Apply tanh waveshaping (tape-like saturation)
-    driveShaper.process(context);
-
-    // Measure output level for VU meter (after waveshaping)
-    float maxLevel = 0.0f;
-    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
-    {
-        const float* channelData = block.getChannelPointer(channel);
-        for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
-        {
-            maxLevel = std::max(maxLevel, std::abs(channelData[sample]));
-        }
-    }
+    // Gain (ramped towards the new drive over 20ms) into tanh, measuring the output
+    // level for the VU meter in the same pass
+    driveStage.setDriveDecibels(driveValue);
+    const float maxLevel = driveStage.process(block);
 
     // Convert to dB and store atomically
     float levelDB = maxLevel > 0.0f
@@ -211,59 +293,18 @@ void DriveVerbAudioProcessor::applyDrive(juce::dsp::AudioBlock<float>& block, ju
     driveOutputLevelDB.store(levelDB);
 }
 
-void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float filterValue)
+void DriveVerbAudioProcessor::applyFilter(juce::dsp::AudioBlock<float>& block, float filterValue)
 {
     // Apply DJ-style filter (Stage 4.3)
-    // Center bypass zone: ±0.5% = no filtering (prevents filter artifacts at bypass)
-    if (std::abs(filterValue) > 0.5f)
-    {
-        float sampleRate = static_cast<float>(getSampleRate());
-        bool isLowPass = (filterValue < 0.0f);
+    // -100% = low-pass at 200Hz, 0% = no filtering, +100% = high-pass at 10kHz
+    float* channels[2] {};
+    const int numChannels = juce::jmin(2, static_cast<int>(block.getNumChannels()));
 
-        // Reset filter state when switching between low-pass and high-pass
-        // Prevents burst caused by residual energy in delay buffers
-        if (isLowPass != previousWasLowPass)
-        {
-            filterProcessor.reset();
-        }
-        previousWasLowPass = isLowPass;
+    for (int channel = 0; channel < numChannels; ++channel)
+        channels[channel] = block.getChannelPointer(static_cast<size_t>(channel));
 
-        if (isLowPass)
-        {
-            // Low-pass filter (negative values)
-            // Exponential mapping: -100% = 200Hz (heavy bass), 0% = 20kHz (bypass)
-            float normalizedValue = std::abs(filterValue) / 100.0f; // 0.0 to 1.0
-            float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(20000.0f / 200.0f));
-
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                sampleRate, juce::jlimit(200.0f, 20000.0f, cutoffHz), 0.707f
-            );
-        }
-        else
-        {
-            // High-pass filter (positive values)
-            // Exponential mapping: 0% = 20Hz (bypass), +100% = 10kHz (heavy treble)
-            float normalizedValue = filterValue / 100.0f; // 0.0 to 1.0
-            float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(10000.0f / 20.0f));
-
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-                sampleRate, juce::jlimit(20.0f, 10000.0f, cutoffHz), 0.707f
-            );
-        }
-
-        // Process buffer through filter
-        filterProcessor.process(context);
-    }
-    else
-    {
-        // Reset filter state when entering bypass zone
-        // Prevents residual energy when re-entering filter range
-        if (previousWasLowPass)
-        {
-            filterProcessor.reset();
-            previousWasLowPass = false;
-        }
-    }
+    djFilter.setPosition(filterValue / 100.0f);
+    djFilter.process(channels, numChannels, static_cast<int>(block.getNumSamples()));
 }
 
 juce::AudioProcessorEditor* DriveVerbAudioProcessor::createEditor()
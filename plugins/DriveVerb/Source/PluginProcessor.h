@@ -1,8 +1,29 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/DjFilter.h"
+#include "dsp/FdnReverb.h"
+#include "dsp/SilenceDetector.h"
+#include "dsp/TanhDrive.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
+
+// Parameter values for one block (size, mix and filter in %, decay in s, drive in dB)
+struct DriveVerbParameters
+{
+    float size;
+    float decay;
+    float dryWet;
+    float drive;
+    float filter;
+    float filterPosition;
+    bool eco;
+    int driveMode;
+    bool lowRate;
+};
 
-class DriveVerbAudioProcessor : public juce::AudioProcessor
+class DriveVerbAudioProcessor : public juce::AudioProcessor,
+                                private juce::Timer
 {
 public:
     DriveVerbAudioProcessor();
@@ -19,7 +40,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return computeTailSeconds(); }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -41,23 +62,39 @@ private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<DriveVerbParameters> parameterCache;
+
     // DSP Components (Stage 4.1: Core reverb + dry/wet mixing)
-    juce::dsp::Reverb reverb;
-    juce::dsp::DryWetMixer<float> dryWetMixer;
+    FdnReverb reverb;
+    juce::dsp::DryWetMixer<float> dryWetMixer { 256 };  // Max latency: reduced-rate reverb filters (90 samples)
 
-    // Stage 4.2: Drive saturation
-    juce::dsp::WaveShaper<float> driveShaper;
+    // Stage 4.2: Drive saturation (gain ramp, tanh and meter peak in one pass)
+    TanhDrive driveStage;
 
-    // Stage 4.3: DJ-style filter (low-pass/high-pass with center bypass)
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> filterProcessor;
-    bool previousWasLowPass = false;  // Track filter type transitions
+    // Stage 4.3: DJ-style filter (low-pass/high-pass, dry at the centre)
+    DjFilter djFilter;
 
     // Stage 4.4: Helper methods for PRE/POST routing
-    void applyDrive(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float driveValue);
-    void applyFilter(juce::dsp::AudioBlock<float>& block, juce::dsp::ProcessContextReplacing<float>& context, float filterValue);
+    void applyDrive(juce::dsp::AudioBlock<float>& block, float driveValue);
+    void applyFilter(juce::dsp::AudioBlock<float>& block, float filterValue);
+
+    // Sleeps once the input has been silent for longer than the tail
+    SilenceDetector silenceDetector;
+    double computeTailSeconds() const;
+
+    // Latency = reduced-rate reverb filters + drive oversampling. The dry path is
+    // delayed by the same amount inside the plugin, and the host compensates for it.
+    void updateLatency(const DriveVerbParameters& params, double sampleRate) noexcept;
+    void timerCallback() override;  // Reports latency changes to the host
+    int currentTotalLatency = 0;
+    std::atomic<int> pendingLatencySamples { 0 };  // Audio thread → message thread timer
 
     // VU meter - drive output level
     std::atomic<float> driveOutputLevelDB { -60.0f };
 
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("DriveVerb");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DriveVerbAudioProcessor)
 };
@@ -217,11 +217,103 @@ Drum808AudioProcessor::Drum808AudioProcessor()
                         .withOutput("Closed Hat", juce::AudioChannelSet::stereo(), false)
                         .withOutput("Open Hat", juce::AudioChannelSet::stereo(), false))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "kick_level", &Drum808Parameters::kickLevel },
+                                   { "kick_tone", &Drum808Parameters::kickTone },
+                                   { "kick_decay", &Drum808Parameters::kickDecay },
+                                   { "kick_tuning", &Drum808Parameters::kickTuning },
+                                   { "lowtom_level", &Drum808Parameters::lowTomLevel },
+                                   { "lowtom_tone", &Drum808Parameters::lowTomTone },
+                                   { "lowtom_decay", &Drum808Parameters::lowTomDecay },
+                                   { "lowtom_tuning", &Drum808Parameters::lowTomTuning },
+                                   { "midtom_level", &Drum808Parameters::midTomLevel },
+                                   { "midtom_tone", &Drum808Parameters::midTomTone },
+                                   { "midtom_decay", &Drum808Parameters::midTomDecay },
+                                   { "midtom_tuning", &Drum808Parameters::midTomTuning },
+                                   { "clap_level", &Drum808Parameters::clapLevel },
+                                   { "clap_tone", &Drum808Parameters::clapTone },
+                                   { "clap_snap", &Drum808Parameters::clapSnap },
+                                   { "clap_tuning", &Drum808Parameters::clapTuning },
+                                   { "closedhat_level", &Drum808Parameters::closedHatLevel },
+                                   { "closedhat_tone", &Drum808Parameters::closedHatTone },
+                                   { "closedhat_decay", &Drum808Parameters::closedHatDecay },
+                                   { "closedhat_tuning", &Drum808Parameters::closedHatTuning },
+                                   { "openhat_level", &Drum808Parameters::openHatLevel },
+                                   { "openhat_tone", &Drum808Parameters::openHatTone },
+                                   { "openhat_decay", &Drum808Parameters::openHatDecay },
+                                   { "openhat_tuning", &Drum808Parameters::openHatTuning } })
 {
 }
 
 Drum808AudioProcessor::~Drum808AudioProcessor()
 {
+    renderCacheThread.stopThread(1000);
+
+    // The voices are destroyed after the caches: release their cached hits first
+    kick.stop();
+    lowTom.stop();
+    midTom.stop();
+}
+
+void Drum808AudioProcessor::setRenderCacheEnabled(bool shouldBeEnabled)
+{
+    kickCache.setEnabled(shouldBeEnabled);
+    lowTomCache.setEnabled(shouldBeEnabled);
+    midTomCache.setEnabled(shouldBeEnabled);
+}
+
+// Cached hits stop at -80 dB (9.2 time constants); the live voices run on to -160 dB
+static int getCachedHitLength(float decaySeconds, double sampleRate)
+{
+    return static_cast<int>(std::ceil(decaySeconds * std::log(1.0e4f) * sampleRate));
+}
+
+int Drum808AudioProcessor::renderKick(float* dest, int maxSamples)
+{
+    // Runs on the render cache thread with its own voice
+    const auto params = parameterCache.load();
+    const float kickTone = params.kickTone / 100.0f;
+    const float kickDecay = params.kickDecay / 1000.0f;
+    const float kickTuning = params.kickTuning;
+    const float kickBaseFreq = 60.0f * std::pow(2.0f, kickTuning / 12.0f);
+
+    const int length = getCachedHitLength(kickDecay, currentSampleRate);
+
+    if (length > maxSamples)
+        return -1;
+
+    kickRenderVoice.bodyOscillator.reset();
+    kickRenderVoice.trigger(1.0f);
+
+    for (int sample = 0; sample < length; ++sample)
+        dest[sample] = kickRenderVoice.renderSample(kickBaseFreq, kickTone, kickDecay, static_cast<float>(currentSampleRate));
+
+    kickRenderVoice.stop();
+    return length;
+}
+
+int Drum808AudioProcessor::renderTom(TomVoice& renderVoice, float tuning, float tonePercent, float decayMs,
+                                     float rootFreq, float* dest, int maxSamples)
+{
+    // Runs on the render cache thread with its own voice
+    const float tomTone = tonePercent / 100.0f;
+    const float tomDecay = decayMs / 1000.0f;
+    const float tomBaseFreq = rootFreq * std::pow(2.0f, tuning / 12.0f);
+    const float tomQ = 0.5f + (tomTone * 4.5f);
+
+    const int length = getCachedHitLength(tomDecay, currentSampleRate);
+
+    if (length > maxSamples)
+        return -1;
+
+    renderVoice.oscillator.reset();
+    renderVoice.filter.reset();
+    renderVoice.trigger(1.0f, tomBaseFreq);
+
+    for (int sample = 0; sample < length; ++sample)
+        dest[sample] = renderVoice.renderSample(tomBaseFreq, tomQ, tomDecay, static_cast<float>(currentSampleRate));
+
+    renderVoice.stop();
+    return length;
 }
 
 void Drum808AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
@@ -233,28 +325,60 @@ void Drum808AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
-    // Configure and prepare Low Tom
-    lowTom.oscillator.initialise([](float x) { return std::sin(x); }); // Sine wave
-    lowTom.oscillator.prepare(spec);
-    lowTom.filter.prepare(spec);
-    lowTom.filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-    lowTom.filter.setResonance(0.5f); // Initial Q (will be updated per-sample)
-    lowTom.oscillator.reset();
-    lowTom.filter.reset();
-
-    // Configure and prepare Mid Tom
-    midTom.oscillator.initialise([](float x) { return std::sin(x); }); // Sine wave
-    midTom.oscillator.prepare(spec);
-    midTom.filter.prepare(spec);
-    midTom.filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-    midTom.filter.setResonance(0.5f); // Initial Q (will be updated per-sample)
-    midTom.oscillator.reset();
-    midTom.filter.reset();
+    // Render cache clients must be detached while their voices/storage are rebuilt
+    renderCacheThread.removeTimeSliceClient(&kickCache);
+    renderCacheThread.removeTimeSliceClient(&lowTomCache);
+    renderCacheThread.removeTimeSliceClient(&midTomCache);
+
+    auto prepareTom = [this](TomVoice& tom)
+    {
+        tom.stop();
+        tom.oscillator.initialise([](float x) { return std::sin(x); }); // Sine wave
+        tom.oscillator.prepare(spec);
+        tom.filter.prepare(spec);
+        tom.filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+        tom.filter.setResonance(0.5f); // Initial Q (will be updated per-sample)
+        tom.oscillator.reset();
+        tom.filter.reset();
+    };
+
+    auto prepareKick = [this](KickVoice& kickVoice)
+    {
+        kickVoice.stop();
+        kickVoice.bodyOscillator.initialise([](float x) { return std::sin(x); }); // Sine wave for body tone
+        kickVoice.bodyOscillator.prepare(spec);
+        kickVoice.bodyOscillator.reset();
+    };
+
+    // Configure and prepare Low Tom + Mid Tom
+    prepareTom(lowTom);
+    prepareTom(midTom);
 
     // Configure and prepare Kick
-    kick.bodyOscillator.initialise([](float x) { return std::sin(x); }); // Sine wave for body tone
-    kick.bodyOscillator.prepare(spec);
-    kick.bodyOscillator.reset();
+    prepareKick(kick);
+
+    // Render cache voices and storage. Each cache holds the hit at the top of its
+    // decay range (1000ms: 9.2s), so no setting falls back to live synthesis.
+    prepareTom(lowTomRenderVoice);
+    prepareTom(midTomRenderVoice);
+    prepareKick(kickRenderVoice);
+
+    auto prepareCache = [this, sampleRate](OneShotRenderCache& cache, const char* decayParameterID)
+    {
+        const float maxDecaySeconds = parameters.getParameterRange(decayParameterID).end / 1000.0f;
+        cache.prepare(sampleRate, (getCachedHitLength(maxDecaySeconds, sampleRate) + 1) / sampleRate);
+    };
+
+    prepareCache(kickCache, "kick_decay");
+    prepareCache(lowTomCache, "lowtom_decay");
+    prepareCache(midTomCache, "midtom_decay");
+
+    renderCacheThread.addTimeSliceClient(&kickCache);
+    renderCacheThread.addTimeSliceClient(&lowTomCache);
+    renderCacheThread.addTimeSliceClient(&midTomCache);
+
+    if (!renderCacheThread.isThreadRunning())
+        renderCacheThread.startThread(juce::Thread::Priority::low);
 
     // Configure and prepare Closed Hi-Hat (6 square wave oscillators)
     for (int i = 0; i < 6; ++i)
@@ -302,83 +426,80 @@ void Drum808AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
 
 void Drum808AudioProcessor::releaseResources()
 {
-    // Cleanup will be added in Stage 3
+    renderCacheThread.removeTimeSliceClient(&kickCache);
+    renderCacheThread.removeTimeSliceClient(&lowTomCache);
+    renderCacheThread.removeTimeSliceClient(&midTomCache);
+
+    kick.stop();
+    lowTom.stop();
+    midTom.stop();
+
+    kickCache.releaseStorage();
+    lowTomCache.releaseStorage();
+    midTomCache.releaseStorage();
+}
+
+double Drum808AudioProcessor::getTailLengthSeconds() const
+{
+    // Longest voice after its note: the decays run to voiceStopLevel (-90 dB),
+    // the clap's fixed 1.934s decay to its -80 dB cutoff after the 30ms spikes
+    const auto params = parameterCache.load();
+    double longestDecay = 0.0;
+
+    for (const float decayMs : { params.kickDecay, params.lowTomDecay, params.midTomDecay, params.closedHatDecay, params.openHatDecay })
+        longestDecay = juce::jmax(longestDecay, decayMs / 1000.0);
+
+    return juce::jmax(SilenceDetector::exponentialTailSeconds(longestDecay),
+                      0.03 + SilenceDetector::exponentialTailSeconds(1.934, -80.0f));
 }
 
 void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("Drum808", "processBlock");
 
     // Clear all output buses
     buffer.clear();
 
     const int numSamples = buffer.getNumSamples();
 
-    // Read all voice parameters (atomic, real-time safe)
+    // Read all voice parameters (one atomic snapshot, no string lookups)
+    const auto params = parameterCache.load();
+
     // Kick
-    auto* kickLevelParam = parameters.getRawParameterValue("kick_level");
-    auto* kickToneParam = parameters.getRawParameterValue("kick_tone");
-    auto* kickDecayParam = parameters.getRawParameterValue("kick_decay");
-    auto* kickTuningParam = parameters.getRawParameterValue("kick_tuning");
-
-    float kickLevel = kickLevelParam->load() / 100.0f;
-    float kickTone = kickToneParam->load() / 100.0f;
-    float kickDecay = kickDecayParam->load() / 1000.0f; // ms → seconds
-    float kickTuning = kickTuningParam->load();
+    float kickLevel = params.kickLevel / 100.0f;
+    float kickTone = params.kickTone / 100.0f;
+    float kickDecay = params.kickDecay / 1000.0f; // ms → seconds
+    float kickTuning = params.kickTuning;
     const float kickBaseFreq = 60.0f * std::pow(2.0f, kickTuning / 12.0f);
 
     // Tom parameters
-    auto* lowTomLevelParam = parameters.getRawParameterValue("lowtom_level");
-    auto* lowTomToneParam = parameters.getRawParameterValue("lowtom_tone");
-    auto* lowTomDecayParam = parameters.getRawParameterValue("lowtom_decay");
-    auto* lowTomTuningParam = parameters.getRawParameterValue("lowtom_tuning");
-
-    auto* midTomLevelParam = parameters.getRawParameterValue("midtom_level");
-    auto* midTomToneParam = parameters.getRawParameterValue("midtom_tone");
-    auto* midTomDecayParam = parameters.getRawParameterValue("midtom_decay");
-    auto* midTomTuningParam = parameters.getRawParameterValue("midtom_tuning");
-
-    float lowTomLevel = lowTomLevelParam->load() / 100.0f;
-    float lowTomTone = lowTomToneParam->load() / 100.0f;
-    float lowTomDecay = lowTomDecayParam->load() / 1000.0f;
-    float lowTomTuning = lowTomTuningParam->load();
-
-    float midTomLevel = midTomLevelParam->load() / 100.0f;
-    float midTomTone = midTomToneParam->load() / 100.0f;
-    float midTomDecay = midTomDecayParam->load() / 1000.0f;
-    float midTomTuning = midTomTuningParam->load();
+    float lowTomLevel = params.lowTomLevel / 100.0f;
+    float lowTomTone = params.lowTomTone / 100.0f;
+    float lowTomDecay = params.lowTomDecay / 1000.0f;
+    float lowTomTuning = params.lowTomTuning;
 
-    // Clap parameters
-    auto* clapLevelParam = parameters.getRawParameterValue("clap_level");
-    auto* clapToneParam = parameters.getRawParameterValue("clap_tone");
-    auto* clapSnapParam = parameters.getRawParameterValue("clap_snap");
-    auto* clapTuningParam = parameters.getRawParameterValue("clap_tuning");
+    float midTomLevel = params.midTomLevel / 100.0f;
+    float midTomTone = params.midTomTone / 100.0f;
+    float midTomDecay = params.midTomDecay / 1000.0f;
+    float midTomTuning = params.midTomTuning;
 
-    float clapLevel = clapLevelParam->load() / 100.0f;
-    float clapTone = clapToneParam->load() / 100.0f;
-    float clapSnap = clapSnapParam->load() / 100.0f;
-    float clapTuning = clapTuningParam->load();
+    // Clap parameters
+    float clapLevel = params.clapLevel / 100.0f;
+    float clapTone = params.clapTone / 100.0f;
+    float clapSnap = params.clapSnap / 100.0f;
+    float clapTuning = params.clapTuning;
 
     // Hi-Hat parameters
-    auto* closedHatLevelParam = parameters.getRawParameterValue("closedhat_level");
-    auto* closedHatToneParam = parameters.getRawParameterValue("closedhat_tone");
-    auto* closedHatDecayParam = parameters.getRawParameterValue("closedhat_decay");
-    auto* closedHatTuningParam = parameters.getRawParameterValue("closedhat_tuning");
-
-    auto* openHatLevelParam = parameters.getRawParameterValue("openhat_level");
-    auto* openHatToneParam = parameters.getRawParameterValue("openhat_tone");
-    auto* openHatDecayParam = parameters.getRawParameterValue("openhat_decay");
-    auto* openHatTuningParam = parameters.getRawParameterValue("openhat_tuning");
-
-    float closedHatLevel = closedHatLevelParam->load() / 100.0f;
-    float closedHatTone = closedHatToneParam->load() / 100.0f;
-    float closedHatDecay = closedHatDecayParam->load() / 1000.0f;
-    float closedHatTuning = closedHatTuningParam->load();
-
-    float openHatLevel = openHatLevelParam->load() / 100.0f;
-    float openHatTone = openHatToneParam->load() / 100.0f;
-    float openHatDecay = openHatDecayParam->load() / 1000.0f;
-    float openHatTuning = openHatTuningParam->load();
+    float closedHatLevel = params.closedHatLevel / 100.0f;
+    float closedHatTone = params.closedHatTone / 100.0f;
+    float closedHatDecay = params.closedHatDecay / 1000.0f;
+    float closedHatTuning = params.closedHatTuning;
+
+    float openHatLevel = params.openHatLevel / 100.0f;
+    float openHatTone = params.openHatTone / 100.0f;
+    float openHatDecay = params.openHatDecay / 1000.0f;
+    float openHatTuning = params.openHatTuning;
 
     // Calculate tuned base frequencies
     const float lowTomBaseFreq = 150.0f * std::pow(2.0f, lowTomTuning / 12.0f);
@@ -394,6 +515,11 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     const float closedHatCenterFreq = 6000.0f + (closedHatTone * 6000.0f); // 6-12 kHz
     const float openHatCenterFreq = 6000.0f + (openHatTone * 6000.0f);
 
+    // Render cache: any change to a voice's sound invalidates its cached hit until the knobs settle
+    kickCache.setParameterHash(OneShotRenderCache::hashValues({ kickTone, kickDecay, kickTuning }), numSamples);
+    lowTomCache.setParameterHash(OneShotRenderCache::hashValues({ lowTomTone, lowTomDecay, lowTomTuning }), numSamples);
+    midTomCache.setParameterHash(OneShotRenderCache::hashValues({ midTomTone, midTomDecay, midTomTuning }), numSamples);
+
     // Process MIDI messages
     for (const auto metadata : midiMessages)
     {
@@ -408,6 +534,7 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
             if (note == 36) // C1 → Kick
             {
                 kick.trigger(velocity);
+                kick.cachedHit = kickCache.start(0);
                 kickTriggered.store(true, std::memory_order_relaxed);
             }
             else if (note == 38) // D1 → Clap
@@ -418,6 +545,7 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
             else if (note == 41) // F1 → Low Tom
             {
                 lowTom.trigger(velocity, lowTomBaseFreq);
+                lowTom.cachedHit = lowTomCache.start(0);
                 lowTomTriggered.store(true, std::memory_order_relaxed);
             }
             else if (note == 42) // F#1 → Closed Hat (CHOKES open hat)
@@ -432,6 +560,7 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
             else if (note == 45) // A1 → Mid Tom
             {
                 midTom.trigger(velocity, midTomBaseFreq);
+                midTom.cachedHit = midTomCache.start(0);
                 midTomTriggered.store(true, std::memory_order_relaxed);
             }
             else if (note == 46) // A#1 → Open Hat
@@ -442,11 +571,18 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         }
     }
 
+    // Nothing sounding: the output stays clear
+    if (!kick.isPlaying && !lowTom.isPlaying && !midTom.isPlaying && !clap.isPlaying
+        && !closedHat.isPlaying && !openHat.isPlaying)
+        return;
+
     // Configure clap filter (outside loop for efficiency)
     clap.bandpassFilter.setCutoffFrequency(clapCenterFreq);
     clap.bandpassFilter.setResonance(clapQ);
 
     // Synthesize voices (per-sample processing)
+    PFS_TRACE_SCOPE("Drum808", "voices");
+
     for (int sample = 0; sample < numSamples; ++sample)
     {
         float kickSample = 0.0f;
@@ -456,82 +592,72 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         float closedHatSample = 0.0f;
         float openHatSample = 0.0f;
 
-        // Kick synthesis (pitch envelope + attack transient)
+        // Kick synthesis (pitch envelope + attack transient), or its pre-rendered hit
         if (kick.isPlaying)
         {
-            // Pitch envelope: exponential sweep from 2× to 1× base frequency
-            float currentFreq = kickBaseFreq * (1.0f + std::exp(-kick.envelopeTime / 0.02f));
-            kick.bodyOscillator.setFrequency(currentFreq);
-
-            // Body tone (sine oscillator)
-            float bodySignal = kick.bodyOscillator.processSample(0.0f);
+            float kickHit;
 
-            // Attack transient (noise burst scaled by tone parameter)
-            float attackSignal = (kick.noiseGenerator.nextFloat() * 2.0f - 1.0f) *
-                                 std::exp(-kick.envelopeTime / 0.005f) * kickTone;
-
-            // Amplitude envelope (exponential decay)
-            float amplitudeEnv = std::exp(-kick.envelopeTime / kickDecay);
+            if (kick.cachedHit.isActive())
+            {
+                kickHit = kick.cachedHit.nextSample();
 
-            // Denormal protection
-            if (amplitudeEnv < 1e-8f)
+                if (!kick.cachedHit.isActive())
+                    kick.stop();
+            }
+            else
             {
-                kick.stop();
-                amplitudeEnv = 0.0f;
+                kickHit = kick.renderSample(kickBaseFreq, kickTone, kickDecay, static_cast<float>(currentSampleRate));
             }
 
             // Final output
-            kickSample = (bodySignal + attackSignal) * amplitudeEnv * kick.velocity * kickLevel;
-
-            // Advance envelope time
-            kick.envelopeTime += 1.0f / static_cast<float>(currentSampleRate);
+            kickSample = kickHit * kick.velocity * kickLevel;
         }
 
         // Low Tom synthesis
         if (lowTom.isPlaying)
         {
-            lowTom.filter.setCutoffFrequency(lowTomBaseFreq);
-            lowTom.filter.setResonance(lowTomQ);
+            float tomHit;
 
-            float oscSample = lowTom.oscillator.processSample(0.0f);
-            float filteredSample = lowTom.filter.processSample(0, oscSample);
-            float envelope = std::exp(-lowTom.envelopeTime / lowTomDecay);
+            if (lowTom.cachedHit.isActive())
+            {
+                tomHit = lowTom.cachedHit.nextSample();
 
-            if (envelope < 1e-8f)
+                if (!lowTom.cachedHit.isActive())
+                    lowTom.stop();
+            }
+            else
             {
-                lowTom.stop();
-                envelope = 0.0f;
+                tomHit = lowTom.renderSample(lowTomBaseFreq, lowTomQ, lowTomDecay, static_cast<float>(currentSampleRate));
             }
 
-            lowTomSample = filteredSample * envelope * lowTom.velocity * lowTomLevel;
-            lowTom.envelopeTime += 1.0f / static_cast<float>(currentSampleRate);
+            lowTomSample = tomHit * lowTom.velocity * lowTomLevel;
         }
 
         // Mid Tom synthesis
         if (midTom.isPlaying)
         {
-            midTom.filter.setCutoffFrequency(midTomBaseFreq);
-            midTom.filter.setResonance(midTomQ);
+            float tomHit;
 
-            float oscSample = midTom.oscillator.processSample(0.0f);
-            float filteredSample = midTom.filter.processSample(0, oscSample);
-            float envelope = std::exp(-midTom.envelopeTime / midTomDecay);
+            if (midTom.cachedHit.isActive())
+            {
+                tomHit = midTom.cachedHit.nextSample();
 
-            if (envelope < 1e-8f)
+                if (!midTom.cachedHit.isActive())
+                    midTom.stop();
+            }
+            else
             {
-                midTom.stop();
-                envelope = 0.0f;
+                tomHit = midTom.renderSample(midTomBaseFreq, midTomQ, midTomDecay, static_cast<float>(currentSampleRate));
             }
 
-            midTomSample = filteredSample * envelope * midTom.velocity * midTomLevel;
-            midTom.envelopeTime += 1.0f / static_cast<float>(currentSampleRate);
+            midTomSample = tomHit * midTom.velocity * midTomLevel;
         }
 
         // Clap synthesis (multi-trigger envelope + filtered noise)
         if (clap.isPlaying)
         {
             // Generate white noise
-            float noise = juce::Random::getSystemRandom().nextFloat() * 2.0f - 1.0f;
+            float noise = clap.noiseGenerator.nextFloat() * 2.0f - 1.0f;
 
             // Apply bandpass filter
             float filteredNoise = clap.bandpassFilter.processSample(0, noise);
@@ -610,7 +736,7 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
             // Exponential decay
             float envelope = std::exp(-closedHat.envelopeTime / closedHatDecay);
 
-            if (envelope < 1e-8f)
+            if (envelope < voiceStopLevel)
             {
                 closedHat.stop();
                 envelope = 0.0f;
@@ -637,7 +763,7 @@ void Drum808AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
 
             float envelope = std::exp(-openHat.envelopeTime / openHatDecay);
 
-            if (envelope < 1e-8f)
+            if (envelope < voiceStopLevel)
             {
                 openHat.stop();
                 envelope = 0.0f;
@@ -1,6 +1,21 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/OneShotRenderCache.h"
+#include "dsp/SilenceDetector.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
+
+// Parameter values for one block (level and tone in %, decay in ms, tuning in semitones)
+struct Drum808Parameters
+{
+    float kickLevel, kickTone, kickDecay, kickTuning;
+    float lowTomLevel, lowTomTone, lowTomDecay, lowTomTuning;
+    float midTomLevel, midTomTone, midTomDecay, midTomTuning;
+    float clapLevel, clapTone, clapSnap, clapTuning;
+    float closedHatLevel, closedHatTone, closedHatDecay, closedHatTuning;
+    float openHatLevel, openHatTone, openHatDecay, openHatTuning;
+};
 
 class Drum808AudioProcessor : public juce::AudioProcessor
 {
@@ -19,7 +34,7 @@ public:
     bool acceptsMidi() const override { return true; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override;
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -40,9 +55,18 @@ public:
     std::atomic<bool> closedHatTriggered{false};
     std::atomic<bool> openHatTriggered{false};
 
+    // Kick and toms play pre-rendered hits while their knobs are settled (on by default)
+    void setRenderCacheEnabled(bool shouldBeEnabled);
+
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<Drum808Parameters> parameterCache;
+
+    // Exponential voices stop once their envelope falls below -90 dB
+    static constexpr float voiceStopLevel = 3.2e-5f;
+
     // Tom Voice structure (used for both Low Tom and Mid Tom)
     struct TomVoice
     {
@@ -52,9 +76,11 @@ private:
         bool isPlaying = false;
         float envelopeTime = 0.0f;
         float velocity = 0.0f;
+        OneShotRenderCache::Playback cachedHit;
 
         void trigger(float velocityGain, float baseFreq)
         {
+            cachedHit.stop();
             isPlaying = true;
             envelopeTime = 0.0f;
             velocity = velocityGain;
@@ -66,6 +92,27 @@ private:
         {
             isPlaying = false;
             envelopeTime = 0.0f;
+            cachedHit.stop();
+        }
+
+        // Unscaled tom sample (caller applies velocity and level)
+        float renderSample(float baseFreq, float q, float decay, float sampleRate)
+        {
+            filter.setCutoffFrequency(baseFreq);
+            filter.setResonance(q);
+
+            float oscSample = oscillator.processSample(0.0f);
+            float filteredSample = filter.processSample(0, oscSample);
+            float envelope = std::exp(-envelopeTime / decay);
+
+            if (envelope < voiceStopLevel)
+            {
+                stop();
+                envelope = 0.0f;
+            }
+
+            envelopeTime += 1.0f / sampleRate;
+            return filteredSample * envelope;
         }
     };
 
@@ -78,9 +125,11 @@ private:
         bool isPlaying = false;
         float envelopeTime = 0.0f;
         float velocity = 0.0f;
+        OneShotRenderCache::Playback cachedHit;
 
         void trigger(float velocityGain)
         {
+            cachedHit.stop();
             isPlaying = true;
             envelopeTime = 0.0f;
             velocity = velocityGain;
@@ -90,6 +139,36 @@ private:
         {
             isPlaying = false;
             envelopeTime = 0.0f;
+            cachedHit.stop();
+        }
+
+        // Unscaled kick sample (caller applies velocity and level)
+        float renderSample(float baseFreq, float tone, float decay, float sampleRate)
+        {
+            // Pitch envelope: exponential sweep from 2× to 1× base frequency
+            float currentFreq = baseFreq * (1.0f + std::exp(-envelopeTime / 0.02f));
+            bodyOscillator.setFrequency(currentFreq);
+
+            // Body tone (sine oscillator)
+            float bodySignal = bodyOscillator.processSample(0.0f);
+
+            // Attack transient (noise burst scaled by tone parameter)
+            float attackSignal = (noiseGenerator.nextFloat() * 2.0f - 1.0f) *
+                                 std::exp(-envelopeTime / 0.005f) * tone;
+
+            // Amplitude envelope (exponential decay)
+            float amplitudeEnv = std::exp(-envelopeTime / decay);
+
+            // Denormal protection
+            if (amplitudeEnv < voiceStopLevel)
+            {
+                stop();
+                amplitudeEnv = 0.0f;
+            }
+
+            // Advance envelope time
+            envelopeTime += 1.0f / sampleRate;
+            return (bodySignal + attackSignal) * amplitudeEnv;
         }
     };
 
@@ -124,6 +203,7 @@ private:
     struct ClapVoice
     {
         juce::dsp::StateVariableTPTFilter<float> bandpassFilter;
+        juce::Random noiseGenerator;
         ClapEnvelopeState envelopeState = ClapEnvelopeState::Idle;
         int envelopeSample = 0;
         float velocity = 0.0f;
@@ -161,5 +241,30 @@ private:
 
     double currentSampleRate = 44100.0;
 
+    // Render cache (kick and toms are deterministic once their knobs are known).
+    // Each cache holds one key (0); velocity and level are applied at playback.
+    int renderKick(float* dest, int maxSamples);
+    int renderTom(TomVoice& renderVoice, float tuning, float tonePercent, float decayMs,
+                  float rootFreq, float* dest, int maxSamples);
+
+    KickVoice kickRenderVoice;     // Render thread only
+    TomVoice lowTomRenderVoice;    // Render thread only
+    TomVoice midTomRenderVoice;    // Render thread only
+
+    OneShotRenderCache kickCache { 1, [this](int, float* dest, int maxSamples)
+                                      { return renderKick(dest, maxSamples); } };
+    OneShotRenderCache lowTomCache { 1, [this](int, float* dest, int maxSamples)
+                                        { const auto params = parameterCache.load();
+                                          return renderTom(lowTomRenderVoice, params.lowTomTuning, params.lowTomTone, params.lowTomDecay,
+                                                           150.0f, dest, maxSamples); } };
+    OneShotRenderCache midTomCache { 1, [this](int, float* dest, int maxSamples)
+                                        { const auto params = parameterCache.load();
+                                          return renderTom(midTomRenderVoice, params.midTomTuning, params.midTomTone, params.midTomDecay,
+                                                           220.0f, dest, maxSamples); } };
+    juce::TimeSliceThread renderCacheThread { "Drum808 render cache" };
+
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("Drum808");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Drum808AudioProcessor)
 };
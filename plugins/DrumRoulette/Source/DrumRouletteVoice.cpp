@@ -65,6 +65,10 @@ void DrumRouletteVoice::setCurrentPlaybackSampleRate(double newRate)
     spec.maximumBlockSize = 512;  // Reasonable default for per-voice processing
     spec.numChannels = 1;  // Per-voice is mono
 
+    // Second-order coefficients up front, so startNote() only overwrites them in place
+    lowShelfFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(newRate, 1000.0f, 0.707f, 1.0f);
+    highShelfFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(newRate, 1000.0f, 0.707f, 1.0f);
+
     lowShelfFilter.prepare(spec);
     highShelfFilter.prepare(spec);
     volumeGain.prepare(spec);
@@ -121,15 +125,13 @@ void DrumRouletteVoice::startNote(int midiNoteNumber, float velocity, juce::Synt
         float tiltDb = tiltFilterParam->load();
         float tiltGain = juce::Decibels::decibelsToGain(tiltDb);
 
-        // Low-shelf (below 1kHz): Same polarity as tilt value
-        auto lowShelfCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
+        // Low-shelf (below 1kHz): Same polarity as tilt value (in place: no allocation)
+        *lowShelfFilter.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeLowShelf(
             voiceSampleRate, 1000.0f, 0.707f, tiltGain);
-        *lowShelfFilter.coefficients = *lowShelfCoeffs;
 
         // High-shelf (above 1kHz): Opposite polarity (inverse gain)
-        auto highShelfCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
+        *highShelfFilter.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeHighShelf(
             voiceSampleRate, 1000.0f, 0.707f, 1.0f / tiltGain);
-        *highShelfFilter.coefficients = *highShelfCoeffs;
     }
 }
 
@@ -191,6 +191,7 @@ void DrumRouletteAudioProcessor::releaseResources()
 void DrumRouletteAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("DrumRoulette", "processBlock");
 
     // Clear all output buses
     for (int busIndex = 0; busIndex < getBusCount(false); ++busIndex)
@@ -216,7 +217,10 @@ void DrumRouletteAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // Render synthesiser to main output
     // Note: Voices check solo/mute state in their renderNextBlock via shouldRenderToMainMix()
     // This implementation renders all voices but voices can apply their own gain scaling
-    synthesiser.renderNextBlock(mainBuffer, midiMessages, 0, mainBuffer.getNumSamples());
+    {
+        PFS_TRACE_SCOPE("DrumRoulette", "voices");
+        synthesiser.renderNextBlock(mainBuffer, midiMessages, 0, mainBuffer.getNumSamples());
+    }
 
     // Copy individual slot outputs (Bus 1-8)
     // Individual outputs are always active regardless of solo/mute
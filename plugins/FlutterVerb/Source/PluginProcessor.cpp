@@ -66,6 +66,20 @@ juce::AudioProcessorValueTreeState::ParameterLayout FlutterVerbAudioProcessor::c
         false  // Default: WET ONLY (0)
     ));
 
+    // ECO - Reverb with 8 delay lines instead of 16 (about half the CPU)
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { "ECO", 1 },
+        "Eco",
+        false
+    ));
+
+    // LOW_RATE - Run the reverb tank at 44.1/48kHz in 88.2kHz+ sessions (no effect below)
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { "LOW_RATE", 1 },
+        "Low-Rate Reverb",
+        false
+    ));
+
     return layout;
 }
 
@@ -74,11 +88,49 @@ FlutterVerbAudioProcessor::FlutterVerbAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "SIZE", &FlutterVerbParameters::size },
+                                   { "DECAY", &FlutterVerbParameters::decay },
+                                   { "MIX", &FlutterVerbParameters::mix },
+                                   { "AGE", &FlutterVerbParameters::age },
+                                   { "DRIVE", &FlutterVerbParameters::drive },
+                                   { "TONE", &FlutterVerbParameters::tone },
+                                   { "MOD_MODE", &FlutterVerbParameters::modMode },
+                                   { "ECO", &FlutterVerbParameters::eco },
+                                   { "LOW_RATE", &FlutterVerbParameters::lowRate } })
 {
+    startTimerHz(10);  // Latency changes from the audio thread reach the host within 100ms
 }
 
 FlutterVerbAudioProcessor::~FlutterVerbAudioProcessor()
 {
+    stopTimer();
+}
+
+void FlutterVerbAudioProcessor::timerCallback()
+{
+    const int latency = pendingLatencySamples.load();
+
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void FlutterVerbAudioProcessor::updateLatency(const FlutterVerbParameters& params) noexcept
+{
+    // LOW_RATE resets the reverb when it changes
+    reverb.setRate(params.lowRate ? FdnReverb::reducedRateFor(currentSampleRate) : FdnReverb::Rate::full);
+
+    // Dry path waits for the reverb's resampling filters
+    dryWetMixer.setWetLatency(static_cast<float>(reverb.getLatencySamples()));
+
+    // In WET+DRY mode both paths go through the modulation delay (centred on 50ms)
+    const int modulationLatency = params.modMode ? juce::roundToInt(0.05 * currentSampleRate) : 0;
+    const int totalLatency = reverb.getLatencySamples() + modulationLatency;
+
+    if (totalLatency != currentTotalLatency)
+    {
+        currentTotalLatency = totalLatency;
+        pendingLatencySamples.store(totalLatency);
+    }
 }
 
 void FlutterVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
@@ -95,28 +147,38 @@ void FlutterVerbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     dryWetMixer.prepare(spec);
     dryWetMixer.reset();
 
-    // Fix 2: Set wet path latency compensation for modulation delay (50ms base delay)
-    float baseDelayMs = 50.0f;
-    int latencySamples = static_cast<int>((baseDelayMs / 1000.0f) * sampleRate);
-    dryWetMixer.setWetLatency(latencySamples);
+    // Prepare reverb (allocates its delay lines)
+    reverb.prepare(sampleRate, samplesPerBlock);
 
-    // Prepare reverb with ProcessSpec
-    reverb.prepare(spec);
-    reverb.reset();
+    // The 50ms modulation delay is not compensated inside the plugin: in WET ONLY mode
+    // it is the reverb pre-delay. Only the reduced-rate reverb filters are.
+    updateLatency(parameterCache.load());
+    pendingLatencySamples.store(currentTotalLatency);
+    setLatencySamples(currentTotalLatency);
 
     // Phase 4.2: Prepare modulation system
-    modulationDelay.prepare(spec);
-    modulationDelay.reset();
-    modulationDelay.setMaximumDelayInSamples(static_cast<int>(sampleRate * 0.2)); // 200ms max
-
-    // Initialize per-channel LFO phase tracking
-    wowPhase.resize(spec.numChannels, 0.0f);
-    flutterPhase.resize(spec.numChannels, 0.0f);
-
-    // Phase 4.3: Prepare filter
-    toneFilter.prepare(spec);
-    toneFilter.reset();
-    currentFilterType = FilterType::None;
+    modulationDelay.prepare(static_cast<int>(spec.numChannels), static_cast<int>(sampleRate * 0.2), samplesPerBlock); // 200ms max
+    delayTrajectory.setSize(static_cast<int>(spec.numChannels), samplesPerBlock);
+
+    // Per-channel LFOs: wow 1Hz, flutter 6Hz, all starting at phase 0
+    wowLfo.assign(spec.numChannels, {});
+    flutterLfo.assign(spec.numChannels, {});
+
+    for (auto& lfo : wowLfo)
+        lfo.setFrequency(1.0, sampleRate);
+
+    for (auto& lfo : flutterLfo)
+        lfo.setFrequency(6.0, sampleRate);
+
+    // Phase 4.3: Prepare filter at the current TONE position (no sweep on start)
+    toneFilter.setPosition(parameterCache.load().tone / 100.0f);
+    toneFilter.prepare(sampleRate, static_cast<int>(spec.numChannels));
+
+    silenceDetector.prepare(sampleRate);
+
+    // The reverb/mix stage starts on
+    mixStage.prepare(sampleRate, samplesPerBlock, static_cast<int>(spec.numChannels));
+    mixStage.reset(true);
 }
 
 void FlutterVerbAudioProcessor::releaseResources()
@@ -124,58 +186,82 @@ void FlutterVerbAudioProcessor::releaseResources()
     // DSP cleanup will be added in Stage 4
 }
 
+double FlutterVerbAudioProcessor::computeTailSeconds() const
+{
+    // DRIVE boosts the tail by up to 20dB before the tanh, so it has further to fall
+    const auto params = parameterCache.load();
+    const float driveValue = params.drive / 100.0f;
+    const float driveDb = juce::Decibels::gainToDecibels(1.0f + driveValue * 9.0f);
+
+    const double reverbTail = SilenceDetector::reverbTailSeconds(params.decay, SilenceDetector::defaultThresholdDb - driveDb);
+
+    // Plus the modulation delay (50ms +-20%) and the reduced-rate reverb filters
+    return reverbTail + 0.06 + reverb.getLatencySamples() / currentSampleRate;
+}
+
 void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("FlutterVerb", "processBlock");
     juce::ignoreUnused(midiMessages);
 
     // Clear unused channels
     for (int i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Phase 4.1: Read SIZE, DECAY, MIX parameters (atomic, real-time safe)
-    auto* sizeParam = parameters.getRawParameterValue("SIZE");
-    auto* decayParam = parameters.getRawParameterValue("DECAY");
-    auto* mixParam = parameters.getRawParameterValue("MIX");
-
-    float sizeValue = sizeParam->load() / 100.0f;  // 0-100% → 0.0-1.0
-    float decayValue = decayParam->load();          // 0.1-10.0 seconds
-    float mixValue = mixParam->load() / 100.0f;     // 0-100% → 0.0-1.0
+    // Read every parameter in one atomic snapshot (real-time safe)
+    const auto params = parameterCache.load();
 
-    // Phase 4.2: Read AGE parameter for modulation depth
-    auto* ageParam = parameters.getRawParameterValue("AGE");
-    float ageValue = ageParam->load() / 100.0f;  // 0-100% → 0.0-1.0
+    // Latency follows LOW_RATE and MOD_MODE even while asleep: setLatencySamples
+    // notifies the host, so the message thread picks it up from the timer
+    updateLatency(params);
 
-    // Phase 4.3: Read DRIVE and TONE parameters
-    auto* driveParam = parameters.getRawParameterValue("DRIVE");
-    auto* toneParam = parameters.getRawParameterValue("TONE");
-    float driveValue = driveParam->load() / 100.0f;  // 0-100% → 0.0-1.0
-    float toneValue = toneParam->load();  // -100 to +100
+    // Skip the whole chain once the input has been silent for longer than the tail
+    silenceDetector.setTailSeconds(computeTailSeconds());
+    const auto activity = silenceDetector.update(buffer.getArrayOfReadPointers(),
+                                                 juce::jmin(getTotalNumInputChannels(), buffer.getNumChannels()),
+                                                 buffer.getNumSamples());
 
-    // Phase 4.4: Read MOD_MODE parameter for routing control
-    auto* modModeParam = parameters.getRawParameterValue("MOD_MODE");
-    bool wetDryMode = modModeParam->load() > 0.5f;  // 0=WET_ONLY, 1=WET_DRY
+    if (activity != SilenceDetector::State::processing)
+    {
+        // Start the next sound from empty delay lines and filters
+        if (activity == SilenceDetector::State::enteringSleep)
+        {
+            reverb.reset();
+            modulationDelay.reset();
+            toneFilter.reset();
+            dryWetMixer.reset();
+        }
 
-    // Configure reverb parameters with true SIZE/DECAY independence
-    juce::Reverb::Parameters reverbParams;
+        buffer.clear();
+        outputLevel.store(-100.0f, std::memory_order_relaxed);
+        return;
+    }
 
-    // Map SIZE to base room size: 0-100% → 0.2-0.6 (ensures minimum space for reverb)
-    float baseRoomSize = 0.2f + (sizeValue * 0.4f);
+    // Phase 4.1: SIZE, DECAY, MIX
+    float sizeValue = params.size / 100.0f;  // 0-100% → 0.0-1.0
+    float decayValue = params.decay;          // 0.1-10.0 seconds
+    float mixValue = params.mix / 100.0f;     // 0-100% → 0.0-1.0
 
-    // Map DECAY to multiplier: 0.1-10s → 0.5-2.0x (scales effective room size for tail length)
-    float decayMultiplier = juce::jmap(decayValue, 0.1f, 10.0f, 0.5f, 2.0f);
+    // Phase 4.2: AGE for modulation depth
+    float ageValue = params.age / 100.0f;  // 0-100% → 0.0-1.0
 
-    // Combine: roomSize affected by both SIZE and DECAY, clamped to valid range
-    reverbParams.roomSize = juce::jlimit(0.1f, 1.0f, baseRoomSize * decayMultiplier);
+    // Phase 4.3: DRIVE and TONE
+    float driveValue = params.drive / 100.0f;  // 0-100% → 0.0-1.0
+    float toneValue = params.tone;  // -100 to +100
 
-    // Keep damping for frequency-dependent absorption (complementary control)
-    reverbParams.damping = juce::jmap(decayValue, 0.1f, 10.0f, 0.95f, 0.05f);
+    // Phase 4.4: MOD_MODE for routing control
+    bool wetDryMode = params.modMode;  // 0=WET_ONLY, 1=WET_DRY
 
-    reverbParams.width = 1.0f;         // Full stereo
-    reverbParams.freezeMode = 0.0f;    // No freeze
-    reverbParams.wetLevel = 1.0f;      // Full wet (mixer handles blend)
-    reverbParams.dryLevel = 0.0f;      // No dry (mixer handles blend)
+    // Configure reverb: SIZE sets the line lengths, DECAY is the actual RT60
+    FdnReverb::Parameters reverbParams;
+    reverbParams.size = sizeValue;
+    reverbParams.decaySeconds = decayValue;
+    reverbParams.damping = 0.4f;            // HF decays ~1.6x faster than LF
+    reverbParams.modulationDepth = 0.0f;    // AGE wow/flutter already moves the wet path
+    reverbParams.width = 1.0f;              // Full stereo
 
+    reverb.setQuality(params.eco ? FdnReverb::Quality::eco : FdnReverb::Quality::standard);
     reverb.setParameters(reverbParams);
 
     // Set dry/wet mix proportion
@@ -185,68 +271,46 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     juce::dsp::AudioBlock<float> block(buffer);
 
     // Phase 4.4: Define modulation processing function (reusable for both routing modes)
+    // The delay always runs so the 50ms pre-delay does not depend on AGE;
+    // AGE = 0 gives a plain 50ms delay.
     auto applyModulation = [&]() {
-        if (ageValue > 0.0f)  // Only apply modulation if AGE > 0
-        {
-            const int numChannels = buffer.getNumChannels();
-            const int numSamples = buffer.getNumSamples();
-
-            // LFO configuration
-            const float wowFreqHz = 1.0f;      // Center frequency: 1Hz (range 0.5-1.5Hz)
-            const float flutterFreqHz = 6.0f;  // Center frequency: 6Hz (range 4-8Hz)
-            const float baseDelayMs = 50.0f;   // Base delay: 50ms
-            const float maxModDepth = 0.2f;    // ±20% at AGE=100%
-
-            // Calculate phase increments (radians per sample)
-            const float wowPhaseInc = (wowFreqHz * 2.0f * juce::MathConstants<float>::pi) / static_cast<float>(currentSampleRate);
-            const float flutterPhaseInc = (flutterFreqHz * 2.0f * juce::MathConstants<float>::pi) / static_cast<float>(currentSampleRate);
-
-            // Process each channel
-            for (int channel = 0; channel < numChannels; ++channel)
-            {
-                auto* channelData = buffer.getWritePointer(channel);
-
-                for (int sample = 0; sample < numSamples; ++sample)
-                {
-                    // Calculate wow LFO output (sine wave)
-                    float wowOutput = std::sin(wowPhase[channel]);
+        PFS_TRACE_SCOPE("FlutterVerb", "modulation");
 
-                    // Calculate flutter LFO output (sine wave)
-                    float flutterOutput = std::sin(flutterPhase[channel]);
+        const int numChannels = juce::jmin(buffer.getNumChannels(), delayTrajectory.getNumChannels(), 2);
+        const int numSamples = buffer.getNumSamples();
 
-                    // Combine modulation signals (both contribute to pitch variation)
-                    float totalModulation = (wowOutput + flutterOutput) * 0.5f;  // Average to keep in ±1.0 range
+        // LFO configuration (wow 1Hz, flutter 6Hz: frequencies set in prepareToPlay)
+        const float baseDelayMs = 50.0f;   // Base delay: 50ms
+        const float maxModDepth = 0.2f;    // ±20% at AGE=100%
 
-                    // Fix 3: Scale by AGE parameter with exponential curve for more usable range
-                    // Exponential scaling gives more control in 0-50% range, still reaches extremes at 100%
-                    float scaledAge = ageValue * ageValue;  // Exponential response
-                    totalModulation *= scaledAge;
+        // Fix 3: Scale by AGE parameter with exponential curve for more usable range
+        // Exponential scaling gives more control in 0-50% range, still reaches extremes at 100%
+        const float scaledAge = ageValue * ageValue;  // Exponential response
 
-                    // Calculate modulated delay time in samples
-                    float baseDelaySamples = (baseDelayMs / 1000.0f) * static_cast<float>(currentSampleRate);
-                    float modulationAmount = baseDelaySamples * maxModDepth * totalModulation;  // ±20% depth
-                    float delayTimeSamples = baseDelaySamples + modulationAmount;
+        // Wow and flutter are averaged to keep the combined LFO in ±1.0, then scaled to ±20% depth
+        const float baseDelaySamples = (baseDelayMs / 1000.0f) * static_cast<float>(currentSampleRate);
+        const float lfoDepthSamples = baseDelaySamples * maxModDepth * scaledAge * 0.5f;
 
-                    // Ensure delay time is within valid range
-                    delayTimeSamples = juce::jlimit(1.0f, static_cast<float>(currentSampleRate * 0.2), delayTimeSamples);
+        // Each channel gets its own delay trajectory, then the whole block goes through the line
+        const int maxChunk = delayTrajectory.getNumSamples();
 
-                    // Set delay time for this channel
-                    modulationDelay.setDelay(static_cast<float>(delayTimeSamples));
+        for (int offset = 0; offset < numSamples; offset += maxChunk)
+        {
+            const int chunk = juce::jmin(maxChunk, numSamples - offset);
+            float* channelChunks[2] {};
 
-                    // Process sample through delay line
-                    modulationDelay.pushSample(channel, channelData[sample]);
-                    channelData[sample] = modulationDelay.popSample(channel);
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* trajectory = delayTrajectory.getWritePointer(channel);
 
-                    // Update LFO phases with wrapping
-                    wowPhase[channel] += wowPhaseInc;
-                    if (wowPhase[channel] >= 2.0f * juce::MathConstants<float>::pi)
-                        wowPhase[channel] -= 2.0f * juce::MathConstants<float>::pi;
+                wowLfo[static_cast<size_t>(channel)].render(trajectory, chunk, lfoDepthSamples);
+                flutterLfo[static_cast<size_t>(channel)].renderAdd(trajectory, chunk, lfoDepthSamples);
+                juce::FloatVectorOperations::add(trajectory, baseDelaySamples, chunk);
 
-                    flutterPhase[channel] += flutterPhaseInc;
-                    if (flutterPhase[channel] >= 2.0f * juce::MathConstants<float>::pi)
-                        flutterPhase[channel] -= 2.0f * juce::MathConstants<float>::pi;
-                }
+                channelChunks[channel] = buffer.getWritePointer(channel) + offset;
             }
+
+            modulationDelay.process(channelChunks, delayTrajectory.getArrayOfReadPointers(), numChannels, chunk);
         }
     };
 
@@ -274,59 +338,10 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     };
 
     // Define TONE filter lambda for reusability
+    // -100% = low-pass at 200Hz, 0% = no filtering, +100% = high-pass at 10kHz
     auto applyToneFilter = [&]() {
-        if (std::abs(toneValue) > 0.5f)  // Bypass zone: |TONE| <= 0.5%
-        {
-            float sampleRate = static_cast<float>(currentSampleRate);
-            bool isLowPass = (toneValue < 0.0f);
-
-            // Determine filter type and reset state if type changed
-            FilterType newFilterType = isLowPass ? FilterType::LowPass : FilterType::HighPass;
-            if (newFilterType != currentFilterType)
-            {
-                toneFilter.reset();  // Prevent burst artifacts on type transition
-                currentFilterType = newFilterType;
-            }
-
-            if (isLowPass)
-            {
-                // Low-pass filter (negative values: -100% to 0%)
-                // Exponential mapping: 200Hz (extreme) to 20kHz (center)
-                float normalizedValue = std::abs(toneValue) / 100.0f;  // 0.0 to 1.0
-                float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(100.0f));
-                cutoffHz = juce::jlimit(200.0f, 20000.0f, cutoffHz);
-
-                *toneFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                    sampleRate, cutoffHz, 0.707f  // Q = 0.707 (Butterworth)
-                );
-            }
-            else
-            {
-                // High-pass filter (positive values: 0% to +100%)
-                // Exponential mapping: 20Hz (center) to 10kHz (extreme)
-                float normalizedValue = toneValue / 100.0f;  // 0.0 to 1.0
-                float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(500.0f));
-                cutoffHz = juce::jlimit(20.0f, 10000.0f, cutoffHz);
-
-                *toneFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-                    sampleRate, cutoffHz, 0.707f  // Q = 0.707 (Butterworth)
-                );
-            }
-
-            // Process buffer through filter
-            juce::dsp::AudioBlock<float> filterBlock(buffer);
-            juce::dsp::ProcessContextReplacing<float> filterContext(filterBlock);
-            toneFilter.process(filterContext);
-        }
-        else
-        {
-            // Reset filter state when entering bypass zone
-            if (currentFilterType != FilterType::None)
-            {
-                toneFilter.reset();
-                currentFilterType = FilterType::None;
-            }
-        }
+        toneFilter.setPosition(toneValue / 100.0f);
+        toneFilter.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
     };
 
     // Phase 4.4: MOD_MODE Routing with correct DRIVE/TONE positioning
@@ -338,23 +353,46 @@ void FlutterVerbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
         applyToneFilter();  // Then filter - all affect both dry and wet
     }
 
-    // Push dry samples (processed in Mode 1, clean in Mode 0)
-    dryWetMixer.pushDrySamples(block);
-
-    // Process reverb using modern DSP API
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    reverb.process(context);
-
-    if (!wetDryMode)
-    {
-        // Mode 0 (WET ONLY): Apply effects AFTER reverb (affects only wet path)
-        applyModulation();  // Modulation on wet only
-        applyDrive();       // Saturation on wet only
-        applyToneFilter();  // Filter on wet only
-    }
-
-    // Mix dry and wet samples
-    dryWetMixer.mixWetSamples(block);
+    // Reverb, wet-only effects and the mix only change the sound while MIX is up, or
+    // while the dry path is delayed to match LOW_RATE. Otherwise they crossfade out
+    // and stop; they restart from empty state, faded in as MIX comes up.
+    mixStage.setActive(mixValue > 0.0f || reverb.getLatencySamples() > 0);
+
+    mixStage.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples(),
+                     [&] {
+                         // Push dry samples (processed in Mode 1, clean in Mode 0)
+                         dryWetMixer.pushDrySamples(block);
+
+                         // Process reverb (100% wet, in place)
+                         {
+                             PFS_TRACE_SCOPE("FlutterVerb", "reverb");
+                             reverb.process(buffer.getWritePointer(0),
+                                            buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr,
+                                            buffer.getNumSamples());
+                         }
+
+                         if (!wetDryMode)
+                         {
+                             // Mode 0 (WET ONLY): Apply effects AFTER reverb (affects only wet path)
+                             applyModulation();  // Modulation on wet only
+                             applyDrive();       // Saturation on wet only
+                             applyToneFilter();  // Filter on wet only
+                         }
+
+                         // Mix dry and wet samples
+                         dryWetMixer.mixWetSamples(block);
+                     },
+                     [&] {
+                         reverb.reset();
+                         dryWetMixer.reset();
+
+                         // In Mode 0 the modulation and tone filter only carry the wet signal
+                         if (!wetDryMode)
+                         {
+                             modulationDelay.reset();
+                             toneFilter.reset();
+                         }
+                     });
 
     // Fix 5: Calculate peak level for VU meter (after all DSP processing)
     // Store in dB format directly (like TapeAge pattern)
@@ -1,8 +1,31 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/DjFilter.h"
+#include "dsp/FdnReverb.h"
+#include "dsp/ModulatedDelayLine.h"
+#include "dsp/QuadratureOscillator.h"
+#include "dsp/SilenceDetector.h"
+#include "dsp/StageBypass.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
+
+// Parameter values for one block (SIZE, MIX, AGE, DRIVE and TONE in %, DECAY in s)
+struct FlutterVerbParameters
+{
+    float size;
+    float decay;
+    float mix;
+    float age;
+    float drive;
+    float tone;
+    bool modMode;
+    bool eco;
+    bool lowRate;
+};
 
-class FlutterVerbAudioProcessor : public juce::AudioProcessor
+class FlutterVerbAudioProcessor : public juce::AudioProcessor,
+                                  private juce::Timer
 {
 public:
     FlutterVerbAudioProcessor();
@@ -19,7 +42,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return computeTailSeconds(); }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -38,19 +61,32 @@ private:
     juce::dsp::ProcessSpec spec;
 
     // Phase 4.1: Core Reverb Processing
-    juce::dsp::Reverb reverb;
-    juce::dsp::DryWetMixer<float> dryWetMixer;
+    FdnReverb reverb;
+    juce::dsp::DryWetMixer<float> dryWetMixer { 256 };  // Max latency: reduced-rate reverb filters (90 samples)
 
     // Phase 4.2: Modulation System
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> modulationDelay { 9600 }; // 200ms at 48kHz
-    std::vector<float> wowPhase;    // Per-channel wow LFO phase (0-2π)
-    std::vector<float> flutterPhase; // Per-channel flutter LFO phase (0-2π)
+    ModulatedDelayLine modulationDelay;  // One delay trajectory per channel
+    std::vector<QuadratureOscillator> wowLfo;      // Per-channel wow LFO
+    std::vector<QuadratureOscillator> flutterLfo;  // Per-channel flutter LFO
+    juce::AudioBuffer<float> delayTrajectory;      // Per-channel delay in samples for the current block
     double currentSampleRate = 44100.0; // Store sample rate for LFO calculations
 
     // Phase 4.3: Saturation and Filter
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> toneFilter;
-    enum class FilterType { None, LowPass, HighPass };
-    FilterType currentFilterType = FilterType::None;
+    DjFilter toneFilter;  // TONE: low-pass/high-pass, dry at the centre
+
+    // Reverb + mix, skipped at MIX 0
+    StageBypass mixStage;
+
+    // Sleeps once the input has been silent for longer than the tail
+    SilenceDetector silenceDetector;
+    double computeTailSeconds() const;
+
+    // Latency = reduced-rate reverb filters, plus the 50ms modulation delay in WET+DRY
+    // mode, where it delays the dry path too. The host compensates for the total.
+    void updateLatency(const FlutterVerbParameters& params) noexcept;
+    void timerCallback() override;  // Reports latency changes to the host
+    int currentTotalLatency = 0;
+    std::atomic<int> pendingLatencySamples { 0 };  // Audio thread → message thread timer
 
     // APVTS comes AFTER DSP components
     juce::AudioProcessorValueTreeState parameters;
@@ -62,11 +98,17 @@ private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<FlutterVerbParameters> parameterCache;
+
 public:
     // VU meter accessor (UI thread reads, audio thread writes)
     // Fix 5: Returns dB value directly
     float getCurrentOutputLevel() const { return outputLevel.load(std::memory_order_relaxed); }
 
 private:
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("FlutterVerb");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FlutterVerbAudioProcessor)
 };
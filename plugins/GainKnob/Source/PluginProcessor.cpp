@@ -33,6 +33,15 @@ juce::AudioProcessorValueTreeState::ParameterLayout GainKnobAudioProcessor::crea
         "%"
     ));
 
+    // PAN_LAW - Choice parameter (constant power or balance)
+    // Constant power: both sides -3dB at centre. Balance: 0dB at centre, panning only turns the other side down
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "PAN_LAW", 1 },
+        "Pan Law",
+        juce::StringArray { "-3 dB (Constant Power)", "0 dB (Balance)" },
+        0
+    ));
+
     return layout;
 }
 
@@ -41,23 +50,99 @@ GainKnobAudioProcessor::GainKnobAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "GAIN", &GainKnobParameters::gain },
+                                   { "PAN", &GainKnobParameters::pan },
+                                   { "FILTER", &GainKnobParameters::filter },
+                                   { "PAN_LAW", &GainKnobParameters::panLaw } })
 {
+    // Left-side gain at pan = -1 + 2k/size; the right side is the same curve mirrored
+    for (int k = 0; k <= panTableSize; ++k)
+    {
+        const float pan = -1.0f + 2.0f * static_cast<float>(k) / static_cast<float>(panTableSize);
+        const float halfPi = juce::MathConstants<float>::halfPi;
+
+        panLawTable[0][static_cast<size_t>(k)] = std::cos((pan * 0.5f + 0.5f) * halfPi);
+        panLawTable[1][static_cast<size_t>(k)] = pan <= 0.0f ? 1.0f : std::cos(pan * halfPi);
+    }
 }
 
 GainKnobAudioProcessor::~GainKnobAudioProcessor()
 {
 }
 
+bool GainKnobAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    // Same layout in and out, mono up to 7.1.4
+    const auto& output = layouts.getMainOutputChannelSet();
+
+    return !output.isDisabled()
+        && output.size() <= maxChannels
+        && output == layouts.getMainInputChannelSet();
+}
+
+GainKnobAudioProcessor::PanSide GainKnobAudioProcessor::panSideFor(juce::AudioChannelSet::ChannelType type)
+{
+    using Set = juce::AudioChannelSet;
+
+    switch (type)
+    {
+        case Set::left:
+        case Set::leftCentre:
+        case Set::leftSurround:
+        case Set::leftSurroundSide:
+        case Set::leftSurroundRear:
+        case Set::wideLeft:
+        case Set::topFrontLeft:
+        case Set::topSideLeft:
+        case Set::topRearLeft:
+            return PanSide::left;
+
+        case Set::right:
+        case Set::rightCentre:
+        case Set::rightSurround:
+        case Set::rightSurroundSide:
+        case Set::rightSurroundRear:
+        case Set::wideRight:
+        case Set::topFrontRight:
+        case Set::topSideRight:
+        case Set::topRearRight:
+            return PanSide::right;
+
+        default:
+            return PanSide::centre;
+    }
+}
+
+float GainKnobAudioProcessor::lookUpPanLaw(int law, float pan) const noexcept
+{
+    const auto& table = panLawTable[static_cast<size_t>(law)];
+    const float position = juce::jlimit(0.0f, 1.0f, pan * 0.5f + 0.5f) * static_cast<float>(panTableSize);
+    const int index = juce::jmin(static_cast<int>(position), panTableSize - 1);
+    const float fraction = position - static_cast<float>(index);
+
+    return table[static_cast<size_t>(index)] + fraction * (table[static_cast<size_t>(index + 1)] - table[static_cast<size_t>(index)]);
+}
+
 void GainKnobAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // Initialize filter processor
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
-
-    filterProcessor.prepare(spec);
-    filterProcessor.reset();
+    // Initialize filter at the current FILTER position (no sweep on start)
+    djFilter.setPosition(parameterCache.load().filter / 100.0f);
+    djFilter.prepare(sampleRate, getTotalNumOutputChannels());
+    juce::ignoreUnused(samplesPerBlock);
+
+    // Pan side of each channel from the layout (stereo: left, right; mono: neither)
+    const auto layout = getChannelLayoutOfBus(false, 0);
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+        channelSides[static_cast<size_t>(channel)] = channel < layout.size()
+            ? panSideFor(layout.getTypeOfChannel(channel))
+            : PanSide::centre;
+
+    for (auto& gain : channelGains)
+        gain.reset(sampleRate, 0.02);
+
+    // Gains start at their targets (no fade-in on start)
+    snapGains = true;
 }
 
 void GainKnobAudioProcessor::releaseResources()
@@ -68,96 +153,58 @@ void GainKnobAudioProcessor::releaseResources()
 void GainKnobAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("GainKnob", "processBlock");
     juce::ignoreUnused(midiMessages);
 
-    // Read GAIN parameter (atomic read, real-time safe)
-    auto* gainParam = parameters.getRawParameterValue("GAIN");
-    float gainDb = gainParam->load();
-
-    // Read PAN parameter (atomic read, real-time safe)
-    auto* panParam = parameters.getRawParameterValue("PAN");
-    float panPercent = panParam->load();
-
-    // Read FILTER parameter (atomic read, real-time safe)
-    auto* filterParam = parameters.getRawParameterValue("FILTER");
-    float filterPercent = filterParam->load();
-
-    // Apply DJ-style filter (if not at center position)
-    if (std::abs(filterPercent) > 0.5f) {
-        float sampleRate = static_cast<float>(getSampleRate());
-        bool isLowPass = (filterPercent < 0.0f);
-
-        // Reset filter state when switching between low-pass and high-pass
-        // Prevents burst caused by residual energy in delay buffers
-        if (isLowPass != previousWasLowPass) {
-            filterProcessor.reset();
-        }
-        previousWasLowPass = isLowPass;
-
-        if (isLowPass) {
-            // Low-pass filter (negative values)
-            // Exponential mapping: -100% = 200Hz (heavy bass), 0% = 20kHz (bypass)
-            // Formula inverted: Start high at center, go low at extreme
-            float normalizedValue = std::abs(filterPercent) / 100.0f; // 0.0 to 1.0
-            float cutoffHz = 20000.0f * std::pow(10.0f, -normalizedValue * std::log10(20000.0f / 200.0f));
-
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                sampleRate, juce::jlimit(200.0f, 20000.0f, cutoffHz), 0.707f
-            );
-        } else {
-            // High-pass filter (positive values)
-            // Exponential mapping: 0% = 20Hz (bypass), +100% = 10kHz (heavy treble)
-            // Formula: Start low at center, go high at extreme
-            float normalizedValue = filterPercent / 100.0f; // 0.0 to 1.0
-            float cutoffHz = 20.0f * std::pow(10.0f, normalizedValue * std::log10(10000.0f / 20.0f));
-
-            *filterProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-                sampleRate, juce::jlimit(20.0f, 10000.0f, cutoffHz), 0.707f
-            );
-        }
-
-        // Process buffer through filter
-        juce::dsp::AudioBlock<float> block(buffer);
-        juce::dsp::ProcessContextReplacing<float> context(block);
-        filterProcessor.process(context);
-    } else {
-        // Reset filter state when entering bypass zone
-        // Prevents residual energy when re-entering filter range
-        if (previousWasLowPass) {
-            filterProcessor.reset();
-            previousWasLowPass = false;
-        }
+    // Read parameters (one atomic snapshot, real-time safe)
+    const auto params = parameterCache.load();
+    const float gainDb = params.gain;
+    const float panPercent = params.pan;
+    const float filterPercent = params.filter;
+    const int panLaw = juce::jlimit(0, 1, params.panLaw);
+
+    // Special case: treat near-minimum as complete silence
+    // This avoids floating-point denormals and ensures true silence at minimum
+    const float gainLinear = gainDb <= -59.9f ? 0.0f : juce::Decibels::decibelsToGain(gainDb);
+
+    // Pan gain per side: pan range -100 (full left) to +100 (full right).
+    // Centre and LFE channels take the law's centre gain, so at pan 0 every channel
+    // sits at the same level.
+    const float panNormalized = panPercent / 100.0f;
+    const float sideGains[3] { lookUpPanLaw(panLaw, panNormalized) * gainLinear,
+                               lookUpPanLaw(panLaw, 0.0f) * gainLinear,
+                               lookUpPanLaw(panLaw, -panNormalized) * gainLinear };
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), maxChannels);
+    const int numSamples = buffer.getNumSamples();
+
+    if (numSamples == 0)
+        return;
+
+    // One linear ramp per channel from where its gain is now to where it is at the
+    // end of the block
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto& gain = channelGains[static_cast<size_t>(channel)];
+        const float target = sideGains[static_cast<int>(channelSides[static_cast<size_t>(channel)])];
+
+        if (snapGains)
+            gain.setCurrentAndTargetValue(target);
+        else
+            gain.setTargetValue(target);
+
+        // First sample one step along, last sample exactly on the block-end value
+        const float start = gain.getCurrentValue();
+        const float step = (gain.skip(numSamples) - start) / static_cast<float>(numSamples);
+        gainRamps[static_cast<size_t>(channel)] = { start + step, step };
     }
 
-    // Convert dB to linear gain multiplier
-    float gainLinear;
-
-    if (gainDb <= -59.9f) {
-        // Special case: treat near-minimum as complete silence
-        // This avoids floating-point denormals and ensures true silence at minimum
-        gainLinear = 0.0f;
-    } else {
-        // Standard dB to linear conversion: gain = 10^(dB/20)
-        gainLinear = juce::Decibels::decibelsToGain(gainDb);
-    }
-
-    // Calculate pan coefficients using constant power panning
-    // Pan range: -100 (full left) to +100 (full right)
-    // At center (0), both channels are at 0.707 (-3dB) for equal power
-    float panNormalized = panPercent / 100.0f; // Convert to -1.0 to +1.0
-    float panRadians = (panNormalized * 0.25f + 0.25f) * juce::MathConstants<float>::pi;
-
-    float leftGain = std::cos(panRadians) * gainLinear;
-    float rightGain = std::sin(panRadians) * gainLinear;
-
-    // Apply gain and pan to stereo channels
-    int numChannels = buffer.getNumChannels();
-
-    if (numChannels >= 1)
-        buffer.applyGain(0, 0, buffer.getNumSamples(), leftGain);
+    snapGains = false;
 
-    if (numChannels >= 2)
-        buffer.applyGain(1, 0, buffer.getNumSamples(), rightGain);
+    // DJ-style filter and gain in one pass over each channel
+    // -100% = low-pass at 200Hz, 0% = no filtering, +100% = high-pass at 10kHz
+    djFilter.setPosition(filterPercent / 100.0f);
+    djFilter.process(buffer.getArrayOfWritePointers(), numChannels, numSamples, gainRamps.data());
 }
 
 juce::AudioProcessorEditor* GainKnobAudioProcessor::createEditor()
@@ -1,6 +1,19 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/DjFilter.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
+#include <array>
+
+// Parameter values for one block (GAIN in dB, PAN and FILTER in %, PAN_LAW an index)
+struct GainKnobParameters
+{
+    float gain;
+    float pan;
+    float filter;
+    int panLaw;
+};
 
 class GainKnobAudioProcessor : public juce::AudioProcessor
 {
@@ -12,6 +25,8 @@ public:
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
 
@@ -36,11 +51,33 @@ public:
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // Filter state (per-channel)
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> filterProcessor;
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<GainKnobParameters> parameterCache;
+
+    // Mono up to 7.1.4
+    static constexpr int maxChannels = 12;
+
+    // Which pan gain a channel takes: left-side, right-side, or neither (centre, LFE)
+    enum class PanSide { left, centre, right };
+    static PanSide panSideFor(juce::AudioChannelSet::ChannelType type);
+
+    // Pan law gains for the left side over pan -1..+1 (the right side reads it
+    // mirrored), one row per PAN_LAW choice: constant power (-3dB centre), balance (0dB centre)
+    static constexpr int panTableSize = 256;
+    std::array<std::array<float, panTableSize + 1>, 2> panLawTable {};
+    float lookUpPanLaw(int law, float pan) const noexcept;
+
+    // DJ-style filter (per-channel state, smoothed cutoff), with the gain ramps fused in
+    DjFilter djFilter;
+
+    // Per-channel gain (GAIN times the channel's pan gain), ramped over 20ms
+    std::array<juce::SmoothedValue<float>, maxChannels> channelGains;
+    std::array<DjFilter::GainRamp, maxChannels> gainRamps {};
+    std::array<PanSide, maxChannels> channelSides {};
+    bool snapGains = true;
 
-    // Track previous filter type to detect transitions
-    bool previousWasLowPass = false;
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("GainKnob");
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainKnobAudioProcessor)
 };
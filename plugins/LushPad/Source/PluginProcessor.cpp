@@ -30,6 +30,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout LushPadAudioProcessor::creat
         0.4f
     ));
 
+    // reverb_low_rate - Bool (default: false): reverb tank at 44.1/48kHz in 88.2kHz+ sessions
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { "reverb_low_rate", 1 },
+        "Low-Rate Reverb",
+        false
+    ));
+
     return layout;
 }
 
@@ -37,6 +44,10 @@ LushPadAudioProcessor::LushPadAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "timbre", &LushPadParameters::timbre },
+                                   { "filter_cutoff", &LushPadParameters::filterCutoff },
+                                   { "reverb_amount", &LushPadParameters::reverbAmount },
+                                   { "reverb_low_rate", &LushPadParameters::reverbLowRate } })
 {
 }
 
@@ -48,35 +59,33 @@ void LushPadAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
 {
     currentSampleRate = sampleRate;
 
-    // Prepare DSP spec for stereo reverb
-    juce::dsp::ProcessSpec reverbSpec;
-    reverbSpec.sampleRate = sampleRate;
-    reverbSpec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    reverbSpec.numChannels = 2;  // Stereo
-
-    // Prepare and configure reverb
-    reverb.prepare(reverbSpec);
-    reverb.reset();
-
-    juce::dsp::Reverb::Parameters reverbParams;
-    reverbParams.roomSize = 0.9f;     // Large hall
-    reverbParams.damping = 0.4f;      // Moderate high-frequency rolloff
-    reverbParams.wetLevel = 0.4f;     // Default wet level (overridden by parameter)
-    reverbParams.dryLevel = 0.6f;     // Default dry level (overridden by parameter)
-    reverbParams.width = 1.0f;        // Full stereo width
-    reverbParams.freezeMode = 0.0f;   // No freeze
+    // Prepare and configure reverb (allocates its delay lines)
+    reverb.prepare(sampleRate, samplesPerBlock);
+
+    FdnReverb::Parameters reverbParams;
+    reverbParams.size = 0.8f;             // Large hall
+    reverbParams.decaySeconds = 4.5f;     // RT60
+    reverbParams.damping = 0.4f;          // Moderate high-frequency rolloff
+    reverbParams.modulationDepth = 0.5f;  // Slow line modulation for a chorused tail
+    reverbParams.modulationRate = 0.3f;
+    reverbParams.width = 1.0f;            // Full stereo width
     reverb.setParameters(reverbParams);
 
+    reverbBuffer.setSize(2, samplesPerBlock);
+    reverbStage.prepare(sampleRate, samplesPerBlock, 2);
+
     // Prepare DSP spec for mono per-voice filtering
     juce::dsp::ProcessSpec voiceSpec;
     voiceSpec.sampleRate = sampleRate;
     voiceSpec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     voiceSpec.numChannels = 1;  // Mono per-voice
 
-    // Initialize all voices with filter preparation
+    // Initialize all voices with filter preparation. Second-order coefficients up
+    // front, so the filter state is sized here and never on the audio thread.
     for (auto& voice : voices)
     {
         voice.adsr.setSampleRate(sampleRate);
+        voice.filter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 20000.0f, 0.35f);
         voice.filter.prepare(voiceSpec);
         voice.reset();
     }
@@ -87,6 +96,17 @@ void LushPadAudioProcessor::releaseResources()
     // Cleanup will be added in Stage 3 (DSP)
 }
 
+double LushPadAudioProcessor::computeTailSeconds() const
+{
+    // After the last note-off: the voice release, then the reverb ringing down to -90 dB
+    // (plus its reduced-rate filters). Without reverb only the release remains.
+    if (parameterCache.load().reverbAmount <= 0.0f)
+        return voiceReleaseSeconds;
+
+    return voiceReleaseSeconds + SilenceDetector::reverbTailSeconds(reverb.getParameters().decaySeconds)
+         + reverb.getLatencySamples() / currentSampleRate;
+}
+
 void LushPadAudioProcessor::updateVoiceLFOs(SynthVoice& voice)
 {
     // Update tertiary LFOs first (indices 6-8) - slowest layer, modulate primary depths
@@ -153,6 +173,7 @@ void LushPadAudioProcessor::updateVoiceLFOs(SynthVoice& voice)
 void LushPadAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("LushPad", "processBlock");
 
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -177,10 +198,11 @@ void LushPadAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         }
     }
 
-    // Read parameters (atomic, done once per buffer for efficiency)
-    float timbreValue = parameters.getRawParameterValue("timbre")->load();
-    float filterCutoffValue = parameters.getRawParameterValue("filter_cutoff")->load();
-    float reverbAmountValue = parameters.getRawParameterValue("reverb_amount")->load();
+    // Read parameters (one atomic snapshot per buffer)
+    const auto params = parameterCache.load();
+    float timbreValue = params.timbre;
+    float filterCutoffValue = params.filterCutoff;
+    float reverbAmountValue = params.reverbAmount;
 
     // Generate audio per-sample
     const int numSamples = buffer.getNumSamples();
@@ -254,13 +276,17 @@ void LushPadAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
             // Clamp to valid range
             velocityScaledCutoff = juce::jlimit(20.0f, 20000.0f, velocityScaledCutoff);
 
-            // Update filter coefficients (12dB/octave low-pass, Q=0.35)
-            auto coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                currentSampleRate,
-                velocityScaledCutoff,
-                0.35f  // Fixed resonance
-            );
-            *voice.filter.coefficients = *coefficients;
+            // Update filter coefficients in place when the cutoff moves (12dB/octave
+            // low-pass, Q=0.35; no allocation)
+            if (velocityScaledCutoff != voice.filterCutoff)
+            {
+                *voice.filter.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
+                    currentSampleRate,
+                    velocityScaledCutoff,
+                    0.35f  // Fixed resonance
+                );
+                voice.filterCutoff = velocityScaledCutoff;
+            }
 
             // Process through filter
             voiceOutput = voice.filter.processSample(voiceOutput);
@@ -309,20 +335,44 @@ void LushPadAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     }
 
     // Apply global reverb with reverb_amount parameter controlling wet/dry
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-
-    // Update reverb wet/dry levels based on parameter
-    juce::dsp::Reverb::Parameters reverbParams;
-    reverbParams.roomSize = 0.9f;
-    reverbParams.damping = 0.4f;
-    reverbParams.wetLevel = reverbAmountValue;
-    reverbParams.dryLevel = 1.0f - reverbAmountValue;
-    reverbParams.width = 1.0f;
-    reverbParams.freezeMode = 0.0f;
-    reverb.setParameters(reverbParams);
-
-    reverb.process(context);
+    // (dry gain x2 as in juce::Reverb, which this replaced, to keep the mix level).
+    // The reduced-rate filters delay the wet by at most 90 samples: a synth has no
+    // input to align with, so it is left as pre-delay.
+    reverb.setRate(params.reverbLowRate ? FdnReverb::reducedRateFor(currentSampleRate) : FdnReverb::Rate::full);
+
+    const int numReverbChannels = juce::jmin(totalNumOutputChannels, reverbBuffer.getNumChannels());
+    const int reverbBlockSize = reverbBuffer.getNumSamples();
+
+    // With the x2 applied first, the reverb stage is y -> (1 - a) y + a/2 reverb(y), which
+    // is the same mix and passes y unchanged at reverb_amount 0, so it can stop there
+    for (int channel = 0; channel < numReverbChannels; ++channel)
+        buffer.applyGain(channel, 0, numSamples, 2.0f);
+
+    reverbStage.setActive(reverbAmountValue > 0.0f);
+
+    reverbStage.process(buffer.getArrayOfWritePointers(), numReverbChannels, numSamples,
+                        [&] {
+                            PFS_TRACE_SCOPE("LushPad", "reverb");
+
+                            for (int offset = 0; offset < numSamples; offset += reverbBlockSize)
+                            {
+                                const int chunk = juce::jmin(reverbBlockSize, numSamples - offset);
+
+                                for (int channel = 0; channel < numReverbChannels; ++channel)
+                                    reverbBuffer.copyFrom(channel, 0, buffer, channel, offset, chunk);
+
+                                reverb.process(reverbBuffer.getWritePointer(0),
+                                               numReverbChannels > 1 ? reverbBuffer.getWritePointer(1) : nullptr,
+                                               chunk);
+
+                                for (int channel = 0; channel < numReverbChannels; ++channel)
+                                {
+                                    buffer.applyGain(channel, offset, chunk, 1.0f - reverbAmountValue);
+                                    buffer.addFrom(channel, offset, reverbBuffer, channel, 0, chunk, 0.5f * reverbAmountValue);
+                                }
+                            }
+                        },
+                        [&] { reverb.reset(); });
 }
 
 juce::AudioProcessorEditor* LushPadAudioProcessor::createEditor()
@@ -422,7 +472,7 @@ void LushPadAudioProcessor::startVoice(SynthVoice& voice, int note, float veloci
     voice.adsrParams.attack = 0.3f;   // 300ms attack
     voice.adsrParams.decay = 0.2f;    // 200ms decay
     voice.adsrParams.sustain = 0.8f;  // 80% sustain level
-    voice.adsrParams.release = 2.0f;  // 2000ms release
+    voice.adsrParams.release = voiceReleaseSeconds;
 
     voice.adsr.setParameters(voice.adsrParams);
     voice.adsr.noteOn();
@@ -1,6 +1,20 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/FdnReverb.h"
+#include "dsp/SilenceDetector.h"
+#include "dsp/StageBypass.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
+
+// Parameter values for one block (timbre and reverb amount 0-1, cutoff in Hz)
+struct LushPadParameters
+{
+    float timbre;
+    float filterCutoff;
+    float reverbAmount;
+    bool reverbLowRate;
+};
 
 class LushPadAudioProcessor : public juce::AudioProcessor
 {
@@ -19,7 +33,7 @@ public:
     bool acceptsMidi() const override { return true; }  // Synth accepts MIDI
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return computeTailSeconds(); }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -36,6 +50,9 @@ private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<LushPadParameters> parameterCache;
+
     // Voice structure for polyphonic synthesis
     struct SynthVoice
     {
@@ -56,6 +73,7 @@ private:
 
         // Low-pass filter per voice
         juce::dsp::IIR::Filter<float> filter;
+        float filterCutoff = 0.0f;  // Cutoff of the current coefficients (0 = not set)
 
         // Random LFO system (9 per voice)
         // Indices 0-2: Primary LFOs (panning, FM depth, saturation)
@@ -78,6 +96,7 @@ private:
             phase1 = phase2 = phase3 = 0.0f;
             previousOutput1 = previousOutput2 = previousOutput3 = 0.0f;
             filter.reset();
+            filterCutoff = 0.0f;
             adsr.reset();
 
             // Reset LFOs
@@ -92,12 +111,16 @@ private:
 
     // Voice management
     static constexpr int maxVoices = 8;
+    static constexpr float voiceReleaseSeconds = 2.0f;  // ADSR release (linear, so silent after it)
     SynthVoice voices[maxVoices];
     uint64_t voiceCounter = 0;  // Incrementing timestamp for oldest-note-stealing
     double currentSampleRate = 44100.0;
 
-    // Global reverb
-    juce::dsp::Reverb reverb;
+    // Global reverb (wet signal rendered into reverbBuffer, mixed by reverb_amount)
+    FdnReverb reverb;
+    juce::AudioBuffer<float> reverbBuffer;
+    StageBypass reverbStage;  // Stops at reverb_amount 0, fades back in from an empty tank
+    double computeTailSeconds() const;
 
     // Random number generator (for LFO frequency randomization)
     juce::Random random;
@@ -110,5 +133,8 @@ private:
     // LFO update (nested modulation)
     void updateVoiceLFOs(SynthVoice& voice);
 
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("LushPad");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LushPadAudioProcessor)
 };
@@ -0,0 +1,197 @@
+#include "KickVoice.h"
+
+namespace
+{
+    // sin(2*pi*phase) for phase in [0, 1), branch-free: folded to a quarter wave around
+    // 0 and evaluated as an 11th-order odd polynomial (Taylor on [-pi/2, pi/2], max error ~1e-6)
+    inline float polySine(float phase)
+    {
+        const float r = phase - 0.5f;  // sin(2*pi*phase) = -sin(2*pi*r), r in [-0.5, 0.5)
+        const float magnitude = std::abs(r);
+        const float x = juce::jmin(magnitude, 0.5f - magnitude) * juce::MathConstants<float>::twoPi;
+        const float x2 = x * x;
+        const float s = x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f
+                            + x2 * (1.0f / 362880.0f + x2 * (-1.0f / 39916800.0f))))));
+        return std::copysign(s, -r);
+    }
+
+    // 2^x for x in [0, 2] (sweep is at most 24 semitones), branch-free: (2^(x/2))^2 with a
+    // 7th-order polynomial for the half (~3e-6 relative, 0.005 cents)
+    inline float exp2Octaves(float x)
+    {
+        const float f = x * (0.5f * juce::MathConstants<float>::ln2);
+        const float half = 1.0f + f * (1.0f + f * (1.0f / 2.0f + f * (1.0f / 6.0f + f * (1.0f / 24.0f
+                               + f * (1.0f / 120.0f + f * (1.0f / 720.0f + f * (1.0f / 5040.0f)))))));
+        return half * half;
+    }
+}
+
+void KickVoice::prepare(double newSampleRate, int)
+{
+    sampleRate = newSampleRate;
+
+    // Force coefficient recalculation for the new rate
+    lastPitchDecayMs = -1.0f;
+    reset();
+}
+
+void KickVoice::reset()
+{
+    phase = 0.0;
+    position = 0;
+    samplesRemaining = 0;
+}
+
+int KickVoice::getHitLengthSamples(const KickSettings& settings, double sampleRate)
+{
+    // Sustain is fixed at 0, so the hit is silent after attack + decay
+    return static_cast<int>(std::ceil((settings.attackMs + settings.decayMs) / 1000.0 * sampleRate)) + 1;
+}
+
+void KickVoice::updateCoefficients(const KickSettings& settings)
+{
+    if (settings.pitchDecayMs != lastPitchDecayMs)
+    {
+        // Envelope reaches 0.1% of its initial value after the "time" parameter:
+        // per-sample multiplier = exp(-log(1000) / (decaySeconds * sampleRate))
+        const double pitchDecaySeconds = settings.pitchDecayMs / 1000.0;
+        const double multiplier = std::exp(std::log(0.001) / (pitchDecaySeconds * sampleRate));
+
+        for (int i = 0; i <= chunkSize; ++i)
+            pitchDecayPowers[i] = static_cast<float>(std::pow(multiplier, i));
+
+        lastPitchDecayMs = settings.pitchDecayMs;
+    }
+
+    if (settings.sweepSemitones != lastSweepSemitones)
+    {
+        sweepOctaves = settings.sweepSemitones / 12.0f;
+        lastSweepSemitones = settings.sweepSemitones;
+    }
+
+    if (settings.drivePercent != lastDrivePercent)
+    {
+        float driveNormalized = settings.drivePercent / 100.0f;  // 0.0 to 1.0
+        driveGain = 1.0f + (driveNormalized * 9.0f);             // 1.0 to 10.0
+        lastDrivePercent = settings.drivePercent;
+    }
+}
+
+float KickVoice::getAmplitude(int samplesSinceStart) const noexcept
+{
+    const auto t = static_cast<float>(samplesSinceStart);
+
+    if (samplesSinceStart <= attackEnd)
+        return juce::jmin(1.0f, attackStartLevel + (t + 1.0f) * attackStep);
+
+    return juce::jmax(0.0f, 1.0f - (t - static_cast<float>(attackEnd)) * decayStep);
+}
+
+void KickVoice::start(int midiNoteNumber, const KickSettings& settings)
+{
+    // A retriggered hit attacks from where the last one was (no click from a jump to 0)
+    const float currentLevel = isActive() && position > 0 ? getAmplitude(position - 1) : 0.0f;
+
+    // Convert note to per-sample phase increment
+    baseIncrement = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber) / sampleRate;
+
+    // Reset oscillator phase for consistent attack
+    phase = 0.0;
+
+    // Reset pitch envelope
+    pitchEnvelopeValue = 1.0;
+
+    // Amplitude envelope: linear attack to 1, linear decay to 0 (sustain fixed at 0)
+    const double attackSamples = settings.attackMs / 1000.0 * sampleRate;
+    const double decaySamples = settings.decayMs / 1000.0 * sampleRate;
+    decayStep = decaySamples > 0.0 ? static_cast<float>(1.0 / decaySamples) : 1.0f;
+
+    if (attackSamples > 0.0)
+    {
+        attackStep = static_cast<float>(1.0 / attackSamples);
+        attackStartLevel = currentLevel;
+        attackEnd = juce::jmax(0, static_cast<int>(std::ceil((1.0f - currentLevel) / attackStep)) - 1);
+    }
+    else
+    {
+        attackStep = 0.0f;
+        attackStartLevel = 1.0f;
+        attackEnd = -1;
+    }
+
+    position = 0;
+    samplesRemaining = getHitLengthSamples(settings, sampleRate);
+}
+
+int KickVoice::renderBlock(float* dest, int numSamples, const KickSettings& settings)
+{
+    updateCoefficients(settings);
+
+    const int numToRender = juce::jmin(numSamples, samplesRemaining);
+
+    // Locals keep the loop state in registers
+    double currentPhase = phase;
+    double pitchValue = pitchEnvelopeValue;
+    const float octaves = sweepOctaves;
+    const auto increment = static_cast<float>(baseIncrement);
+    const float gain = driveGain;
+    const float startLevel = attackStartLevel;
+    const float upStep = attackStep;
+    const float downStep = decayStep;
+    const auto attackLast = static_cast<float>(attackEnd);
+
+    // Stack scratch, so the render thread can ask for a whole hit in one call
+    float increments[chunkSize];
+    float phases[chunkSize];
+
+    for (int offset = 0; offset < numToRender; offset += chunkSize)
+    {
+        const int n = juce::jmin(chunkSize, numToRender - offset);
+        const auto pitchStart = static_cast<float>(pitchValue);
+        const auto chunkStart = static_cast<float>(position + offset);
+
+        // Pitch-modulated phase increments: f = f0 * 2^(envelope * sweep)
+        for (int i = 0; i < n; ++i)
+            increments[i] = increment * exp2Octaves(pitchStart * pitchDecayPowers[i] * octaves);
+
+        // The running phase is the only loop-carried state
+        for (int i = 0; i < n; ++i)
+        {
+            phases[i] = static_cast<float>(currentPhase);
+            currentPhase += increments[i];
+        }
+
+        currentPhase -= std::floor(currentPhase);
+
+        // Below ~1e-6 the sweep is inaudible: stop before the powers go denormal
+        pitchValue *= pitchDecayPowers[n];
+
+        if (pitchValue < 1.0e-6)
+            pitchValue = 0.0;
+
+        // Sine body and amplitude envelope, driven and clamped to the range the tanh
+        // approximation is accurate in. The ramp still rising is the smaller one, so
+        // min() picks attack or decay without a branch.
+        for (int i = 0; i < n; ++i)
+        {
+            const float t = chunkStart + static_cast<float>(i);
+            const float attack = juce::jmin(1.0f, startLevel + (t + 1.0f) * upStep);
+            const float decay = juce::jmax(0.0f, 1.0f - (t - attackLast) * downStep);
+            const float p = phases[i] - static_cast<float>(static_cast<int>(phases[i]));
+
+            dest[offset + i] = juce::jlimit(-5.0f, 5.0f, gain * polySine(p) * juce::jmin(attack, decay));
+        }
+
+        // tanh drive (rational approximation). A loop of its own: GCC will not
+        // vectorise the clamp and the division together.
+        for (int i = 0; i < n; ++i)
+            dest[offset + i] = juce::dsp::FastMathApproximations::tanh(dest[offset + i]);
+    }
+
+    phase = currentPhase;
+    pitchEnvelopeValue = pitchValue;
+    position += numToRender;
+    samplesRemaining -= numToRender;
+
+    return numToRender;
+}
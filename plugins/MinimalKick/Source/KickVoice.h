@@ -0,0 +1,76 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+// Parameter snapshot that fully determines a kick hit (for a given MIDI note)
+struct KickSettings
+{
+    float attackMs = 5.0f;
+    float decayMs = 400.0f;
+    float sweepSemitones = 12.0f;
+    float pitchDecayMs = 50.0f;
+    float drivePercent = 20.0f;
+};
+
+// Single kick voice: sine body + exponential pitch envelope + AD envelope + tanh drive.
+// Used both for live synthesis and for pre-rendering hits into the render cache.
+//
+// Kick core: rendered in chunks of chunkSize samples. The pitch envelope comes from a
+// table of per-sample decay powers, the amplitude envelope is a closed-form linear
+// attack/decay ramp (as juce::ADSR with zero sustain), and both run with the sine and
+// drive as straight-line loops the compiler vectorises. Only the phase accumulator
+// (double precision) is a running sum.
+class KickVoice
+{
+public:
+    void prepare(double sampleRate, int samplesPerBlock);
+    void reset();
+
+    void start(int midiNoteNumber, const KickSettings& settings);
+
+    // Renders up to numSamples into dest (overwriting); returns the number rendered.
+    // Fewer than numSamples means the hit finished inside this block.
+    int renderBlock(float* dest, int numSamples, const KickSettings& settings);
+
+    // False once attack + decay have fully elapsed (the rest of the hit is silence)
+    bool isActive() const { return samplesRemaining > 0; }
+
+    // Length of a full hit in samples (attack + decay)
+    static int getHitLengthSamples(const KickSettings& settings, double sampleRate);
+
+private:
+    static constexpr int chunkSize = 128;
+
+    void updateCoefficients(const KickSettings& settings);
+    float getAmplitude(int position) const noexcept;
+
+    double sampleRate { 44100.0 };
+
+    // Oscillator: phase in cycles [0, 1), base increment = note frequency / sample rate
+    double phase { 0.0 };
+    double baseIncrement { 0.0 };
+
+    // Pitch envelope: normalized value decays 1.0 -> 0.0, pitchDecayPowers[i] = multiplier^i
+    double pitchEnvelopeValue { 0.0 };
+    float pitchDecayPowers[chunkSize + 1] {};
+    float sweepOctaves { 0.0f };
+
+    // Amplitude envelope, by samples since start(): a linear attack from attackStartLevel
+    // (the level a retriggered hit was at) reaching 1 on sample attackEnd, then a linear
+    // decay to 0. attackEnd is -1 without an attack.
+    float attackStartLevel { 0.0f };
+    float attackStep { 0.0f };
+    float decayStep { 0.0f };
+    int attackEnd { -1 };
+    int position { 0 };
+
+    // Drive (tanh waveshaping) input gain
+    float driveGain { 1.0f };
+
+    // Settings the coefficients above were computed for
+    float lastPitchDecayMs { -1.0f };
+    float lastSweepSemitones { -1.0f };
+    float lastDrivePercent { -1.0f };
+
+    int samplesRemaining { 0 };
+};
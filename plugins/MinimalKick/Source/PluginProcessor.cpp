@@ -57,56 +57,86 @@ MinimalKickAudioProcessor::MinimalKickAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "attack", &KickSettings::attackMs },
+                                   { "decay", &KickSettings::decayMs },
+                                   { "sweep", &KickSettings::sweepSemitones },
+                                   { "time", &KickSettings::pitchDecayMs },
+                                   { "drive", &KickSettings::drivePercent } })
 {
-    // Initialize oscillator with sine wave
-    oscillator.initialise([](float x) { return std::sin(x); }, 128);
 }
 
 MinimalKickAudioProcessor::~MinimalKickAudioProcessor()
 {
+    renderCacheThread.stopThread(1000);
+}
+
+KickSettings MinimalKickAudioProcessor::readKickSettings() const
+{
+    // Read parameters (atomic, real-time safe)
+    return parameterCache.load();
+}
+
+int MinimalKickAudioProcessor::renderCachedHit(int midiNoteNumber, float* dest, int maxSamples)
+{
+    // Runs on the render cache thread with its own voice
+    const auto settings = readKickSettings();
+    const int length = KickVoice::getHitLengthSamples(settings, sampleRate);
+
+    if (length > maxSamples)
+        return -1;
+
+    renderVoice.start(midiNoteNumber, settings);
+    return renderVoice.renderBlock(dest, length, settings);
 }
 
 void MinimalKickAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     this->sampleRate = sampleRate;
 
-    // Prepare oscillator
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
+    // Prepare voice
+    voice.prepare(sampleRate, samplesPerBlock);
 
-    oscillator.prepare(spec);
-    oscillator.reset();
+    // Prepare render cache (longest hit: 50ms attack + 2000ms decay)
+    renderCacheThread.removeTimeSliceClient(&renderCache);
+    cachedHit.stop();
+    renderVoice.prepare(sampleRate, samplesPerBlock);
+    renderCache.prepare(sampleRate, 2.1);
+    renderCacheThread.addTimeSliceClient(&renderCache);
 
-    // Reset envelope
-    envelope.reset();
+    if (!renderCacheThread.isThreadRunning())
+        renderCacheThread.startThread(juce::Thread::Priority::low);
 }
 
 void MinimalKickAudioProcessor::releaseResources()
 {
-    // No buffers to release (oscillator and envelope are self-managing)
+    renderCacheThread.removeTimeSliceClient(&renderCache);
+    cachedHit.stop();
+    renderCache.releaseStorage();
+}
+
+double MinimalKickAudioProcessor::getTailLengthSeconds() const
+{
+    // Every hit plays its full attack + decay: note-off does not shorten it
+    const auto settings = readKickSettings();
+    return (settings.attackMs + settings.decayMs) / 1000.0;
 }
 
 void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("MinimalKick", "processBlock");
 
     // Clear buffer (instrument starts with silence)
     buffer.clear();
 
-    // Read parameters (atomic, real-time safe)
-    auto* attackParam = parameters.getRawParameterValue("attack");
-    auto* decayParam = parameters.getRawParameterValue("decay");
-    auto* sweepParam = parameters.getRawParameterValue("sweep");
-    auto* timeParam = parameters.getRawParameterValue("time");
-    auto* driveParam = parameters.getRawParameterValue("drive");
-
-    float attackMs = attackParam->load();
-    float decayMs = decayParam->load();
-    float sweepSemitones = sweepParam->load();
-    float pitchDecayMs = timeParam->load();
-    float drivePercent = driveParam->load();
+    const auto settings = readKickSettings();
+    const int numSamples = buffer.getNumSamples();
+
+    // Any change to the sound invalidates cached hits until the knobs settle
+    renderCache.setParameterHash(OneShotRenderCache::hashValues({ settings.attackMs, settings.decayMs,
+                                                                  settings.sweepSemitones, settings.pitchDecayMs,
+                                                                  settings.drivePercent }),
+                                 numSamples);
 
     // Process MIDI messages
     for (const auto metadata : midiMessages)
@@ -115,26 +145,16 @@ void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
 
         if (message.isNoteOn())
         {
-            // Store note and convert to frequency
             currentNote = message.getNoteNumber();
-            currentFrequency = juce::MidiMessage::getMidiNoteInHertz(currentNote);
 
-            // Reset oscillator phase for consistent attack
-            oscillator.reset();
+            // Play the pre-rendered hit if it's valid, otherwise synthesise live
+            cachedHit.stop();
+            cachedHit = renderCache.start(currentNote);
 
-            // Reset pitch envelope
-            pitchEnvelopeValue = 1.0f;
-            pitchEnvelopeSampleCount = 0;
-
-            // Configure and trigger amplitude envelope
-            juce::ADSR::Parameters envParams;
-            envParams.attack = attackMs / 1000.0f;     // Convert ms to seconds
-            envParams.decay = decayMs / 1000.0f;       // Convert ms to seconds
-            envParams.sustain = 0.0f;                   // Fixed for kick drums
-            envParams.release = 0.0f;                   // Not needed (sustain=0)
-
-            envelope.setParameters(envParams);
-            envelope.noteOn();
+            if (cachedHit.isActive())
+                voice.reset();
+            else
+                voice.start(currentNote, settings);
 
             isNoteOn = true;
         }
@@ -145,54 +165,25 @@ void MinimalKickAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
         }
     }
 
-    // Generate audio if envelope is active
-    const int numSamples = buffer.getNumSamples();
+    // Generate audio (mono, then copied to the other channels)
+    if (buffer.getNumChannels() == 0 || (!cachedHit.isActive() && !voice.isActive()))
+        return;
 
-    if (envelope.isActive())
+    auto* output = buffer.getWritePointer(0);
+
+    if (cachedHit.isActive())
     {
-        // Calculate pitch envelope decay rate
-        // Formula: decayRate = -log(0.001) / decayTimeSeconds
-        // This makes the envelope decay to 0.1% of initial value in the specified time
-        float pitchDecaySeconds = pitchDecayMs / 1000.0f;
-        float pitchDecayRate = -std::log(0.001f) / pitchDecaySeconds;
-
-        // Process mono (oscillator generates single channel)
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Update pitch envelope (exponential decay)
-            float elapsedSeconds = pitchEnvelopeSampleCount / static_cast<float>(sampleRate);
-            pitchEnvelopeValue = std::exp(-pitchDecayRate * elapsedSeconds);
-            pitchEnvelopeSampleCount++;
-
-            // Calculate modulated frequency
-            // Formula: freq = baseFreq * pow(2.0, envelopeValue * sweepSemitones / 12.0)
-            // This converts semitone offset to frequency multiplier
-            float pitchOffsetSemitones = pitchEnvelopeValue * sweepSemitones;
-            float frequencyMultiplier = std::pow(2.0f, pitchOffsetSemitones / 12.0f);
-            float modulatedFrequency = currentFrequency * frequencyMultiplier;
-
-            // Set oscillator frequency (juce::dsp::Oscillator handles phase continuity)
-            oscillator.setFrequency(modulatedFrequency);
-
-            // Generate sine wave sample
-            float oscillatorSample = oscillator.processSample(0.0f);
-
-            // Apply amplitude envelope
-            float envelopeValue = envelope.getNextSample();
-            float envelopedSample = oscillatorSample * envelopeValue;
-
-            // Apply saturation/drive (tanh waveshaping)
-            float driveNormalized = drivePercent / 100.0f;  // 0.0 to 1.0
-            float gain = 1.0f + (driveNormalized * 9.0f);   // 1.0 to 10.0
-            float outputSample = std::tanh(gain * envelopedSample);
-
-            // Write to both channels (mono to stereo)
-            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-            {
-                buffer.setSample(channel, sample, outputSample);
-            }
-        }
+        for (int sample = 0; sample < numSamples && cachedHit.isActive(); ++sample)
+            output[sample] = cachedHit.nextSample();
     }
+    else
+    {
+        voice.renderBlock(output, numSamples, settings);
+    }
+
+    // Write to both channels (mono to stereo)
+    for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
+        buffer.copyFrom(channel, 0, buffer, 0, 0, numSamples);
 }
 
 juce::AudioProcessorEditor* MinimalKickAudioProcessor::createEditor()
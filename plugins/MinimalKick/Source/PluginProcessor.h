@@ -1,6 +1,10 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "KickVoice.h"
+#include "dsp/OneShotRenderCache.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
 
 class MinimalKickAudioProcessor : public juce::AudioProcessor
 {
@@ -19,7 +23,7 @@ public:
     bool acceptsMidi() const override { return true; }  // Instrument - accepts MIDI
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override;
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -33,22 +37,35 @@ public:
     // Public access for UI parameter binding
     juce::AudioProcessorValueTreeState parameters;
 
+    // Pre-rendered hits are played back while parameters are settled (on by default)
+    void setRenderCacheEnabled(bool shouldBeEnabled) { renderCache.setEnabled(shouldBeEnabled); }
+
 private:
+    KickSettings readKickSettings() const;
+    int renderCachedHit(int midiNoteNumber, float* dest, int maxSamples);
+
     // DSP Components (declared BEFORE parameters for initialization order)
-    juce::dsp::Oscillator<float> oscillator;
-    juce::ADSR envelope;
+    KickVoice voice;
+
+    // Render cache: background thread pre-renders hits for recently played notes
+    KickVoice renderVoice;  // Render thread only
+    OneShotRenderCache renderCache { 2, [this](int note, float* dest, int maxSamples)
+                                        { return renderCachedHit(note, dest, maxSamples); } };
+    OneShotRenderCache::Playback cachedHit;
+    juce::TimeSliceThread renderCacheThread { "MinimalKick render cache" };
 
     // Voice state
     bool isNoteOn { false };
     int currentNote { 60 };  // C4 default
-    float currentFrequency { 0.0f };
     double sampleRate { 44100.0 };
 
-    // Pitch envelope state
-    float pitchEnvelopeValue { 0.0f };  // Normalized 0.0 to 1.0 (decays from 1.0 to 0.0)
-    int pitchEnvelopeSampleCount { 0 };
-
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; the settings are read without string lookups
+    ParameterCache<KickSettings> parameterCache;
+
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("MinimalKick");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MinimalKickAudioProcessor)
 };
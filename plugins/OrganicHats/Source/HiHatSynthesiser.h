@@ -0,0 +1,73 @@
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "HiHatVoice.h"
+
+// Synthesiser with choke-group handling in the voice-dispatch path.
+//
+// juce::Synthesiser calls noteOn() at the sample position of each MIDI event,
+// so choking here is sample-accurate. Open-hat voices register themselves while
+// they sound, so a closed hat only touches voices that are actually open.
+class HiHatSynthesiser : public juce::Synthesiser
+{
+public:
+    static constexpr int maxVoices = 16;
+    static constexpr int closedHatNote = 36;  // C1
+
+    HiHatSynthesiser()
+    {
+        // Split rendering at every MIDI event so chokes land on the exact sample
+        setMinimumRenderingSubdivisionSize(1);
+    }
+
+    void noteOn(int midiChannel, int midiNoteNumber, float velocity) override
+    {
+        // Closed hi-hat chokes all open hi-hats (Phase 4.3)
+        if (midiNoteNumber == closedHatNote)
+        {
+            const juce::ScopedLock sl(lock);
+
+            for (int i = 0; i < numOpenVoices; ++i)
+                openVoices[static_cast<size_t>(i)]->forceRelease();
+
+            numOpenVoices = 0;
+        }
+
+        juce::Synthesiser::noteOn(midiChannel, midiNoteNumber, velocity);
+    }
+
+    // False once every voice has finished its envelope
+    bool isAnyVoiceActive() const noexcept
+    {
+        for (auto* voice : voices)
+            if (voice->isVoiceActive())
+                return true;
+
+        return false;
+    }
+
+    // Called by HiHatVoice when an open hat starts / stops sounding
+    void openHatStarted(HiHatVoice* voice) noexcept
+    {
+        jassert(numOpenVoices < maxVoices);
+
+        if (numOpenVoices < maxVoices)
+            openVoices[static_cast<size_t>(numOpenVoices++)] = voice;
+    }
+
+    void openHatEnded(HiHatVoice* voice) noexcept
+    {
+        for (int i = 0; i < numOpenVoices; ++i)
+        {
+            if (openVoices[static_cast<size_t>(i)] == voice)
+            {
+                // Order doesn't matter: swap with last
+                openVoices[static_cast<size_t>(i)] = openVoices[static_cast<size_t>(--numOpenVoices)];
+                return;
+            }
+        }
+    }
+
+private:
+    std::array<HiHatVoice*, maxVoices> openVoices {};
+    int numOpenVoices = 0;
+};
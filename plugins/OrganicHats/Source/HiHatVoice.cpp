@@ -1,7 +1,9 @@
 #include "HiHatVoice.h"
+#include "HiHatSynthesiser.h"
 
-HiHatVoice::HiHatVoice(juce::AudioProcessorValueTreeState& apvts)
-    : parameters(apvts)
+HiHatVoice::HiHatVoice(const ParameterCache<OrganicHatsParameters>& parameterCache, HiHatSynthesiser& owner)
+    : parameters(parameterCache)
+    , synth(owner)
 {
 }
 
@@ -9,28 +11,30 @@ void HiHatVoice::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
 
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = 1;  // Per-voice mono processing
+    renderBuffer.assign(static_cast<size_t>(juce::jmax(1, samplesPerBlock)), 0.0f);
 
-    toneFilter.prepare(spec);
-    noiseColorFilter.prepare(spec);
-    toneFilter.reset();
-    noiseColorFilter.reset();
+    // Tone/color stages start neutral until the first note sets them
+    lastToneValue = -1.0f;
+    lastColorValue = -1.0f;
+    filterCascade.setStageEnabled(toneStage, false);
+    filterCascade.setStageEnabled(colorStage, false);
+
+    // 20ms ramp, advanced once per block (coefficients are only rebuilt at block rate)
+    smoothedTone.reset(sampleRate, 0.02);
+    smoothedColor.reset(sampleRate, 0.02);
 
     // Initialize resonators (Phase 4.3) - Fixed peaks at 7kHz, 10kHz, 13kHz
     const std::array<float, 3> peakFreqs = {7000.0f, 10000.0f, 13000.0f};
     const float Q = 4.0f;  // Moderate resonance for organic body
     const float gainDB = -6.0f;  // Subtle enhancement
 
-    for (int i = 0; i < 3; ++i)
+    for (size_t i = 0; i < peakFreqs.size(); ++i)
     {
-        resonators[i].prepare(spec);
-        *resonators[i].coefficients = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-            sampleRate, peakFreqs[i], Q, juce::Decibels::decibelsToGain(gainDB));
-        resonators[i].reset();
+        filterCascade.setStage(firstResonatorStage + i, juce::dsp::IIR::ArrayCoefficients<float>::makePeakFilter(
+            sampleRate, peakFreqs[i], Q, juce::Decibels::decibelsToGain(gainDB)));
     }
+
+    filterCascade.reset();
 }
 
 bool HiHatVoice::canPlaySound(juce::SynthesiserSound* sound)
@@ -41,19 +45,31 @@ bool HiHatVoice::canPlaySound(juce::SynthesiserSound* sound)
 void HiHatVoice::startNote(int midiNoteNumber, float velocity,
                            juce::SynthesiserSound*, int)
 {
+    // A restarted voice must not stay in the open-hat set under its old note
+    unregisterOpenHat();
+
     // Determine if this is a closed or open hi-hat
     isClosed = (midiNoteNumber == 36);  // C1 = closed, D1 (38) = open
 
     // Store velocity as linear gain (0.0-1.0)
     velocityGain = velocity;
 
+    // New note: jump straight to the current tone/color (no glide from the previous note)
+    const auto params = parameters.load();
+    smoothedTone.setCurrentAndTargetValue((isClosed ? params.closedTone : params.openTone) / 100.0f);
+    smoothedColor.setCurrentAndTargetValue((isClosed ? params.closedNoiseColor : params.openNoiseColor) / 100.0f);
+
+    // Velocity changed, so cached coefficients are stale
+    lastToneValue = -1.0f;
+    lastColorValue = -1.0f;
+    updateFilterCoefficients(smoothedTone.getCurrentValue(), smoothedColor.getCurrentValue());
+
     // Configure ADSR based on note type
     if (isClosed)
     {
         // Closed hi-hat: Short decay, no sustain
-        // Read CLOSED_DECAY parameter (20-200ms)
-        auto* decayParam = parameters.getRawParameterValue("CLOSED_DECAY");
-        float decayMs = decayParam->load();
+        // CLOSED_DECAY parameter (20-200ms)
+        float decayMs = params.closedDecay;
 
         juce::ADSR::Parameters adsrParams;
         adsrParams.attack = 0.0001f;   // 0.1ms attack
@@ -66,9 +82,8 @@ void HiHatVoice::startNote(int midiNoteNumber, float velocity,
     else
     {
         // Open hi-hat: No decay, full sustain, long release
-        // Read OPEN_RELEASE parameter (100-1000ms)
-        auto* releaseParam = parameters.getRawParameterValue("OPEN_RELEASE");
-        float releaseMs = releaseParam->load();
+        // OPEN_RELEASE parameter (100-1000ms)
+        float releaseMs = params.openRelease;
 
         juce::ADSR::Parameters adsrParams;
         adsrParams.attack = 0.0001f;   // 0.1ms attack
@@ -81,6 +96,13 @@ void HiHatVoice::startNote(int midiNoteNumber, float velocity,
 
     // Trigger envelope
     envelope.noteOn();
+
+    // Open hats stay chokable until their envelope finishes
+    if (!isClosed)
+    {
+        synth.openHatStarted(this);
+        registeredAsOpen = true;
+    }
 }
 
 void HiHatVoice::stopNote(float, bool allowTailOff)
@@ -91,8 +113,8 @@ void HiHatVoice::stopNote(float, bool allowTailOff)
     }
     else
     {
-        // Immediate cutoff
-        clearCurrentNote();
+        // Immediate cutoff (also the voice-stealing path)
+        finishNote();
         envelope.reset();
     }
 }
@@ -101,96 +123,132 @@ void HiHatVoice::forceRelease()
 {
     // Force envelope to release phase with fast release (<5ms)
     // This is called by choke logic when closed hi-hat cuts open hi-hat
+    registeredAsOpen = false;
+
+    auto adsrParams = envelope.getParameters();
+    adsrParams.release = 0.005f;
+    envelope.setParameters(adsrParams);
     envelope.noteOff();
 }
 
-void HiHatVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
-                                 int startSample, int numSamples)
+void HiHatVoice::unregisterOpenHat()
 {
-    if (!isVoiceActive())
-        return;
-
-    // Read parameters once per block (atomic reads)
-    const char* toneParamID = isClosed ? "CLOSED_TONE" : "OPEN_TONE";
-    const char* colorParamID = isClosed ? "CLOSED_NOISE_COLOR" : "OPEN_NOISE_COLOR";
+    if (registeredAsOpen)
+    {
+        synth.openHatEnded(this);
+        registeredAsOpen = false;
+    }
+}
 
-    float toneValue = parameters.getRawParameterValue(toneParamID)->load() / 100.0f;  // Normalize to 0.0-1.0
-    float colorValue = parameters.getRawParameterValue(colorParamID)->load() / 100.0f;
+void HiHatVoice::finishNote()
+{
+    unregisterOpenHat();
+    clearCurrentNote();
+}
 
-    for (int sample = 0; sample < numSamples; ++sample)
+void HiHatVoice::updateFilterCoefficients(float toneValue, float colorValue)
+{
+    // ArrayCoefficients are returned by value and the cascade stores them inline,
+    // so nothing here touches the heap (safe on the audio thread)
+    if (toneValue != lastToneValue)
     {
-        // 1. Generate white noise: range [-1.0, 1.0]
-        float noiseSample = (noiseGenerator.nextFloat() * 2.0f) - 1.0f;
-
-        // 2. Apply Tone Filter (brightness control)
         // Exponential frequency mapping: 3kHz-15kHz
         float velocityToneMod = velocityGain * 0.3f;  // Up to +30% cutoff modulation
         float baseFreq = 3000.0f * std::pow(5.0f, toneValue);
-        float finalCutoff = baseFreq * (1.0f + velocityToneMod);
-        finalCutoff = juce::jlimit(20.0f, 20000.0f, finalCutoff);
+        float finalCutoff = juce::jlimit(20.0f, 20000.0f, baseFreq * (1.0f + velocityToneMod));
 
-        // Update Tone Filter coefficients (LP below 50%, HP above 50%)
+        // LP below 50%, HP above 50%
         if (toneValue < 0.5f)
-        {
-            *toneFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                currentSampleRate, finalCutoff, 0.707f);
-        }
+            filterCascade.setStage(toneStage, juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
+                currentSampleRate, finalCutoff, 0.707f));
         else
-        {
-            *toneFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-                currentSampleRate, finalCutoff, 0.707f);
-        }
+            filterCascade.setStage(toneStage, juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
+                currentSampleRate, finalCutoff, 0.707f));
 
-        // Process through Tone Filter
-        noiseSample = toneFilter.processSample(noiseSample);
+        lastToneValue = toneValue;
+    }
 
-        // 3. Apply Noise Color Filter (warmth control)
+    if (colorValue != lastColorValue)
+    {
         // Bypass zone at 50% ±2%
-        if (std::abs(colorValue - 0.5f) > 0.02f)
+        const bool colorFilterBypassed = std::abs(colorValue - 0.5f) <= 0.02f;
+
+        if (colorFilterBypassed)
+        {
+            filterCascade.setStageEnabled(colorStage, false);
+        }
+        else
         {
             // Exponential frequency mapping: 5kHz-10kHz
             float colorFreq = 5000.0f * std::pow(2.0f, (colorValue - 0.5f) * 2.0f);
             colorFreq = juce::jlimit(20.0f, 20000.0f, colorFreq);
 
-            // Update Noise Color Filter coefficients (LP below 50%, HP above 50%)
+            // LP below 50%, HP above 50%
             if (colorValue < 0.5f)
-            {
-                *noiseColorFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
-                    currentSampleRate, colorFreq, 0.707f);
-            }
+                filterCascade.setStage(colorStage, juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
+                    currentSampleRate, colorFreq, 0.707f));
             else
-            {
-                *noiseColorFilter.coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-                    currentSampleRate, colorFreq, 0.707f);
-            }
-
-            // Process through Noise Color Filter
-            noiseSample = noiseColorFilter.processSample(noiseSample);
+                filterCascade.setStage(colorStage, juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
+                    currentSampleRate, colorFreq, 0.707f));
         }
-        // else: bypass (no filtering at 50%)
 
-        // 4. Apply resonators (Phase 4.3) - Fixed peaks for organic body
-        for (auto& resonator : resonators)
-        {
-            noiseSample = resonator.processSample(noiseSample);
-        }
+        lastColorValue = colorValue;
+    }
+}
 
-        // 5. Apply envelope
-        float envelopeSample = envelope.getNextSample();
+void HiHatVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
+                                 int startSample, int numSamples)
+{
+    if (!isVoiceActive() || renderBuffer.empty())
+        return;
 
-        // 6. Apply velocity scaling
-        float outputSample = noiseSample * envelopeSample * velocityGain;
+    // Read parameters once per block (atomic reads)
+    const auto params = parameters.load();
 
-        // 7. Add to output buffer (don't replace - multiple voices may be active)
-        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+    smoothedTone.setTargetValue((isClosed ? params.closedTone : params.openTone) / 100.0f);  // Normalize to 0.0-1.0
+    smoothedColor.setTargetValue((isClosed ? params.closedNoiseColor : params.openNoiseColor) / 100.0f);
+
+    // Advance the smoothers by the whole block and rebuild coefficients at most once
+    updateFilterCoefficients(smoothedTone.skip(numSamples), smoothedColor.skip(numSamples));
+
+    const int maxChunk = static_cast<int>(renderBuffer.size());
+    float* scratch = renderBuffer.data();
+
+    for (int offset = 0; offset < numSamples; offset += maxChunk)
+    {
+        const int chunkSize = juce::jmin(maxChunk, numSamples - offset);
+
+        // 1. Generate white noise: range [-1.0, 1.0]
+        for (int sample = 0; sample < chunkSize; ++sample)
+            scratch[sample] = (noiseGenerator.nextFloat() * 2.0f) - 1.0f;
+
+        // 2-4. Tone filter, noise color filter (skipped in its 50% bypass zone), resonators
+        filterCascade.process(scratch, chunkSize);
+
+        // 5-6. Apply envelope and velocity scaling
+        int numRendered = chunkSize;
+        bool envelopeFinished = false;
+
+        for (int sample = 0; sample < chunkSize; ++sample)
         {
-            outputBuffer.addSample(channel, startSample + sample, outputSample);
+            scratch[sample] *= envelope.getNextSample() * velocityGain;
+
+            if (!envelope.isActive())
+            {
+                numRendered = sample + 1;
+                envelopeFinished = true;
+                break;
+            }
         }
 
+        // 7. Add to output buffer (don't replace - multiple voices may be active)
+        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+            outputBuffer.addFrom(channel, startSample + offset, scratch, numRendered);
+
         // Stop voice if envelope finished
-        if (!envelope.isActive())
+        if (envelopeFinished)
         {
-            clearCurrentNote();
+            finishNote();
             break;
         }
     }
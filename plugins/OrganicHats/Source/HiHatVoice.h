@@ -2,11 +2,26 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "HiHatSound.h"
+#include "dsp/BiquadCascade.h"
+#include "params/ParameterCache.h"
+
+class HiHatSynthesiser;
+
+// Parameter values for one block (tone and noise color in %, decay and release in ms)
+struct OrganicHatsParameters
+{
+    float closedTone;
+    float closedDecay;
+    float closedNoiseColor;
+    float openTone;
+    float openRelease;
+    float openNoiseColor;
+};
 
 class HiHatVoice : public juce::SynthesiserVoice
 {
 public:
-    HiHatVoice(juce::AudioProcessorValueTreeState& apvts);
+    HiHatVoice(const ParameterCache<OrganicHatsParameters>& parameterCache, HiHatSynthesiser& owner);
 
     bool canPlaySound(juce::SynthesiserSound* sound) override;
 
@@ -24,7 +39,8 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock);
 
 private:
-    juce::AudioProcessorValueTreeState& parameters;
+    const ParameterCache<OrganicHatsParameters>& parameters;
+    HiHatSynthesiser& synth;
 
     // Noise generation
     juce::Random noiseGenerator;
@@ -32,21 +48,36 @@ private:
     // Envelope shaping
     juce::ADSR envelope;
 
-    // Filtering (Phase 4.2)
-    juce::dsp::IIR::Filter<float> toneFilter;
-    juce::dsp::IIR::Filter<float> noiseColorFilter;
+    // Filtering (Phase 4.2) + Resonators (Phase 4.3), run as one block-processed cascade:
+    // stage 0 = tone, stage 1 = noise color, stages 2-4 = fixed peaks for organic body
+    enum FilterStage { toneStage = 0, colorStage, firstResonatorStage, numFilterStages = firstResonatorStage + 3 };
+    BiquadCascade<float, numFilterStages> filterCascade;
 
-    // Resonators (Phase 4.3) - Fixed peaks for organic body
-    std::array<juce::dsp::IIR::Filter<float>, 3> resonators;
+    // Block-rate parameter smoothing (coefficients are rebuilt once per block, never per sample)
+    juce::SmoothedValue<float> smoothedTone;
+    juce::SmoothedValue<float> smoothedColor;
+    float lastToneValue = -1.0f;   // Tone value the current tone stage coefficients were built for
+    float lastColorValue = -1.0f;  // Color value the current color stage coefficients were built for
+
+    void updateFilterCoefficients(float toneValue, float colorValue);
+
+    // Per-voice render scratch (sized in prepareToPlay)
+    std::vector<float> renderBuffer;
 
     double currentSampleRate = 44100.0;
 
     // Voice state
     bool isClosed = true;  // C1 = closed, D1 = open
     float velocityGain = 1.0f;
+    bool registeredAsOpen = false;  // Listed in the synth's open-hat set (chokable)
+
+    void unregisterOpenHat();
+    void finishNote();
 
 public:
     // Choke support methods (Phase 4.3)
     bool isOpen() const { return !isClosed; }
+
+    // Called by HiHatSynthesiser (which has already removed this voice from its open set)
     void forceRelease();
 };
@@ -7,10 +7,16 @@ OrganicHatsAudioProcessor::OrganicHatsAudioProcessor()
     : AudioProcessor(BusesProperties()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "PARAMETERS", createParameterLayout())
+    , parameterCache(parameters, { { "CLOSED_TONE", &OrganicHatsParameters::closedTone },
+                                   { "CLOSED_DECAY", &OrganicHatsParameters::closedDecay },
+                                   { "CLOSED_NOISE_COLOR", &OrganicHatsParameters::closedNoiseColor },
+                                   { "OPEN_TONE", &OrganicHatsParameters::openTone },
+                                   { "OPEN_RELEASE", &OrganicHatsParameters::openRelease },
+                                   { "OPEN_NOISE_COLOR", &OrganicHatsParameters::openNoiseColor } })
 {
     // Add 16 voices for polyphony (8 closed + 8 open typical use)
-    for (int i = 0; i < 16; ++i)
-        synth.addVoice(new HiHatVoice(parameters));
+    for (int i = 0; i < HiHatSynthesiser::maxVoices; ++i)
+        synth.addVoice(new HiHatVoice(parameterCache, synth));
 
     // Add hi-hat sound descriptor
     synth.addSound(new HiHatSound());
@@ -95,38 +101,29 @@ void OrganicHatsAudioProcessor::releaseResources()
     // Cleanup will be added in Stage 4
 }
 
+double OrganicHatsAudioProcessor::getTailLengthSeconds() const
+{
+    // After note-off: a closed hat finishes its decay (plus 5ms release), an open hat releases
+    const auto params = parameterCache.load();
+    const double closedTail = params.closedDecay / 1000.0 + 0.005;
+    const double openTail = params.openRelease / 1000.0;
+
+    return juce::jmax(closedTail, openTail);
+}
+
 void OrganicHatsAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("OrganicHats", "processBlock");
 
     // Clear output buffer before synthesiser adds to it
     buffer.clear();
 
-    // Implement choke logic (Phase 4.3): Closed hi-hat cuts open hi-hat
-    for (const auto metadata : midiMessages)
-    {
-        const auto msg = metadata.getMessage();
-        if (msg.isNoteOn())
-        {
-            int noteNumber = msg.getNoteNumber();
-
-            // If closed hi-hat (C1 = 36), choke all active open hi-hats
-            if (noteNumber == 36)
-            {
-                for (int i = 0; i < synth.getNumVoices(); ++i)
-                {
-                    if (auto* voice = dynamic_cast<HiHatVoice*>(synth.getVoice(i)))
-                    {
-                        if (voice->isOpen() && voice->isVoiceActive())
-                        {
-                            voice->forceRelease();
-                        }
-                    }
-                }
-            }
-        }
-    }
+    // Nothing sounding and nothing to start: the output stays clear
+    if (midiMessages.isEmpty() && !synth.isAnyVoiceActive())
+        return;
 
+    // Choke logic (Phase 4.3) lives in HiHatSynthesiser::noteOn, applied at each note's sample offset
     // Render MIDI-triggered hi-hat voices
     synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 }
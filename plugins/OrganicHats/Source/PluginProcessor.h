@@ -1,5 +1,7 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "HiHatSynthesiser.h"
+#include "trace/Trace.h"
 
 class OrganicHatsAudioProcessor : public juce::AudioProcessor
 {
@@ -18,7 +20,7 @@ public:
     bool acceptsMidi() const override { return true; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override;
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,8 +36,14 @@ public:
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-    // Synthesiser for hi-hat voice management
-    juce::Synthesiser synth;
+    // Parameter IDs resolved once; shared by the voices, read without string lookups
+    ParameterCache<OrganicHatsParameters> parameterCache;
+
+    // Synthesiser for hi-hat voice management (handles closed/open choke)
+    HiHatSynthesiser synth;
+
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("OrganicHats");
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OrganicHatsAudioProcessor)
 };
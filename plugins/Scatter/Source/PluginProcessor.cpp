@@ -93,6 +93,15 @@ ScatterAudioProcessor::ScatterAudioProcessor()
                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "delay_time", &ScatterParameters::delayTime },
+                                   { "grain_size", &ScatterParameters::grainSize },
+                                   { "density", &ScatterParameters::density },
+                                   { "pitch_random", &ScatterParameters::pitchRandom },
+                                   { "scale", &ScatterParameters::scale },
+                                   { "root_note", &ScatterParameters::rootNote },
+                                   { "pan_random", &ScatterParameters::panRandom },
+                                   { "feedback", &ScatterParameters::feedback },
+                                   { "mix", &ScatterParameters::mix } })
 {
     // Phase 3.2: Initialize scale lookup tables
     initializeScaleTables();
@@ -141,41 +150,70 @@ void ScatterAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
         grain.pan = 0.5f;
         grain.reverse = false;
     }
+
+    silenceDetector.prepare(sampleRate);
 }
 
 void ScatterAudioProcessor::releaseResources()
 {
 }
 
+double ScatterAudioProcessor::computeTailSeconds() const
+{
+    // Grains read anywhere in the 2s buffer, so each feedback pass can take the
+    // whole buffer plus one grain. Overlapping Hann grains sum to at most unity gain.
+    const auto params = parameterCache.load();
+    const double grainSeconds = params.grainSize / 1000.0;
+    const double feedbackGain = params.feedback / 100.0 * 0.95;
+
+    return SilenceDetector::feedbackTailSeconds(2.0 + grainSeconds, feedbackGain);
+}
+
 void ScatterAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("Scatter", "processBlock");
     juce::ignoreUnused(midiMessages);
 
     // Clear unused output channels
     for (int i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    // Read parameters (atomic, real-time safe)
-    auto* delayTimeParam = parameters.getRawParameterValue("delay_time");
-    auto* grainSizeParam = parameters.getRawParameterValue("grain_size");
-    auto* densityParam = parameters.getRawParameterValue("density");
-    auto* pitchRandomParam = parameters.getRawParameterValue("pitch_random");
-    auto* scaleParam = parameters.getRawParameterValue("scale");
-    auto* rootNoteParam = parameters.getRawParameterValue("root_note");
-    auto* panRandomParam = parameters.getRawParameterValue("pan_random");
-    auto* feedbackParam = parameters.getRawParameterValue("feedback");
-    auto* mixParam = parameters.getRawParameterValue("mix");
-
-    float delayTimeMs = delayTimeParam->load();
-    float grainSizeMs = grainSizeParam->load();
-    float densityPercent = densityParam->load();
-    float pitchRandomPercent = pitchRandomParam->load();
-    int scaleIndex = static_cast<int>(scaleParam->load());
-    int rootNote = static_cast<int>(rootNoteParam->load());
-    float panRandomPercent = panRandomParam->load();
-    float feedbackGain = feedbackParam->load() / 100.0f * 0.95f;  // Map 0-100% to 0.0-0.95
-    float mixValue = mixParam->load() / 100.0f;  // Map 0-100% to 0.0-1.0
+    // Skip the grain engine once the input has been silent for longer than the tail
+    silenceDetector.setTailSeconds(computeTailSeconds());
+    const auto activity = silenceDetector.update(buffer.getArrayOfReadPointers(),
+                                                 juce::jmin(getTotalNumInputChannels(), buffer.getNumChannels()),
+                                                 buffer.getNumSamples());
+
+    if (activity != SilenceDetector::State::processing)
+    {
+        // Start the next sound from an empty delay buffer (new grains fade in on their window)
+        if (activity == SilenceDetector::State::enteringSleep)
+        {
+            delayBuffer.reset();
+            feedbackBuffer.clear();
+            dryWetMixer.reset();
+
+            for (auto& grain : grainVoices)
+                grain.active = false;
+        }
+
+        buffer.clear();
+        return;
+    }
+
+    // Read parameters (one atomic snapshot, real-time safe)
+    const auto params = parameterCache.load();
+
+    float delayTimeMs = params.delayTime;
+    float grainSizeMs = params.grainSize;
+    float densityPercent = params.density;
+    float pitchRandomPercent = params.pitchRandom;
+    int scaleIndex = params.scale;
+    int rootNote = params.rootNote;
+    float panRandomPercent = params.panRandom;
+    float feedbackGain = params.feedback / 100.0f * 0.95f;  // Map 0-100% to 0.0-0.95
+    float mixValue = params.mix / 100.0f;  // Map 0-100% to 0.0-1.0
 
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
@@ -334,9 +372,6 @@ void ScatterAudioProcessor::spawnNewGrain(float grainSizeMs, float pitchRandomPe
         availableVoice = &grainVoices[0];
     }
 
-    // Get random number generator
-    auto& random = juce::Random::getSystemRandom();
-
     // Phase 3.2: Generate random pitch and quantize to scale
     float randomPitch = (random.nextFloat() * 2.0f - 1.0f) * 7.0f * (pitchRandomPercent / 100.0f);
     int quantizedPitch = quantizePitchToScale(randomPitch, scaleIndex, rootNote);
@@ -371,6 +406,8 @@ void ScatterAudioProcessor::spawnNewGrain(float grainSizeMs, float pitchRandomPe
 
 void ScatterAudioProcessor::updateGrainScheduler(float densityPercent, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote)
 {
+    PFS_TRACE_SCOPE("Scatter", "grain scheduler");
+
     // Grain spawn interval calculation: grainSizeSamples / (density * overlapFactor)
     // At 50% density, grains spawn at ~grainSize intervals (moderate overlap)
     // At 100% density, grains spawn more frequently (dense cloud)
@@ -399,6 +436,8 @@ void ScatterAudioProcessor::updateGrainScheduler(float densityPercent, float gra
 
 void ScatterAudioProcessor::processGrainVoices(juce::AudioBuffer<float>& buffer)
 {
+    PFS_TRACE_SCOPE("Scatter", "grain voices");
+
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
 
@@ -1,9 +1,27 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/SilenceDetector.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
 #include <array>
 #include <vector>
 
+// Parameter values for one block (times in ms, amounts in %; scale and root note are
+// indices)
+struct ScatterParameters
+{
+    float delayTime;
+    float grainSize;
+    float density;
+    float pitchRandom;
+    int scale;
+    int rootNote;
+    float panRandom;
+    float feedback;
+    float mix;
+};
+
 class ScatterAudioProcessor : public juce::AudioProcessor
 {
 public:
@@ -21,7 +39,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return computeTailSeconds(); }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -48,6 +66,9 @@ public:
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<ScatterParameters> parameterCache;
+
     // Phase 3.1: Core Granular Engine Components
 
     // Grain voice structure
@@ -75,6 +96,7 @@ private:
     // Grain scheduler state
     int grainSpawnCounter = 0;         // Sample counter for grain spawning
     int lastGrainSpawnInterval = 0;    // Cached spawn interval
+    juce::Random random;               // Grain pitch, pan and direction (this instance only)
 
     // Window function lookup table (Hann window)
     std::vector<float> hannWindow;
@@ -92,6 +114,10 @@ private:
     juce::dsp::DryWetMixer<float> dryWetMixer;
     juce::AudioBuffer<float> feedbackBuffer;
 
+    // Sleeps once the input has been silent for longer than the tail
+    SilenceDetector silenceDetector;
+    double computeTailSeconds() const;
+
     // Helper methods
     void spawnNewGrain(float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
     void updateGrainScheduler(float densityPercent, float grainSizeMs, float pitchRandomPercent, float panRandomPercent, int scaleIndex, int rootNote);
@@ -100,5 +126,8 @@ private:
     void initializeScaleTables();
     int quantizePitchToScale(float pitchSemitones, int scaleIndex, int rootNote);
 
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("Scatter");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScatterAudioProcessor)
 };
@@ -1,6 +1,22 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    // Wow/flutter depth (v1.1.0): ±25 cents at max age
+    // ±25 cents = 2^(25/1200) = 1.0145 (~1.45% pitch variation, still musical)
+    const float maxPitchVariationCents = 25.0f;
+    const float pitchVariationRatio = std::pow(2.0f, maxPitchVariationCents / 1200.0f) - 1.0f;  // ~0.0145
+    const float flutterDepthRatio = 0.2f;  // Flutter at 20% of wow depth
+
+    // Modulation excursion is scaled by 100ms in both latency modes, so the pitch
+    // variation for a given age is identical; only the delay center moves.
+    const double modulationScaleSeconds = 0.1;
+
+    // Lagrange3rd reads one sample ahead of the integer delay: keep the trough above that
+    const float minimumDelaySamples = 2.0f;
+}
+
 juce::AudioProcessorValueTreeState::ParameterLayout TapeAgeAudioProcessor::createParameterLayout()
 {
     juce::AudioProcessorValueTreeState::ParameterLayout layout;
@@ -21,6 +37,43 @@ juce::AudioProcessorValueTreeState::ParameterLayout TapeAgeAudioProcessor::creat
         0.5f  // Default: 50%
     ));
 
+    // saturation_mode - Saturation algorithm in the 2x oversampled domain
+    // Classic: plain tanh (original behaviour, kept for A/B comparison)
+    // ADAA: first-order antiderivative anti-aliasing (default)
+    // ADAA2: second-order antiderivative anti-aliasing (strongest alias rejection)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "saturation_mode", 1 },
+        "Saturation Mode",
+        juce::StringArray { "Classic", "ADAA", "ADAA2" },
+        1  // Default: ADAA
+    ));
+
+    // tape_model - Nonlinearity in the 2x oversampled domain
+    // Saturation: tanh (see saturation_mode). Hysteresis: Jiles–Atherton magnetic tape model
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "tape_model", 1 },
+        "Tape Model",
+        juce::StringArray { "Saturation", "Hysteresis" },
+        0  // Default: Saturation
+    ));
+
+    // hysteresis_solver - ODE solver for the hysteresis model (cost rises left to right)
+    // RK2/RK4: explicit Runge-Kutta. NR4/NR8: trapezoidal rule, 4/8 Newton-Raphson iterations
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "hysteresis_solver", 1 },
+        "Hysteresis Solver",
+        juce::StringArray { "RK2", "RK4", "NR4", "NR8" },
+        1  // Default: RK4
+    ));
+
+    // low_latency - Center wow/flutter on the smallest delay the full age depth needs
+    // Off: fixed 100ms center (original behaviour). On: about 2ms, for tracking.
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { "low_latency", 1 },
+        "Low Latency",
+        false  // Default: off
+    ));
+
     // age - Tape degradation amount
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID { "age", 1 },
@@ -54,11 +107,51 @@ TapeAgeAudioProcessor::TapeAgeAudioProcessor()
                         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , oversampler(2, 1, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple)  // 2x oversampling, 1 stage, FIR filters
     , parameters(*this, nullptr, "Parameters", createParameterLayout())
+    , parameterCache(parameters, { { "input", &TapeAgeParameters::input },
+                                   { "drive", &TapeAgeParameters::drive },
+                                   { "saturation_mode", &TapeAgeParameters::saturationMode },
+                                   { "tape_model", &TapeAgeParameters::tapeModel },
+                                   { "hysteresis_solver", &TapeAgeParameters::hysteresisSolver },
+                                   { "low_latency", &TapeAgeParameters::lowLatency },
+                                   { "age", &TapeAgeParameters::age },
+                                   { "mix", &TapeAgeParameters::mix },
+                                   { "output", &TapeAgeParameters::output } })
 {
+    startTimerHz(10);  // Latency changes from the audio thread reach the host within 100ms
 }
 
 TapeAgeAudioProcessor::~TapeAgeAudioProcessor()
 {
+    stopTimer();
+}
+
+int TapeAgeAudioProcessor::getTotalLatencySamples(bool lowLatency) const noexcept
+{
+    const double modulationScale = currentSampleRate * modulationScaleSeconds;
+
+    // Peak excursion of wow + flutter around the center at full age, so age moves
+    // never change the latency or push the trough below the minimum
+    const double center = lowLatency
+        ? (1.0 + flutterDepthRatio) * pitchVariationRatio * modulationScale + minimumDelaySamples
+        : modulationScale;
+
+    return static_cast<int>(std::ceil(oversamplerLatency + center));
+}
+
+double TapeAgeAudioProcessor::computeTailSeconds() const
+{
+    // The last input sample leaves after the reported latency, or later while wow and
+    // flutter sit at their deepest past the center. Nothing downstream rings.
+    const double excursionSeconds = (1.0 + flutterDepthRatio) * pitchVariationRatio * modulationScaleSeconds;
+    return pendingLatencySamples.load() / currentSampleRate + excursionSeconds;
+}
+
+void TapeAgeAudioProcessor::timerCallback()
+{
+    const int latency = pendingLatencySamples.load();
+
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
 }
 
 void TapeAgeAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
@@ -73,20 +166,27 @@ void TapeAgeAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
     oversampler.initProcessing(static_cast<size_t>(samplesPerBlock));
     oversampler.reset();
 
+    // ADAA saturators run on the oversampled block
+    const int oversampledBlockSize = samplesPerBlock * static_cast<int>(oversampler.getOversamplingFactor());
+    for (auto& channelSaturator : saturator)
+        channelSaturator.prepare(oversampledBlockSize);
+
+    hysteresis.prepare(sampleRate * static_cast<double>(oversampler.getOversamplingFactor()));
+
     // Phase 4.2: Prepare wow/flutter modulation
     // 200ms delay line buffer for pitch modulation (architecture.md line 28)
     int delaySamples = static_cast<int>(sampleRate * 0.2);
-    delayLine.setMaximumDelayInSamples(delaySamples);
-    delayLine.prepare(currentSpec);
-    delayLine.reset();
+    delayLine.prepare(static_cast<int>(currentSpec.numChannels), delaySamples, samplesPerBlock);
+    delayTrajectory.setSize(static_cast<int>(currentSpec.numChannels), samplesPerBlock);
 
     // Initialize random phase offsets per channel for stereo width
-    lfoPhase[0] = random.nextFloat() * juce::MathConstants<float>::twoPi;
-    lfoPhase[1] = random.nextFloat() * juce::MathConstants<float>::twoPi;
-
-    // v1.1.0: Initialize flutter LFO with different random phase
-    flutterPhase[0] = random.nextFloat() * juce::MathConstants<float>::twoPi;
-    flutterPhase[1] = random.nextFloat() * juce::MathConstants<float>::twoPi;
+    // v1.1.0: Flutter LFO (6Hz) gets its own random phase
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        wowLfo[channel].setPhase(random.nextFloat() * juce::MathConstants<float>::twoPi);
+        flutterLfo[channel].setPhase(random.nextFloat() * juce::MathConstants<float>::twoPi);
+        flutterLfo[channel].setFrequency(6.0, sampleRate);
+    }
 
     // Phase 4.3: Prepare degradation features
     // Initialize dropout state (no dropout at start)
@@ -109,15 +209,23 @@ void TapeAgeAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
         ageFilter[i].coefficients = coefficients;
     }
 
+    ageFilterStage.prepare(sampleRate, samplesPerBlock, 2);
+    ageFilterStage.reset(false);
+
     // Phase 4.4: Prepare dry/wet mixer
     dryWetMixer.prepare(currentSpec);
     dryWetMixer.reset();
 
-    // Set wet latency to compensate for oversampler + delay line latency
-    int oversamplerLatency = static_cast<int>(oversampler.getLatencyInSamples());
-    int delayLineLatency = static_cast<int>(sampleRate * 0.1);  // 100ms base delay from wow/flutter
-    int totalWetLatency = oversamplerLatency + delayLineLatency;
-    dryWetMixer.setWetLatency(static_cast<float>(totalWetLatency));
+    // Latency = oversampler + wow/flutter delay center. The dry path is delayed by the
+    // same amount inside the plugin, and the host compensates for the total.
+    oversamplerLatency = oversampler.getLatencyInSamples();
+    lowLatencyActive = parameterCache.load().lowLatency;
+    currentTotalLatency = getTotalLatencySamples(lowLatencyActive);
+    modulationCenter = static_cast<float>(currentTotalLatency) - oversamplerLatency;
+    dryWetMixer.setWetLatency(static_cast<float>(currentTotalLatency));
+
+    pendingLatencySamples.store(currentTotalLatency);
+    setLatencySamples(currentTotalLatency);
 }
 
 void TapeAgeAudioProcessor::releaseResources()
@@ -127,20 +235,28 @@ void TapeAgeAudioProcessor::releaseResources()
 
     // Phase 4.2: Reset wow/flutter modulation
     delayLine.reset();
+
+    for (auto& channelSaturator : saturator)
+        channelSaturator.reset();
+
+    hysteresis.reset();
 }
 
 void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    PFS_TRACE_SCOPE("TapeAge", "processBlock");
     juce::ignoreUnused(midiMessages);
 
     // Clear unused channels
     for (int i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
+    // Read every parameter once for the block (atomic, no string lookups)
+    const auto params = parameterCache.load();
+
     // INPUT GAIN: Apply input trim FIRST (before any processing)
-    auto* inputParam = parameters.getRawParameterValue("input");
-    float inputDB = inputParam->load();
+    float inputDB = params.input;
     float inputGain = juce::Decibels::decibelsToGain(inputDB);
 
     if (inputGain != 1.0f)  // Only apply if not unity gain (optimization)
@@ -148,13 +264,29 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         buffer.applyGain(inputGain);
     }
 
+    // Read age parameter (0.0 to 1.0)
+    float age = params.age;
+
+    // Delay center: fixed per latency mode, and jumps when the mode changes (the host
+    // re-aligns anyway). setLatencySamples notifies the host, so the message thread
+    // picks the new latency up from the timer.
+    if (params.lowLatency != lowLatencyActive)
+    {
+        lowLatencyActive = params.lowLatency;
+        currentTotalLatency = getTotalLatencySamples(lowLatencyActive);
+        modulationCenter = static_cast<float>(currentTotalLatency) - oversamplerLatency;
+        pendingLatencySamples.store(currentTotalLatency);
+    }
+
+    // Dry path delay matches the wet path (set before the dry samples are pushed)
+    dryWetMixer.setWetLatency(static_cast<float>(currentTotalLatency));
+
     // Phase 4.4: Store dry signal AFTER input gain
     juce::dsp::AudioBlock<float> block(buffer);
     dryWetMixer.pushDrySamples(block);
 
     // Read mix parameter (0.0 = fully dry, 1.0 = fully wet)
-    auto* mixParam = parameters.getRawParameterValue("mix");
-    float mixValue = mixParam->load();
+    float mixValue = params.mix;
     dryWetMixer.setWetMixProportion(mixValue);
 
     // Phase 4.1: Core Saturation Processing
@@ -165,8 +297,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // 4. Downsample
 
     // Read drive parameter (0.0 to 1.0)
-    auto* driveParam = parameters.getRawParameterValue("drive");
-    float drive = driveParam->load();
+    float drive = params.drive;
 
     // Progressive curve mapping (architecture.md):
     // 0-30%: Very subtle (multiply by 1-2 before tanh)
@@ -189,112 +320,151 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
         gain = 8.0f + ((drive - 0.7f) / 0.3f) * 12.0f;
     }
 
-    // Upsample
-    auto oversampledBlock = oversampler.processSamplesUp(block);
+    {
+        PFS_TRACE_SCOPE("TapeAge", "oversampled saturation");
 
-    // Apply tanh saturation manually in oversampled domain
-    // Calculate makeup gain to compensate for volume increase (v1.1.0)
-    // Simple empirical formula: reduce output level proportionally to gain
-    // This keeps perceived loudness roughly constant
-    float makeupGain = 1.0f / std::sqrt(gain);
+        // Upsample
+        auto oversampledBlock = oversampler.processSamplesUp(block);
 
-    for (size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
-    {
-        auto* channelData = oversampledBlock.getChannelPointer(channel);
-        for (size_t sample = 0; sample < oversampledBlock.getNumSamples(); ++sample)
+        // Apply tanh saturation manually in oversampled domain
+        // Calculate makeup gain to compensate for volume increase (v1.1.0)
+        // Simple empirical formula: reduce output level proportionally to gain
+        // This keeps perceived loudness roughly constant
+        float makeupGain = 1.0f / std::sqrt(gain);
+
+        // Saturation mode (0 = Classic, 1 = ADAA, 2 = ADAA2)
+        const int saturationMode = params.saturationMode;
+
+        // Tape model (0 = Saturation, 1 = Hysteresis); hysteresis runs up to two channels as lanes
+        const bool useHysteresis = params.tapeModel != 0;
+        const size_t numHysteresisChannels = useHysteresis ? juce::jmin(oversampledBlock.getNumChannels(), size_t { 2 }) : 0;
+
+        if (numHysteresisChannels > 0)
         {
-            channelData[sample] = std::tanh(gain * channelData[sample]) * makeupGain;
+            const int solverIndex = params.hysteresisSolver;
+            hysteresis.setSolver(static_cast<JilesAthertonHysteresis::Solver>(juce::jlimit(0, 3, solverIndex)));
+
+            float* hysteresisChannels[2] = { oversampledBlock.getChannelPointer(0),
+                                             oversampledBlock.getChannelPointer(numHysteresisChannels - 1) };
+            hysteresis.process(hysteresisChannels, static_cast<int>(numHysteresisChannels),
+                               static_cast<int>(oversampledBlock.getNumSamples()), gain, makeupGain);
+        }
+
+        for (size_t channel = numHysteresisChannels; channel < oversampledBlock.getNumChannels(); ++channel)
+        {
+            auto* channelData = oversampledBlock.getChannelPointer(channel);
+            const int numOversampled = static_cast<int>(oversampledBlock.getNumSamples());
+
+            if (saturationMode == 0 || channel >= 2)
+            {
+                for (int sample = 0; sample < numOversampled; ++sample)
+                    channelData[sample] = std::tanh(gain * channelData[sample]) * makeupGain;
+            }
+            else
+            {
+                // Taking over from Classic or Hysteresis: start from the current input
+                auto& channelSaturator = saturator[channel];
+
+                if (!saturatorActive[channel])
+                    channelSaturator.restart();
+
+                channelSaturator.setOrder(saturationMode == 2 ? AdaaTanh::Order::second : AdaaTanh::Order::first);
+                channelSaturator.process(channelData, numOversampled, gain, makeupGain);
+            }
         }
-    }
 
-    // Downsample back to original sample rate
-    oversampler.processSamplesDown(block);
+        for (size_t channel = 0; channel < 2; ++channel)
+            saturatorActive[channel] = saturationMode != 0 && channel >= numHysteresisChannels
+                                    && channel < oversampledBlock.getNumChannels();
+
+        // Downsample back to original sample rate
+        oversampler.processSamplesDown(block);
+    }
 
     // Phase 4.2: Wow/Flutter Modulation
     // Processing chain: Apply pitch modulation via delay line after saturation
-    // Read age parameter (0.0 to 1.0)
-    auto* ageParam = parameters.getRawParameterValue("age");
-    float age = ageParam->load();
+    // (age was read before the dry samples were pushed)
 
     // Calculate LFO modulation depth based on age
     // v1.1.0: Enhanced wow depth - ±25 cents at max age (was ±10 cents)
-    // ±25 cents = 2^(25/1200) = 1.0145 (~1.45% pitch variation, still musical)
-    const float maxPitchVariationCents = 25.0f;
-    const float pitchVariationRatio = std::pow(2.0f, maxPitchVariationCents / 1200.0f) - 1.0f;  // ~0.0145
     float modulationDepth = age * pitchVariationRatio;
 
     // LFO frequency: 0.5-2Hz (architecture.md line 29)
     // Use 1.0Hz as base frequency, scaled by age for subtle variation
     const float lfoFrequency = 1.0f + age;  // 1.0-2.0Hz range
-    const float lfoPhaseIncrement = (lfoFrequency * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
 
-    // v1.1.0: Secondary flutter LFO at 6Hz for texture
-    const float flutterFrequency = 6.0f;
-    const float flutterPhaseIncrement = (flutterFrequency * juce::MathConstants<float>::twoPi) / static_cast<float>(currentSampleRate);
-    const float flutterDepthRatio = 0.2f;  // 20% of wow depth
+    // v1.1.0: Secondary flutter LFO at 6Hz for texture (frequency set in prepareToPlay)
+    const float modulationScale = static_cast<float>(currentSampleRate * modulationScaleSeconds);
+    const float wowDepthSamples = modulationDepth * modulationScale;
 
     // Process each channel
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
+    const int numModulatedChannels = juce::jmin(numChannels, 2, delayTrajectory.getNumChannels());
 
-    for (int channel = 0; channel < numChannels; ++channel)
-    {
-        auto* channelData = buffer.getWritePointer(channel);
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Calculate primary wow LFO (sine wave)
-            float lfoValue = std::sin(lfoPhase[channel]);
+    // Build each channel's delay trajectory (center + wow + flutter), then push the
+    // block and read it back along the trajectories. Chunked to the prepared block size.
+    const int maxChunk = delayTrajectory.getNumSamples();
 
-            // v1.1.0: Calculate secondary flutter LFO and combine
-            float flutterValue = std::sin(flutterPhase[channel]);
-            float combinedModulation = lfoValue + (flutterValue * flutterDepthRatio);
+    for (int channel = 0; channel < numModulatedChannels; ++channel)
+        wowLfo[channel].setFrequency(lfoFrequency, currentSampleRate);
 
-            // Calculate delay time in samples
-            // Base delay at center of buffer (100ms) + combined modulation
-            float baseDelaySamples = static_cast<float>(currentSampleRate) * 0.1f;  // 100ms center
-            float modulationSamples = combinedModulation * modulationDepth * baseDelaySamples;
-            float totalDelay = baseDelaySamples + modulationSamples;
+    for (int offset = 0; offset < numSamples; offset += maxChunk)
+    {
+        const int chunk = juce::jmin(maxChunk, numSamples - offset);
+        PFS_TRACE_SCOPE("TapeAge", "wow/flutter");
+        float* channelChunks[2] {};
 
-            // Push input sample to delay line
-            delayLine.pushSample(channel, channelData[sample]);
+        for (int channel = 0; channel < numModulatedChannels; ++channel)
+        {
+            auto* trajectory = delayTrajectory.getWritePointer(channel);
 
-            // Read modulated sample from delay line
-            channelData[sample] = delayLine.popSample(channel, totalDelay);
+            wowLfo[channel].render(trajectory, chunk, wowDepthSamples);
+            flutterLfo[channel].renderAdd(trajectory, chunk, wowDepthSamples * flutterDepthRatio);
 
-            // Advance LFO phases
-            lfoPhase[channel] += lfoPhaseIncrement;
-            if (lfoPhase[channel] >= juce::MathConstants<float>::twoPi)
-                lfoPhase[channel] -= juce::MathConstants<float>::twoPi;
+            for (int sample = 0; sample < chunk; ++sample)
+                trajectory[sample] += modulationCenter;
 
-            flutterPhase[channel] += flutterPhaseIncrement;
-            if (flutterPhase[channel] >= juce::MathConstants<float>::twoPi)
-                flutterPhase[channel] -= juce::MathConstants<float>::twoPi;
+            channelChunks[channel] = buffer.getWritePointer(channel) + offset;
         }
+
+        delayLine.process(channelChunks, delayTrajectory.getArrayOfReadPointers(), numModulatedChannels, chunk);
     }
 
     // v1.1.0: Age-dependent high-frequency rolloff (simulates tape aging)
     // Age 0%: 20kHz (transparent), Age 100%: 8kHz (vintage tape character)
-    if (age > 0.01f)  // Only apply filter if age is significant
+    // Below 1% age the filter fades out and stops; it fades back in from reset state.
+    ageFilterStage.setActive(age > 0.01f);
+
+    if (ageFilterStage.isActive())
     {
         // Exponential mapping for musical response: 20kHz -> 8kHz
         float cutoffFrequency = 20000.0f * std::pow(0.4f, age);  // 0.4^1 = 0.4, so 20kHz * 0.4 = 8kHz at age=1
 
-        // Update filter coefficients if cutoff changed significantly
-        auto coefficients = juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(currentSampleRate, cutoffFrequency);
+        // Update filter coefficients in place (frozen while fading out; no allocation)
+        const auto coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeFirstOrderLowPass(currentSampleRate, cutoffFrequency);
 
         for (int channel = 0; channel < numChannels; ++channel)
-        {
-            ageFilter[channel].coefficients = coefficients;
-            auto* channelData = buffer.getWritePointer(channel);
-
-            for (int sample = 0; sample < numSamples; ++sample)
-            {
-                channelData[sample] = ageFilter[channel].processSample(channelData[sample]);
-            }
-        }
+            *ageFilter[channel].coefficients = coefficients;
     }
 
+    ageFilterStage.process(buffer.getArrayOfWritePointers(), numChannels, numSamples,
+                           [&] {
+                               PFS_TRACE_SCOPE("TapeAge", "age filter");
+
+                               for (int channel = 0; channel < numChannels; ++channel)
+                               {
+                                   auto* channelData = buffer.getWritePointer(channel);
+
+                                   for (int sample = 0; sample < numSamples; ++sample)
+                                       channelData[sample] = ageFilter[channel].processSample(channelData[sample]);
+                               }
+                           },
+                           [&] {
+                               for (auto& filter : ageFilter)
+                                   filter.reset();
+                           });
+
     // Phase 4.3: Degradation Features (Dropout + Noise)
     // Processing chain: Apply dropout and tape noise after wow/flutter modulation
 
@@ -322,6 +492,8 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // Process dropout envelope (smooth attack/release to avoid clicks)
     if (inDropout && dropoutSamplesRemaining > 0)
     {
+        PFS_TRACE_SCOPE("TapeAge", "dropout");
+
         // Random attenuation factor 0.1-0.3 (70-90% reduction) (architecture.md line 40)
         const float dropoutTargetGain = 0.1f + random.nextFloat() * 0.2f;
 
@@ -393,6 +565,8 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
 
     if (noiseGain > 0.0f)
     {
+        PFS_TRACE_SCOPE("TapeAge", "tape noise");
+
         // One-pole lowpass filter coefficient for ~8kHz cutoff (architecture.md line 125)
         // Formula: coeff = 1 - exp(-2π * cutoffFreq / sampleRate)
         const float cutoffFreq = 8000.0f;
@@ -421,8 +595,7 @@ void TapeAgeAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     dryWetMixer.mixWetSamples(block);
 
     // OUTPUT GAIN: Apply output trim LAST (after all processing and mixing)
-    auto* outputParam = parameters.getRawParameterValue("output");
-    float outputDB = outputParam->load();
+    float outputDB = params.output;
     float outputGain = juce::Decibels::decibelsToGain(outputDB);
 
     if (outputGain != 1.0f)  // Only apply if not unity gain (optimization)
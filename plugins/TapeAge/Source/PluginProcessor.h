@@ -1,8 +1,31 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "dsp/AdaaTanh.h"
+#include "dsp/JilesAthertonHysteresis.h"
+#include "dsp/ModulatedDelayLine.h"
+#include "dsp/QuadratureOscillator.h"
+#include "dsp/StageBypass.h"
+#include "params/ParameterCache.h"
+#include "trace/Trace.h"
 
-class TapeAgeAudioProcessor : public juce::AudioProcessor
+// Parameter values for one block (input and output in dB, drive, age and mix 0-1;
+// choices are indices)
+struct TapeAgeParameters
+{
+    float input;
+    float drive;
+    int saturationMode;
+    int tapeModel;
+    int hysteresisSolver;
+    bool lowLatency;
+    float age;
+    float mix;
+    float output;
+};
+
+class TapeAgeAudioProcessor : public juce::AudioProcessor,
+                              private juce::Timer
 {
 public:
     TapeAgeAudioProcessor();
@@ -19,7 +42,7 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return computeTailSeconds(); }
 
     int getNumPrograms() override { return 0; }
     int getCurrentProgram() override { return 0; }
@@ -42,14 +65,31 @@ private:
 
     // Phase 4.1: Core Saturation Processing
     juce::dsp::Oversampling<float> oversampler { 2, 1, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple };
+    AdaaTanh saturator[2];  // Anti-aliased tanh per channel
+    bool saturatorActive[2] { false, false };  // Ran last block (Classic or Hysteresis did not)
+    JilesAthertonHysteresis hysteresis;  // Both channels in lockstep
 
     // Phase 4.2: Wow/Flutter Modulation
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLine;
-    float lfoPhase[2] { 0.0f, 0.0f };  // Separate phase per channel for stereo width
-    float flutterPhase[2] { 0.0f, 0.0f };  // Secondary flutter LFO phase per channel (v1.1.0)
+    ModulatedDelayLine delayLine;  // Lagrange3rd, one delay trajectory per channel
+    QuadratureOscillator wowLfo[2];  // Separate phase per channel for stereo width
+    QuadratureOscillator flutterLfo[2];  // Secondary flutter LFO per channel (v1.1.0)
+    juce::AudioBuffer<float> delayTrajectory;  // Per-channel delay in samples for the current block
     juce::Random random;
     double currentSampleRate { 44100.0 };
 
+    // Wow/flutter delay center: 100ms, or in low-latency mode the smallest delay the
+    // full age depth allows. Centers are chosen so oversampler + center is a whole
+    // number of samples, which is what gets reported to the host.
+    int getTotalLatencySamples(bool lowLatency) const noexcept;
+    double computeTailSeconds() const;  // Latency plus the deepest wow/flutter excursion
+    void timerCallback() override;  // Reports latency changes to the host
+
+    float oversamplerLatency { 0.0f };
+    float modulationCenter { 0.0f };  // Delay center in samples, for the active latency mode
+    bool lowLatencyActive { false };
+    int currentTotalLatency { 0 };
+    std::atomic<int> pendingLatencySamples { 0 };  // Audio thread → message thread timer
+
     // Phase 4.3: Degradation Features (Dropout + Noise + High-frequency Rolloff)
     int dropoutCountdown { 0 };  // Samples until next dropout check
     bool inDropout { false };  // Dropout state flag
@@ -57,6 +97,7 @@ private:
     float dropoutEnvelope { 1.0f };  // Smooth attack/release (1.0 = no attenuation)
     float noiseFilterState[2] { 0.0f, 0.0f };  // One-pole lowpass filter state per channel
     juce::dsp::IIR::Filter<float> ageFilter[2];  // High-frequency rolloff per channel (v1.1.0)
+    StageBypass ageFilterStage;  // Off below 1% age, crossfades in and out
 
     // Phase 4.4: Dry/Wet Mixing
     juce::dsp::DryWetMixer<float> dryWetMixer { 20000 };  // Max latency: 192kHz * 0.1s delay line + oversampler
@@ -64,5 +105,11 @@ private:
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    // Parameter IDs resolved once; load() reads every value without string lookups
+    ParameterCache<TapeAgeParameters> parameterCache;
+
+    // Exports the processBlock stage traces (compiled out unless PFS_TRACE)
+    PFS_TRACE_SESSION("TapeAge");
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TapeAgeAudioProcessor)
 };
@@ -0,0 +1,340 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cstring>
+#include <vector>
+
+// tanh waveshaper with antiderivative anti-aliasing (ADAA), one instance per channel.
+//
+// First order:  y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]),  F1(x) = log(cosh(x))
+// Second order: divided differences of F2(x) = integral of log(cosh), written with the
+//               dilogarithm: F2(x) = x^2/2 - x*ln2 + (Li2(-e^-2x) + pi^2/12) / 2  (x >= 0, odd)
+//
+// Antiderivatives are evaluated in double precision: the divided differences cancel
+// heavily, and near-equal inputs fall back to evaluating at the midpoint instead.
+// They are branch-free polynomials, so each block's antiderivative pass vectorises.
+// ADAA adds half a sample (first order) or one sample (second order) of delay.
+//
+// The divided differences need the previous inputs. A stage that takes over a signal
+// mid-stream (a new order, or another waveshaper running until now) calls restart():
+// the next block then starts as if its first input had been held, so the first
+// output is tanh of that input rather than a step from stale or zero state.
+//
+// Cost and aliasing against std::tanh: pfs_dspbench --case=saturation.
+class AdaaTanh
+{
+public:
+    enum class Order { first = 1, second = 2 };
+
+    // Allocates the block scratch buffers (not on the audio thread)
+    void prepare(int maximumBlockSize)
+    {
+        inputScratch.assign(static_cast<size_t>(juce::jmax(1, maximumBlockSize)), 0.0);
+        antiderivativeScratch.assign(inputScratch.size(), 0.0);
+        reset();
+    }
+
+    void setOrder(Order newOrder) noexcept
+    {
+        if (newOrder != order)
+        {
+            order = newOrder;
+            restart();
+        }
+    }
+
+    Order getOrder() const noexcept { return order; }
+
+    void reset() noexcept
+    {
+        x1 = x2 = 0.0;
+        f1x1 = logCosh(0.0);
+        f2x1 = 0.0;
+        d1 = 0.0;
+        restartPending = false;
+    }
+
+    // The next process() takes its history from its own first input
+    void restart() noexcept { restartPending = true; }
+
+    // In place: data[i] = tanh((gain + i * gainIncrement) * data[i]) (anti-aliased) * outputGain.
+    // Returns the peak magnitude of the output.
+    float process(float* data, int numSamples, float gain, float outputGain, float gainIncrement = 0.0f) noexcept
+    {
+        const int maxChunk = static_cast<int>(inputScratch.size());
+        jassert(maxChunk > 0);
+
+        float peak = 0.0f;
+
+        if (restartPending && numSamples > 0)
+        {
+            prime(static_cast<double>(gain * data[0]));
+            restartPending = false;
+        }
+
+        for (int offset = 0; offset < numSamples; offset += maxChunk)
+        {
+            const int n = juce::jmin(maxChunk, numSamples - offset);
+            const float chunkGain = gain + gainIncrement * static_cast<float>(offset);
+
+            if (order == Order::first)
+                peak = juce::jmax(peak, processFirstOrder(data + offset, n, chunkGain, gainIncrement, outputGain));
+            else
+                peak = juce::jmax(peak, processSecondOrder(data + offset, n, chunkGain, gainIncrement, outputGain));
+        }
+
+        return peak;
+    }
+
+    // Largest |x| the block forms take. The block loops clamp their inputs to it: tanh
+    // is 1 there to double precision, and beyond it e^(-2|x|) (~1e-261) no longer
+    // changes the antiderivatives.
+    static constexpr double maxInput = 300.0;
+
+    // First antiderivative of tanh: log(cosh(x)) = |x| + log1p(exp(-2|x|)) - ln2
+    // (overflow-safe form)
+    static double logCosh(double x) noexcept
+    {
+        const double a = std::abs(x);
+        return a <= maxInput ? logCoshInRange(x) : a - juce::MathConstants<double>::ln2;
+    }
+
+    // Second antiderivative of tanh (integral of logCosh from 0 to x)
+    static double logCoshIntegral(double x) noexcept
+    {
+        const double a = std::abs(x);
+        const double pi2over24 = juce::MathConstants<double>::pi * juce::MathConstants<double>::pi / 24.0;
+        return a <= maxInput ? logCoshIntegralInRange(x)
+                             : std::copysign(0.5 * a * a - a * juce::MathConstants<double>::ln2 + pi2over24, x);
+    }
+
+    // Block forms, for |x[i]| <= maxInput: straight-line double arithmetic (no libm
+    // calls, branches, selects or iterations) that the compiler vectorises. Each step
+    // is a loop of its own over `result`: fused into one, they run out of registers.
+    static void logCosh(const double* x, double* result, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            result[i] = expNegTwice(std::abs(x[i]));
+
+        for (int i = 0; i < numSamples; ++i)
+            result[i] = std::abs(x[i]) + log1pUnit(result[i]) - juce::MathConstants<double>::ln2;
+    }
+
+    static void logCoshIntegral(const double* x, double* result, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            result[i] = expNegTwice(std::abs(x[i]));
+
+        for (int i = 0; i < numSamples; ++i)
+            result[i] = log1pUnit(result[i]);
+
+        for (int i = 0; i < numSamples; ++i)
+            result[i] = logCoshIntegralFromLog(x[i], result[i]);
+    }
+
+private:
+    static constexpr double tolerance = 1.0e-5;        // First-order ill-conditioning threshold
+    static constexpr double toleranceSecond = 1.0e-3;  // Second order divides twice: needs a wider margin
+
+    // History of a held input x: F1 and F2 at x, and the divided difference of F2
+    // between two equal points, which is F1
+    void prime(double x) noexcept
+    {
+        x = juce::jlimit(-maxInput, maxInput, x);
+        x1 = x2 = x;
+        f1x1 = logCosh(x);
+        f2x1 = logCoshIntegral(x);
+        d1 = f1x1;
+    }
+
+    // The antiderivatives are accurate to a few ulp over their whole range: rounding
+    // noise is all the divided differences amplify, and a smooth approximation error
+    // only shifts the result by the error's derivative. The input clamp is a loop of its
+    // own, as a select ahead of the arithmetic would stop the vectoriser.
+
+    // logCosh for |x| <= maxInput
+    static double logCoshInRange(double x) noexcept
+    {
+        const double a = std::abs(x);
+        return a + log1pUnit(expNegTwice(a)) - juce::MathConstants<double>::ln2;
+    }
+
+    // logCoshIntegral for |x| <= maxInput
+    static double logCoshIntegralInRange(double x) noexcept
+    {
+        return logCoshIntegralFromLog(x, log1pUnit(expNegTwice(std::abs(x))));
+    }
+
+    // logCoshIntegral from x and l = log(1 + e^-2|x|):
+    // F2(x) = x^2/2 - |x|*ln2 + (Li2(-e^-2|x|) + pi^2/12) / 2 for x >= 0 (odd), and
+    // Li2(-e^-2|x|) = -Li2(1 - e^-l) - l^2/2, the Bernoulli series in l (dilogBernoulli)
+    static double logCoshIntegralFromLog(double x, double l) noexcept
+    {
+        const double a = std::abs(x);
+        const double pi2over12 = juce::MathConstants<double>::pi * juce::MathConstants<double>::pi / 12.0;
+        const double value = 0.5 * a * a - a * juce::MathConstants<double>::ln2
+                           + 0.5 * (pi2over12 - dilogBernoulli(l) - 0.5 * l * l);
+        return std::copysign(value, x);
+    }
+
+    // e^(-2a) for 0 <= a <= maxInput: Cody-Waite reduction to r in [-ln2/2, ln2/2],
+    // 13th-order Taylor polynomial, 2^n written into the exponent bits
+    static double expNegTwice(double a) noexcept
+    {
+        constexpr double shifter = 6755399441055744.0;  // 1.5 * 2^52: adding it rounds to an integer in the low bits
+        constexpr double log2e = 1.4426950408889634;
+        constexpr double ln2High = 6.93147180369123816490e-01;  // ln2 split so n * ln2High is exact
+        constexpr double ln2Low = 1.90821492927058770002e-10;
+
+        const double x = -2.0 * a;
+        const double shifted = x * log2e + shifter;
+        const double n = shifted - shifter;
+        const double r = (x - n * ln2High) - n * ln2Low;
+
+        const double p = 1.0 + r * (1.0 + r * (1.0 / 2.0 + r * (1.0 / 6.0 + r * (1.0 / 24.0 + r * (1.0 / 120.0
+                       + r * (1.0 / 720.0 + r * (1.0 / 5040.0 + r * (1.0 / 40320.0 + r * (1.0 / 362880.0
+                       + r * (1.0 / 3628800.0 + r * (1.0 / 39916800.0 + r * (1.0 / 479001600.0
+                       + r * (1.0 / 6227020800.0)))))))))))));
+
+        juce::int64 bits;
+        std::memcpy(&bits, &shifted, sizeof(bits));
+        const auto scaleBits = static_cast<juce::uint64>(bits - 0x4338000000000000LL + 1023) << 52;
+        double scale;
+        std::memcpy(&scale, &scaleBits, sizeof(scale));
+
+        return p * scale;
+    }
+
+    // log(1 + u) for u in [0, 1]: 2 * atanh(s) with s = u / (2 + u) <= 1/3, so the odd
+    // series in s^2 <= 1/9 reaches double precision by its 17th term
+    static double log1pUnit(double u) noexcept
+    {
+        const double s = u / (2.0 + u);
+        const double s2 = s * s;
+
+        const double series = 1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0 + s2 * (1.0 / 7.0 + s2 * (1.0 / 9.0
+                            + s2 * (1.0 / 11.0 + s2 * (1.0 / 13.0 + s2 * (1.0 / 15.0 + s2 * (1.0 / 17.0
+                            + s2 * (1.0 / 19.0 + s2 * (1.0 / 21.0 + s2 * (1.0 / 23.0 + s2 * (1.0 / 25.0
+                            + s2 * (1.0 / 27.0 + s2 * (1.0 / 29.0 + s2 * (1.0 / 31.0 + s2 * (1.0 / 33.0))))))))))))))));
+
+        return 2.0 * s * series;
+    }
+
+    // Li2(1 - e^-t) = sum of B_n t^(n+1) / (n+1)! (Bernoulli numbers), for t in [0, ln2]:
+    // converges as (t / 2pi)^2 per term, so ten terms reach double precision
+    static double dilogBernoulli(double t) noexcept
+    {
+        const double t2 = t * t;
+        const double odd = 1.0 / 36.0 + t2 * (-1.0 / 3600.0 + t2 * (1.0 / 211680.0 + t2 * (-1.0 / 10886400.0
+                         + t2 * (1.0 / 526901760.0 + t2 * (-691.0 / 16999766784000.0 + t2 * (1.0 / 1120863744000.0
+                         + t2 * (-3617.0 / 181400588328960000.0 + t2 * (43867.0 / 97072790126247936000.0))))))));
+
+        return t - 0.25 * t2 + t * t2 * odd;
+    }
+
+    // x[i] = (gain + i * gainIncrement) * data[i], clamped to +-maxInput
+    static void clampInputs(double* x, const float* data, int numSamples, float gain, float gainIncrement) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            x[i] = static_cast<double>((gain + gainIncrement * static_cast<float>(i)) * data[i]);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double low = x[i] < -maxInput ? -maxInput : x[i];
+            x[i] = low > maxInput ? maxInput : low;
+        }
+    }
+
+    float processFirstOrder(float* data, int numSamples, float gain, float gainIncrement, float outputGain) noexcept
+    {
+        double* x = inputScratch.data();
+        double* f1 = antiderivativeScratch.data();
+
+        // Pass 1: antiderivative for the whole block (no loop-carried state)
+        clampInputs(x, data, numSamples, gain, gainIncrement);
+        logCosh(x, f1, numSamples);
+
+        // Pass 2: divided differences, midpoint fallback when inputs nearly coincide
+        double previousX = x1;
+        double previousF1 = f1x1;
+        float peak = 0.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double delta = x[i] - previousX;
+            const double y = std::abs(delta) > tolerance
+                                 ? (f1[i] - previousF1) / delta
+                                 : std::tanh(0.5 * (x[i] + previousX));
+
+            data[i] = static_cast<float>(y) * outputGain;
+            peak = juce::jmax(peak, std::abs(data[i]));
+            previousX = x[i];
+            previousF1 = f1[i];
+        }
+
+        x1 = previousX;
+        f1x1 = previousF1;
+        return peak;
+    }
+
+    float processSecondOrder(float* data, int numSamples, float gain, float gainIncrement, float outputGain) noexcept
+    {
+        double* x = inputScratch.data();
+        double* f2 = antiderivativeScratch.data();
+        float peak = 0.0f;
+
+        clampInputs(x, data, numSamples, gain, gainIncrement);
+        logCoshIntegral(x, f2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x0 = x[i];
+
+            // First divided difference of F2 between x[n] and x[n-1]
+            const double delta = x0 - x1;
+            const double d0 = std::abs(delta) > toleranceSecond
+                                  ? (f2[i] - f2x1) / delta
+                                  : logCosh(0.5 * (x0 + x1));
+
+            double y;
+            const double span = x0 - x2;
+
+            if (std::abs(span) > toleranceSecond)
+            {
+                y = 2.0 * (d0 - d1) / span;
+            }
+            else
+            {
+                // x[n] ~ x[n-2]: expand around their mean instead
+                const double mean = 0.5 * (x0 + x2);
+                const double offset = mean - x1;
+
+                if (std::abs(offset) > toleranceSecond)
+                    y = (2.0 / offset) * (logCosh(mean) + (f2x1 - logCoshIntegral(mean)) / offset);
+                else
+                    y = std::tanh(0.5 * (mean + x1));
+            }
+
+            data[i] = static_cast<float>(y) * outputGain;
+            peak = juce::jmax(peak, std::abs(data[i]));
+
+            x2 = x1;
+            x1 = x0;
+            f2x1 = f2[i];
+            d1 = d0;
+        }
+
+        return peak;
+    }
+
+    Order order = Order::first;
+
+    // Previous inputs and antiderivative values
+    double x1 = 0.0, x2 = 0.0;
+    double f1x1 = 0.0;  // F1(x[n-1]) (first order)
+    double f2x1 = 0.0;  // F2(x[n-1]) (second order)
+    double d1 = 0.0;    // Divided difference of F2 between x[n-1] and x[n-2]
+    bool restartPending = false;
+
+    std::vector<double> inputScratch;
+    std::vector<double> antiderivativeScratch;
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+// Serial chain of up to MaxStages biquads (transposed direct form II).
+//
+// process() runs the chain stage by stage over the whole block, so each stage's
+// coefficients and state stay in registers for the inner loop. SampleType may be
+// float/double or juce::dsp::SIMDRegister<float> to run several voices/channels
+// in parallel lanes with shared coefficients.
+//
+// Coefficients are stored inline; setting them never allocates.
+template <typename SampleType, size_t MaxStages>
+class BiquadCascade
+{
+public:
+    using NumericType = typename juce::dsp::SampleTypeHelpers::ElementType<SampleType>::Type;
+
+    // Raw {b0, b1, b2, a0, a1, a2}, as returned by juce::dsp::IIR::ArrayCoefficients
+    void setStage(size_t index, const std::array<NumericType, 6>& c) noexcept
+    {
+        jassert(index < MaxStages);
+        const auto a0inv = static_cast<NumericType>(1) / c[3];
+
+        auto& stage = stages[index];
+        stage.b0 = c[0] * a0inv;
+        stage.b1 = c[1] * a0inv;
+        stage.b2 = c[2] * a0inv;
+        stage.a1 = c[4] * a0inv;
+        stage.a2 = c[5] * a0inv;
+        stage.enabled = true;
+    }
+
+    // Disabled stages are skipped entirely (their state is kept)
+    void setStageEnabled(size_t index, bool shouldBeEnabled) noexcept
+    {
+        jassert(index < MaxStages);
+        stages[index].enabled = shouldBeEnabled;
+    }
+
+    bool isStageEnabled(size_t index) const noexcept { return stages[index].enabled; }
+
+    void reset() noexcept
+    {
+        for (auto& stage : stages)
+            stage.s1 = stage.s2 = SampleType();
+    }
+
+    SampleType processSample(SampleType x) noexcept
+    {
+        for (auto& stage : stages)
+        {
+            if (!stage.enabled)
+                continue;
+
+            const auto y = x * stage.b0 + stage.s1;
+            stage.s1 = x * stage.b1 - y * stage.a1 + stage.s2;
+            stage.s2 = x * stage.b2 - y * stage.a2;
+            x = y;
+        }
+
+        return x;
+    }
+
+    // In-place block processing, one stage at a time
+    void process(SampleType* data, int numSamples) noexcept
+    {
+        for (auto& stage : stages)
+        {
+            if (!stage.enabled)
+                continue;
+
+            const auto b0 = stage.b0, b1 = stage.b1, b2 = stage.b2;
+            const auto a1 = stage.a1, a2 = stage.a2;
+            auto s1 = stage.s1;
+            auto s2 = stage.s2;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto x = data[i];
+                const auto y = x * b0 + s1;
+                s1 = x * b1 - y * a1 + s2;
+                s2 = x * b2 - y * a2;
+                data[i] = y;
+            }
+
+            juce::dsp::util::snapToZero(s1);
+            juce::dsp::util::snapToZero(s2);
+            stage.s1 = s1;
+            stage.s2 = s2;
+        }
+    }
+
+private:
+    struct Stage
+    {
+        NumericType b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+        SampleType s1 {}, s2 {};
+        bool enabled = false;
+    };
+
+    std::array<Stage, MaxStages> stages;
+};
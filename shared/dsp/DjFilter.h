@@ -0,0 +1,227 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+#include <vector>
+
+// One-knob DJ filter: low-pass on the left half of the knob, high-pass on the right.
+//
+// A state-variable filter (trapezoidal, Butterworth Q) gives the low-pass and
+// high-pass outputs of one structure, and the output morphs from the input to the
+// selected one as the knob leaves the centre: out = in + m * (filtered - in), m
+// rising from 0 at the centre to 1 at 5%. At the centre the output is the input
+// exactly, so there is no bypass zone to switch in and out of, and crossing from
+// low-pass to high-pass passes through the dry signal instead of resetting state.
+//
+// The position is smoothed per sample (the SVF takes coefficient changes every
+// sample without artefacts); coefficients are only recomputed while it moves.
+// Channels are processed in pairs, both lanes of a pair sharing the coefficients.
+// A per-channel gain ramp can be applied in the same pass. Nothing allocates
+// after prepare().
+class DjFilter
+{
+public:
+    // Cutoff range per side, as in the original IIR versions of the filter
+    static constexpr float lowPassTopHz = 20000.0f;     // Centre
+    static constexpr float lowPassBottomHz = 200.0f;    // Fully left
+    static constexpr float highPassBottomHz = 20.0f;    // Centre
+    static constexpr float highPassTopHz = 10000.0f;    // Fully right
+    static constexpr float morphWidth = 0.05f;          // Knob travel over which the filter fades in
+
+    // Allocates (not on the audio thread)
+    void prepare(double newSampleRate, int maximumChannels, double smoothingSeconds = 0.02)
+    {
+        sampleRate = static_cast<float>(newSampleRate);
+        lanes.assign(static_cast<size_t>((juce::jmax(1, maximumChannels) + 1) / 2), {});
+        position.reset(newSampleRate, smoothingSeconds);
+        reset();
+    }
+
+    // Clears the filter state and jumps to the target position
+    void reset() noexcept
+    {
+        for (auto& pair : lanes)
+            pair = {};
+
+        position.setCurrentAndTargetValue(position.getTargetValue());
+        coefficients = makeCoefficients(position.getCurrentValue());
+    }
+
+    // -1 (low-pass at lowPassBottomHz) .. 0 (no filtering) .. +1 (high-pass at highPassTopHz)
+    void setPosition(float newPosition) noexcept
+    {
+        position.setTargetValue(juce::jlimit(-1.0f, 1.0f, newPosition));
+    }
+
+    // Resting at the centre: process() leaves the audio untouched
+    bool isNeutral() const noexcept { return !position.isSmoothing() && position.getCurrentValue() == 0.0f; }
+
+    // Linear gain across a block: sample i is scaled by start + step * i
+    struct GainRamp
+    {
+        float start = 1.0f;
+        float step = 0.0f;
+    };
+
+    void process(float* const* channels, int numChannels, int numSamples) noexcept
+    {
+        process(channels, numChannels, numSamples, nullptr);
+    }
+
+    // Filter, then one gain ramp per channel on the output, in one pass over each
+    // channel (gains: numChannels ramps, or nullptr for none)
+    void process(float* const* channels, int numChannels, int numSamples, const GainRamp* gains) noexcept
+    {
+        numChannels = juce::jmin(numChannels, static_cast<int>(lanes.size()) * 2);
+
+        if (isNeutral())
+        {
+            // Output is the input: drop the state now so the next move starts clean
+            if (!stateCleared)
+            {
+                for (auto& pair : lanes)
+                    pair = {};
+
+                stateCleared = true;
+            }
+
+            if (gains != nullptr)
+                for (int channel = 0; channel < numChannels; ++channel)
+                    applyGainRamp(channels[channel], numSamples, gains[channel]);
+
+            return;
+        }
+
+        stateCleared = false;
+
+        if (!position.isSmoothing())
+        {
+            for (int channel = 0; channel < numChannels; channel += 2)
+            {
+                const int right = juce::jmin(channel + 1, numChannels - 1);
+                processPair(coefficients, lanes[static_cast<size_t>(channel / 2)], channels[channel], channels[right],
+                            0, numSamples, rampFor(gains, channel), rampFor(gains, right));
+            }
+
+            return;
+        }
+
+        // Moving: new coefficients every sample, applied to every channel pair
+        for (int i = 0; i < numSamples; ++i)
+        {
+            coefficients = makeCoefficients(position.getNextValue());
+
+            for (int channel = 0; channel < numChannels; channel += 2)
+            {
+                const int right = juce::jmin(channel + 1, numChannels - 1);
+                processPair(coefficients, lanes[static_cast<size_t>(channel / 2)], channels[channel], channels[right],
+                            i, i + 1, rampFor(gains, channel), rampFor(gains, right));
+            }
+        }
+    }
+
+    // data[i] *= start + step * i (nothing to do at a steady unity gain)
+    static void applyGainRamp(float* data, int numSamples, GainRamp gain) noexcept
+    {
+        if (gain.step == 0.0f)
+        {
+            if (gain.start != 1.0f)
+                juce::FloatVectorOperations::multiply(data, gain.start, numSamples);
+
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] *= gain.start + gain.step * static_cast<float>(i);
+    }
+
+private:
+    struct Coefficients
+    {
+        float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f;
+        float lowMix = 0.0f, highMix = 0.0f;  // Morph amount towards each output (one is 0)
+    };
+
+    // Integrator states of one channel pair, one lane per channel
+    struct LanePair
+    {
+        float ic1[2] {};
+        float ic2[2] {};
+    };
+
+    static constexpr float damping = 1.41421356f;  // k = 1/Q, Q = 0.707
+
+    Coefficients makeCoefficients(float pos) const noexcept
+    {
+        const float amount = std::abs(pos);
+        const float mix = juce::jmin(1.0f, amount / morphWidth);
+
+        // Exponential mapping from the centre outwards
+        const float cutoffHz = pos < 0.0f
+            ? lowPassTopHz * std::exp(amount * lowPassLogRange)
+            : highPassBottomHz * std::exp(amount * highPassLogRange);
+
+        const float g = std::tan(juce::MathConstants<float>::pi * juce::jmin(cutoffHz, 0.45f * sampleRate) / sampleRate);
+
+        Coefficients c;
+        c.a1 = 1.0f / (1.0f + g * (g + damping));
+        c.a2 = g * c.a1;
+        c.a3 = g * c.a2;
+        c.lowMix = pos < 0.0f ? mix : 0.0f;
+        c.highMix = pos > 0.0f ? mix : 0.0f;
+        return c;
+    }
+
+    static GainRamp rampFor(const GainRamp* gains, int channel) noexcept
+    {
+        return gains != nullptr ? gains[channel] : GainRamp {};
+    }
+
+    // Both lanes in lockstep so the pair maps onto one SIMD register. A lone last
+    // channel is passed as both lanes: the lanes compute the same values.
+    static void processPair(const Coefficients& c, LanePair& s, float* left, float* right, int start, int end,
+                            GainRamp leftGain, GainRamp rightGain) noexcept
+    {
+        const float gainStart[2] { leftGain.start, rightGain.start };
+        const float gainStep[2] { leftGain.step, rightGain.step };
+
+        float ic1[2] { s.ic1[0], s.ic1[1] };
+        float ic2[2] { s.ic2[0], s.ic2[1] };
+
+        for (int i = start; i < end; ++i)
+        {
+            const float in[2] { left[i], right[i] };
+            float out[2];
+
+            for (int lane = 0; lane < 2; ++lane)
+            {
+                const float v3 = in[lane] - ic2[lane];
+                const float v1 = c.a1 * ic1[lane] + c.a2 * v3;
+                const float v2 = ic2[lane] + c.a2 * ic1[lane] + c.a3 * v3;
+                ic1[lane] = 2.0f * v1 - ic1[lane];
+                ic2[lane] = 2.0f * v2 - ic2[lane];
+
+                const float low = v2;
+                const float high = in[lane] - damping * v1 - v2;
+                out[lane] = (in[lane] + c.lowMix * (low - in[lane]) + c.highMix * (high - in[lane]))
+                          * (gainStart[lane] + gainStep[lane] * static_cast<float>(i));
+            }
+
+            left[i] = out[0];
+            right[i] = out[1];
+        }
+
+        s.ic1[0] = ic1[0];
+        s.ic1[1] = ic1[1];
+        s.ic2[0] = ic2[0];
+        s.ic2[1] = ic2[1];
+    }
+
+    const float lowPassLogRange = std::log(lowPassBottomHz / lowPassTopHz);
+    const float highPassLogRange = std::log(highPassTopHz / highPassBottomHz);
+
+    std::vector<LanePair> lanes;
+    juce::SmoothedValue<float> position;
+    Coefficients coefficients;
+    float sampleRate = 44100.0f;
+    bool stateCleared = true;
+};
@@ -0,0 +1,467 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "HalfbandResampler.h"
+#include "QuadratureOscillator.h"
+
+// Stereo feedback-delay-network reverb (Jot/Stautner-Puckette), 100% wet output.
+//
+// N delay lines (16, or 8 in eco quality) are mixed through an orthogonal matrix:
+// a fast Walsh-Hadamard transform (log2 N add/sub passes) or a Householder
+// reflection (one sum). Each line has an absorbent one-pole filter whose gains
+// come straight from the RT60 targets, so decaySeconds is the actual low-frequency
+// decay time and damping sets the high-frequency decay relative to it.
+//
+// Processing runs in 32-sample sub-blocks (shorter than any line), so each stage is
+// a flat loop the compiler vectorises: straight copies for unmodulated lines, the
+// matrix as butterflies over whole rows, the damping across lines. Half the lines
+// are modulated (interpolated gathers); line lengths scale with size and glide.
+//
+// Rate::half and Rate::quarter run the tank at 1/2 or 1/4 of the host rate between
+// halfband filters (HalfbandResampler). The tank cost drops by the factor and the
+// filters add some of it back. The wet signal is band-limited to 0.4 of the tank
+// rate and delayed by getLatencySamples(), which the caller compensates.
+//
+// Cost by quality, modulation and rate, against juce::Reverb: pfs_dspbench --case=reverb.
+//
+// The quality, matrix and rate are audio-thread safe to change (they reset the tank).
+class FdnReverb
+{
+public:
+    enum class Quality { eco, standard };  // 8 or 16 lines
+    enum class Matrix { hadamard, householder };
+    enum class Rate { full, half, quarter };  // Tank rate relative to the host rate
+
+    struct Parameters
+    {
+        float size = 0.5f;             // 0-1: mean line length ~15ms to ~60ms
+        float decaySeconds = 2.0f;     // RT60 at low frequencies
+        float damping = 0.5f;          // 0-1: high-frequency RT60 = decay * (1 - 0.9 * damping)
+        float modulationDepth = 0.0f;  // 0-1: length modulation of half the lines, up to ±1ms
+        float modulationRate = 0.5f;   // Hz
+        float width = 1.0f;            // 0 = mono, 1 = full stereo
+    };
+
+    static constexpr int maxLines = 16;
+
+    // Allocates (not on the audio thread)
+    void prepare(double newSampleRate, int maximumBlockSize)
+    {
+        hostSampleRate = newSampleRate;
+        sampleRate = hostSampleRate / resampler.getFactor();
+        maxBlock = juce::jmax(1, maximumBlockSize);
+
+        // The shortest modulated line must span a whole sub-block, even at quarter rate
+        jassert(hostSampleRate * 0.25 * (0.008 - maxModulationSeconds) > subBlockSize);
+
+        // Lines sized for the host rate also cover the reduced rates
+        const int maxLength = static_cast<int>(std::ceil(hostSampleRate * (maxLineSeconds + maxModulationSeconds))) + 4;
+        lineSize = juce::nextPowerOfTwo(maxLength);
+        lineMask = lineSize - 1;
+
+        for (auto& line : lines)
+            line.assign(static_cast<size_t>(lineSize), 0.0f);
+
+        lfoSin.assign(static_cast<size_t>(maxBlock), 0.0f);
+        lfoCos.assign(static_cast<size_t>(maxBlock), 0.0f);
+        resampler.prepare(2, maxBlock);
+
+        updateTargets();
+        currentLengths = targetLengths;
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& line : lines)
+            std::fill(line.begin(), line.end(), 0.0f);
+
+        dampingState.fill(0.0f);
+        writePosition = 0;
+        lfo.setPhase(0.0);
+        resampler.reset();
+    }
+
+    void setParameters(const Parameters& newParameters) noexcept
+    {
+        parameters = newParameters;
+        updateTargets();
+    }
+
+    const Parameters& getParameters() const noexcept { return parameters; }
+
+    void setQuality(Quality newQuality) noexcept
+    {
+        if (newQuality != quality)
+        {
+            quality = newQuality;
+            updateTargets();
+            currentLengths = targetLengths;
+            reset();
+        }
+    }
+
+    void setMatrix(Matrix newMatrix) noexcept
+    {
+        if (newMatrix != matrix)
+        {
+            matrix = newMatrix;
+            reset();
+        }
+    }
+
+    void setRate(Rate newRate) noexcept
+    {
+        const int numStages = newRate == Rate::quarter ? 2 : (newRate == Rate::half ? 1 : 0);
+
+        if (numStages != resampler.getNumStages())
+        {
+            resampler.setNumStages(numStages);
+            sampleRate = hostSampleRate / resampler.getFactor();
+            updateTargets();
+            currentLengths = targetLengths;
+            reset();
+        }
+    }
+
+    // Largest reduction that keeps the tank at 44.1 kHz or more (full band wet signal)
+    static Rate reducedRateFor(double hostRate) noexcept
+    {
+        if (hostRate >= 4.0 * 44100.0)
+            return Rate::quarter;
+
+        return hostRate >= 2.0 * 44100.0 ? Rate::half : Rate::full;
+    }
+
+    int getNumLines() const noexcept { return quality == Quality::eco ? 8 : 16; }
+
+    // Wet-path delay added by the reduced-rate modes, in host-rate samples
+    int getLatencySamples() const noexcept { return resampler.getLatencySamples(); }
+
+    // In place, replaces the input with the wet signal. right may be nullptr (mono).
+    void process(float* left, float* right, int numSamples) noexcept
+    {
+        for (int offset = 0; offset < numSamples; offset += maxBlock)
+        {
+            const int n = juce::jmin(maxBlock, numSamples - offset);
+            float* channels[] = { left + offset, right != nullptr ? right + offset : nullptr };
+            const int numChannels = right != nullptr ? 2 : 1;
+
+            if (resampler.getNumStages() == 0)
+            {
+                processTank(channels[0], channels[1], n);
+                continue;
+            }
+
+            const int lowRateSamples = resampler.down(channels, numChannels, n);
+            float* const* lowRate = resampler.getLowRate();
+            processTank(lowRate[0], numChannels > 1 ? lowRate[1] : nullptr, lowRateSamples);
+            resampler.up(channels, numChannels, n);
+        }
+    }
+
+private:
+    void processTank(float* left, float* right, int numSamples) noexcept
+    {
+        if (quality == Quality::eco)
+            processBlock<8>(left, right, numSamples);
+        else
+            processBlock<16>(left, right, numSamples);
+    }
+
+    // Sub-block length; must stay below the shortest line (8ms minus modulation)
+    static constexpr int subBlockSize = 32;
+
+    using LineArray = std::array<float, maxLines>;
+    using Row = std::array<float, subBlockSize>;
+
+    static constexpr double maxLineSeconds = 0.1;
+    static constexpr double maxModulationSeconds = 0.001;
+    static constexpr float lengthSpread = 3.0f;       // Longest / shortest line
+    static constexpr float lengthGlide = 0.002f;      // Per-sample slew towards new lengths
+    static constexpr float outputScale = 3.0f;        // Wet level in line with juce::dsp::Reverb
+
+    // Row k of the Sylvester Hadamard matrix: (-1)^popcount(i & k)
+    static float hadamardSign(int row, int column) noexcept
+    {
+        int bits = row & column;
+        int parity = 0;
+
+        while (bits != 0)
+        {
+            parity ^= bits & 1;
+            bits >>= 1;
+        }
+
+        return parity != 0 ? -1.0f : 1.0f;
+    }
+
+    void updateTargets() noexcept
+    {
+        const int numLines = getNumLines();
+        const float invSqrtN = 1.0f / std::sqrt(static_cast<float>(numLines));
+
+        // Geometric spacing, shortest line 8ms..32ms with size
+        const float shortest = static_cast<float>(sampleRate) * (0.008f + 0.024f * juce::jlimit(0.0f, 1.0f, parameters.size));
+
+        for (int i = 0; i < numLines; ++i)
+        {
+            const float position = static_cast<float>(i) / static_cast<float>(numLines - 1);
+            // Whole samples, so unmodulated reads don't low-pass through the interpolator
+            targetLengths[static_cast<size_t>(i)] = std::round(juce::jmin(shortest * std::pow(lengthSpread, position),
+                                                                          static_cast<float>(sampleRate * maxLineSeconds)));
+
+            // Distinct Hadamard rows keep the four taps decorrelated
+            inputLeft[static_cast<size_t>(i)] = hadamardSign(1, i) * invSqrtN;
+            inputRight[static_cast<size_t>(i)] = hadamardSign(2, i) * invSqrtN;
+            outputLeft[static_cast<size_t>(i)] = hadamardSign(4, i) * invSqrtN * outputScale;
+            outputRight[static_cast<size_t>(i)] = hadamardSign(7, i) * invSqrtN * outputScale;
+        }
+
+        modulationSamples = static_cast<float>(sampleRate * maxModulationSeconds)
+                            * juce::jlimit(0.0f, 1.0f, parameters.modulationDepth);
+        lfo.setFrequency(juce::jmax(0.01f, parameters.modulationRate), sampleRate);
+
+        const float width = juce::jlimit(0.0f, 1.0f, parameters.width);
+        widthDirect = 0.5f * (1.0f + width);
+        widthCross = 0.5f * (1.0f - width);
+    }
+
+    // Absorbent filter per line from its current length: DC gain hits the low RT60,
+    // Nyquist gain the high RT60 (one pole: y = gain * (1 - pole) * x + pole * y)
+    template <int N>
+    void updateLineGains() noexcept
+    {
+        const double decay = juce::jmax(0.05, static_cast<double>(parameters.decaySeconds));
+        const double highDecay = decay * (1.0 - 0.9 * juce::jlimit(0.0, 1.0, static_cast<double>(parameters.damping)));
+
+        for (int i = 0; i < N; ++i)
+        {
+            // Loop length is the read delay plus the one-sample write step
+            const double lengthSeconds = (currentLengths[static_cast<size_t>(i)] + 1.0) / sampleRate;
+            const double low = std::pow(10.0, -3.0 * lengthSeconds / decay);
+            const double high = std::pow(10.0, -3.0 * lengthSeconds / highDecay);
+            const double pole = (low - high) / (low + high);
+
+            dampingPole[static_cast<size_t>(i)] = static_cast<float>(pole);
+            dampingGain[static_cast<size_t>(i)] = static_cast<float>(low * (1.0 - pole));
+        }
+    }
+
+    // dest[t] = line[first + t], wrapping at most once
+    void copyFromLine(const float* line, int first, float* dest, int numSamples) const noexcept
+    {
+        const int start = first & lineMask;
+        const int firstRun = juce::jmin(numSamples, lineSize - start);
+        std::copy(line + start, line + start + firstRun, dest);
+        std::copy(line, line + (numSamples - firstRun), dest + firstRun);
+    }
+
+    // Butterflies on whole rows: every add/sub runs across the sub-block.
+    // Unnormalised; the 1/sqrt(N) is applied when the rows are written back.
+    template <int N>
+    void mixHadamard(int numSamples) noexcept
+    {
+        for (int span = 1; span < N; span <<= 1)
+        {
+            for (int start = 0; start < N; start += 2 * span)
+            {
+                for (int i = start; i < start + span; ++i)
+                {
+                    float* a = rows[static_cast<size_t>(i)].data();
+                    float* b = rows[static_cast<size_t>(i + span)].data();
+
+                    for (int t = 0; t < numSamples; ++t)
+                    {
+                        const float sum = a[t] + b[t];
+                        b[t] = a[t] - b[t];
+                        a[t] = sum;
+                    }
+                }
+            }
+        }
+    }
+
+    template <int N>
+    void mixHouseholder(int numSamples) noexcept
+    {
+        Row reflection {};
+
+        for (int i = 0; i < N; ++i)
+            for (int t = 0; t < numSamples; ++t)
+                reflection[static_cast<size_t>(t)] += rows[static_cast<size_t>(i)][static_cast<size_t>(t)];
+
+        const float scale = 2.0f / static_cast<float>(N);
+
+        for (int i = 0; i < N; ++i)
+            for (int t = 0; t < numSamples; ++t)
+                rows[static_cast<size_t>(i)][static_cast<size_t>(t)] -= scale * reflection[static_cast<size_t>(t)];
+    }
+
+    // Runs in sub-blocks no longer than the shortest line: everything a sub-block reads
+    // was written before it, so each stage runs across lines and time in flat loops.
+    template <int N>
+    void processBlock(float* left, float* right, int numSamples) noexcept
+    {
+        updateLineGains<N>();
+
+        const bool modulated = modulationSamples > 0.0f;
+
+        if (modulated)
+            lfo.renderQuadrature(lfoSin.data(), lfoCos.data(), numSamples, modulationSamples);
+
+        for (int offset = 0; offset < numSamples; offset += subBlockSize)
+        {
+            const int n = juce::jmin(subBlockSize, numSamples - offset);
+            const float* inL = left + offset;
+            const float* inR = right != nullptr ? right + offset : inL;
+
+            // Read every line; lengths ramp linearly across the sub-block towards their targets
+            for (int i = 0; i < N; ++i)
+            {
+                const auto index = static_cast<size_t>(i);
+                const float start = currentLengths[index];
+                const float distance = targetLengths[index] - start;
+                const bool settled = std::abs(distance) < 1.0e-3f;
+                const float step = settled ? 0.0f : distance * lengthGlide;
+                currentLengths[index] = settled ? targetLengths[index] : start + step * static_cast<float>(n);
+
+                const float* line = lines[index].data();
+                float* row = rows[index].data();
+
+                // Half the lines are modulated, at four LFO phases: +sin, +cos, -sin, -cos
+                const bool lineModulated = modulated && (i & 4) != 0;
+
+                if (settled && ! lineModulated)
+                {
+                    // Whole-sample length: a straight copy
+                    copyFromLine(line, writePosition - static_cast<int>(targetLengths[index]), row, n);
+                    continue;
+                }
+
+                const float* lfoValues = ((i & 1) != 0 ? lfoCos.data() : lfoSin.data()) + offset;
+                const float lfoSign = lineModulated ? ((i & 2) != 0 ? -1.0f : 1.0f) : 0.0f;
+
+                // Read positions first (vectorises), then the gather
+                for (int t = 0; t < n; ++t)
+                {
+                    const float delay = start + step * static_cast<float>(t) + lfoSign * lfoValues[t];
+                    const int whole = static_cast<int>(delay);
+                    readIndex[static_cast<size_t>(t)] = writePosition + t - whole;
+                    readFraction[static_cast<size_t>(t)] = delay - static_cast<float>(whole);
+                }
+
+                // Linear interpolation between the two samples around each delay
+                for (int t = 0; t < n; ++t)
+                {
+                    const int newest = readIndex[static_cast<size_t>(t)];
+                    const float newer = line[newest & lineMask];
+                    const float older = line[(newest - 1) & lineMask];
+                    row[t] = newer + readFraction[static_cast<size_t>(t)] * (older - newer);
+                }
+            }
+
+            // Absorbent filters: recursive in time, so the lines are the inner (vector) loop
+            LineArray state = dampingState;
+
+            for (int t = 0; t < n; ++t)
+            {
+                for (int i = 0; i < N; ++i)
+                {
+                    const auto index = static_cast<size_t>(i);
+                    auto& y = rows[index][static_cast<size_t>(t)];
+                    state[index] = dampingGain[index] * y + dampingPole[index] * state[index];
+                    y = state[index];
+                }
+            }
+
+            dampingState = state;
+
+            // Output taps
+            Row outL {}, outR {};
+
+            for (int i = 0; i < N; ++i)
+            {
+                const auto index = static_cast<size_t>(i);
+                const float* row = rows[index].data();
+
+                for (int t = 0; t < n; ++t)
+                {
+                    outL[static_cast<size_t>(t)] += outputLeft[index] * row[t];
+                    outR[static_cast<size_t>(t)] += outputRight[index] * row[t];
+                }
+            }
+
+            float feedbackScale = 1.0f;
+
+            if (matrix == Matrix::hadamard)
+            {
+                mixHadamard<N>(n);
+                feedbackScale = 1.0f / std::sqrt(static_cast<float>(N));
+            }
+            else
+            {
+                mixHouseholder<N>(n);
+            }
+
+            // Feedback plus input taps, written in at most two contiguous runs
+            const int writeStart = (writePosition + 1) & lineMask;
+            const int firstRun = juce::jmin(n, lineSize - writeStart);
+
+            for (int i = 0; i < N; ++i)
+            {
+                const auto index = static_cast<size_t>(i);
+                const float* row = rows[index].data();
+                const float gainL = inputLeft[index], gainR = inputRight[index];
+                float* line = lines[index].data();
+
+                for (int t = 0; t < firstRun; ++t)
+                    line[writeStart + t] = feedbackScale * row[t] + gainL * inL[t] + gainR * inR[t];
+
+                for (int t = firstRun; t < n; ++t)
+                    line[t - firstRun] = feedbackScale * row[t] + gainL * inL[t] + gainR * inR[t];
+            }
+
+            writePosition = (writePosition + n) & lineMask;
+
+            float* outLeft = left + offset;
+            float* outRight = right != nullptr ? right + offset : nullptr;
+
+            for (int t = 0; t < n; ++t)
+            {
+                const auto index = static_cast<size_t>(t);
+                outLeft[t] = outL[index] * widthDirect + outR[index] * widthCross;
+
+                if (outRight != nullptr)
+                    outRight[t] = outR[index] * widthDirect + outL[index] * widthCross;
+            }
+        }
+    }
+
+    Parameters parameters;
+    Quality quality = Quality::standard;
+    Matrix matrix = Matrix::hadamard;
+    double hostSampleRate = 44100.0;
+    double sampleRate = 44100.0;  // Tank rate
+    int maxBlock = 1;
+
+    std::array<std::vector<float>, maxLines> lines;
+    int lineSize = 1;
+    int lineMask = 0;
+    int writePosition = 0;
+
+    LineArray targetLengths {}, currentLengths {};
+    LineArray dampingPole {}, dampingGain {}, dampingState {};
+    LineArray inputLeft {}, inputRight {}, outputLeft {}, outputRight {};
+    std::array<Row, maxLines> rows {};  // Per-line signal for the current sub-block
+    std::array<int, subBlockSize> readIndex {};
+    Row readFraction {};
+
+    HalfbandResampler resampler;
+    QuadratureOscillator lfo;
+    std::vector<float> lfoSin, lfoCos;
+    float modulationSamples = 0.0f;
+    float widthDirect = 1.0f, widthCross = 0.0f;
+};
@@ -0,0 +1,286 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <vector>
+
+// Runs part of a signal path at 1/2 or 1/4 of the host rate: down() decimates a block
+// through one or two polyphase FIR halfband stages, the caller processes the low-rate
+// samples in place, and up() interpolates them back to the same number of samples.
+//
+// Each stage is a 31-tap Kaiser-windowed halfband: flat (-0.4 dB) to 0.2 of its input
+// rate, 70 dB or more down from 0.33 (what would alias). Only the 16 non-trivial taps
+// are computed, at the low rate, in both directions. Odd block sizes are fine: the
+// stage phase carries over between blocks and up() replays the same schedule, so the
+// latency is a fixed whole number of samples.
+class HalfbandResampler
+{
+public:
+    static constexpr int maxStages = 2;
+    static constexpr int maxChannels = 2;
+
+    // Allocates (not on the audio thread)
+    void prepare(int numChannels, int maximumBlockSize)
+    {
+        channels = juce::jlimit(1, maxChannels, numChannels);
+        int blockSize = juce::jmax(1, maximumBlockSize);
+
+        for (auto& stage : stages)
+        {
+            // The decimated block can be one sample longer when the phase is carried
+            const int lowSize = blockSize / 2 + 1;
+            stage.allocate(blockSize, lowSize);
+            blockSize = lowSize;
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& stage : stages)
+            stage.clear();
+    }
+
+    // 0 = pass-through, 1 = half rate, 2 = quarter rate. Resets the filter state.
+    void setNumStages(int newNumStages) noexcept
+    {
+        newNumStages = juce::jlimit(0, maxStages, newNumStages);
+
+        if (newNumStages != numStages)
+        {
+            numStages = newNumStages;
+            reset();
+        }
+    }
+
+    int getNumStages() const noexcept { return numStages; }
+    int getFactor() const noexcept { return 1 << numStages; }
+
+    // Delay of down() + up() in host-rate samples: each stage adds 30 samples at its input rate
+    int getLatencySamples() const noexcept
+    {
+        int latency = 0;
+
+        for (int stage = 0; stage < numStages; ++stage)
+            latency += stageLatency << stage;
+
+        return latency;
+    }
+
+    // Decimates numSamples of input; returns the number of low-rate samples now in getLowRate()
+    int down(const float* const* input, int numChannels, int numSamples) noexcept
+    {
+        jassert(numChannels <= channels);
+        numChannels = juce::jmin(numChannels, channels);
+
+        int count = numSamples;
+
+        for (int index = 0; index < numStages; ++index)
+        {
+            auto& stage = stages[static_cast<size_t>(index)];
+            const float* const* source = index == 0 ? input : stages[static_cast<size_t>(index - 1)].pointers.data();
+
+            count = stage.decimate(source, numChannels, count);
+        }
+
+        return count;
+    }
+
+    // Low-rate channel buffers filled by down(), processed in place by the caller
+    float* const* getLowRate() noexcept
+    {
+        jassert(numStages > 0);
+        return stages[static_cast<size_t>(juce::jmax(0, numStages - 1))].pointers.data();
+    }
+
+    // Interpolates the processed low-rate samples back into output (the numSamples given to down())
+    void up(float* const* output, int numChannels, int numSamples) noexcept
+    {
+        numChannels = juce::jmin(numChannels, channels);
+
+        for (int index = numStages - 1; index >= 0; --index)
+        {
+            auto& stage = stages[static_cast<size_t>(index)];
+            float* const* destination = index == 0 ? output : stages[static_cast<size_t>(index - 1)].pointers.data();
+            jassert(index > 0 || stage.inputCount == numSamples);
+            stage.interpolate(destination, numChannels, stage.inputCount);
+        }
+
+        juce::ignoreUnused(numSamples);
+    }
+
+private:
+    // 31-tap halfband: centre tap 0.5, the 16 odd taps below, every other tap zero
+    static constexpr int numTaps = 16;
+    static constexpr int stageLatency = 2 * numTaps - 2;
+    using Kernel = std::array<float, numTaps>;
+
+    // Windowed sinc at the half-sample points between low-rate samples, unity DC gain
+    static Kernel makeKernel() noexcept
+    {
+        constexpr double beta = 7.0;  // Kaiser window, ~70 dB stopband
+
+        auto besselI0 = [](double x)
+        {
+            double sum = 1.0, term = 1.0;
+
+            for (int k = 1; k < 20; ++k)
+            {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+
+            return sum;
+        };
+
+        Kernel kernel {};
+        double total = 0.0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            const double t = static_cast<double>(i) - (numTaps - 1) * 0.5;  // ±0.5, ±1.5, ...
+            const double x = juce::MathConstants<double>::pi * t;
+            const double ratio = t / (numTaps * 0.5);
+            const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - ratio * ratio))) / besselI0(beta);
+            kernel[static_cast<size_t>(i)] = static_cast<float>(std::sin(x) / x * window);
+            total += kernel[static_cast<size_t>(i)];
+        }
+
+        for (auto& tap : kernel)
+            tap = static_cast<float>(tap / total);
+
+        return kernel;
+    }
+
+    static inline const Kernel kernel = makeKernel();
+
+    // Polyphase halfband, one direction each way. The work buffers hold the filter
+    // history followed by the current block, so every dot product is contiguous.
+    struct Stage
+    {
+        static constexpr int downHistory = 2 * numTaps - 2;  // Host-rate inputs kept
+        static constexpr int upHistory = numTaps - 1;        // Low-rate samples kept
+
+        std::array<std::vector<float>, maxChannels> downWork, upWork, low;
+        std::array<float*, maxChannels> pointers {};
+        std::vector<float> even, odd, mids;
+
+        int phase = 0;            // Inputs since the last decimated output (0 or 1)
+        int blockStartPhase = 0;
+        int inputCount = 0;
+        int lowCount = 0;
+
+        void allocate(int inputSize, int lowSize)
+        {
+            for (int channel = 0; channel < maxChannels; ++channel)
+            {
+                const auto index = static_cast<size_t>(channel);
+                downWork[index].assign(static_cast<size_t>(downHistory + inputSize), 0.0f);
+                upWork[index].assign(static_cast<size_t>(upHistory + lowSize), 0.0f);
+                low[index].assign(static_cast<size_t>(lowSize), 0.0f);
+                pointers[index] = low[index].data();
+            }
+
+            even.assign(static_cast<size_t>(lowSize + numTaps), 0.0f);
+            odd.assign(static_cast<size_t>(lowSize + numTaps), 0.0f);
+            mids.assign(static_cast<size_t>(lowSize), 0.0f);
+        }
+
+        void clear() noexcept
+        {
+            for (auto* work : { &downWork, &upWork })
+                for (auto& buffer : *work)
+                    std::fill(buffer.begin(), buffer.end(), 0.0f);
+
+            phase = 0;
+        }
+
+        // An output is due on every second input; the first one in this block is input
+        // index (1 - phase). Its 31-sample window starts downHistory samples earlier.
+        int decimate(const float* const* input, int numChannels, int numSamples) noexcept
+        {
+            blockStartPhase = phase;
+            inputCount = numSamples;
+            lowCount = (numSamples + phase) / 2;
+
+            const int first = 1 - phase;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                float* work = downWork[static_cast<size_t>(channel)].data();
+                float* out = low[static_cast<size_t>(channel)].data();
+                std::copy(input[channel], input[channel] + numSamples, work + downHistory);
+
+                // Split the windows into the odd-tap phase and the centre-tap phase
+                for (int q = 0; q < lowCount + numTaps - 1; ++q)
+                    even[static_cast<size_t>(q)] = work[first + 2 * q];
+
+                for (int q = 0; q < lowCount; ++q)
+                    odd[static_cast<size_t>(q)] = work[first + 2 * q + numTaps - 1];
+
+                for (int j = 0; j < lowCount; ++j)
+                    out[j] = 0.5f * odd[static_cast<size_t>(j)];
+
+                for (int k = 0; k < numTaps; ++k)
+                {
+                    const float tap = 0.5f * kernel[static_cast<size_t>(k)];
+                    const float* x = even.data() + k;
+
+                    for (int j = 0; j < lowCount; ++j)
+                        out[j] += tap * x[j];
+                }
+
+                std::copy(work + numSamples, work + numSamples + downHistory, work);
+            }
+
+            phase = (phase + numSamples) % 2;
+            return lowCount;
+        }
+
+        // Replays the decimation schedule: output ticks that produced a low-rate sample
+        // get the interpolated midpoint, the others the delayed sample (centre tap).
+        void interpolate(float* const* output, int numChannels, int numSamples) noexcept
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                float* work = upWork[static_cast<size_t>(channel)].data();
+                const float* in = low[static_cast<size_t>(channel)].data();
+                float* out = output[channel];
+                std::copy(in, in + lowCount, work + upHistory);
+
+                std::fill(mids.begin(), mids.begin() + lowCount, 0.0f);
+
+                for (int k = 0; k < numTaps; ++k)
+                {
+                    const float tap = kernel[static_cast<size_t>(k)];
+                    const float* x = work + k;
+
+                    for (int m = 0; m < lowCount; ++m)
+                        mids[static_cast<size_t>(m)] += tap * x[m];
+                }
+
+                int p = blockStartPhase;
+                int consumed = 0;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    if (++p < 2)
+                    {
+                        out[i] = work[consumed + numTaps / 2 - 1];
+                    }
+                    else
+                    {
+                        p = 0;
+                        out[i] = mids[static_cast<size_t>(consumed++)];
+                    }
+                }
+
+                std::copy(work + lowCount, work + lowCount + upHistory, work);
+            }
+        }
+    };
+
+    std::array<Stage, maxStages> stages;
+    int numStages = 0;
+    int channels = 1;
+};
@@ -0,0 +1,209 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+// Multichannel fractional delay line for modulated reads (wow/flutter, chorus, grains).
+//
+// process() takes a whole block plus one delay trajectory per channel, so every
+// channel reads at its own time-varying delay. Per-sample use (feedback loops,
+// grain taps) goes through write() and makeTap()/read(), where one tap's weights
+// serve every channel.
+//
+// Delays are in samples: after writing x[n], a read at delay d returns x[n - d]
+// (same convention as juce::dsp::DelayLine). d is clamped to [1, maximum], as the
+// 4-point kernels need one sample on the newer side.
+//
+// Storage is mirrored (each sample written twice), so the 4-point reads never wrap
+// and the kernel is branch-free.
+class ModulatedDelayLine
+{
+public:
+    enum class Interpolation
+    {
+        lagrange3rd,  // Same response as juce::dsp::DelayLine's Lagrange3rd
+        hermite       // Catmull-Rom: slightly brighter, slightly cheaper
+    };
+
+    // Precomputed read position and weights for one delay value
+    struct Tap
+    {
+        int index = 0;
+        float weights[4] {};
+    };
+
+    // Allocates (not on the audio thread). Blocks longer than maximumBlockSize are split.
+    void prepare(int numChannels, int maximumDelaySamples, int maximumBlockSize)
+    {
+        maxDelay = juce::jmax(1, maximumDelaySamples);
+        maxBlock = juce::jmax(1, maximumBlockSize);
+        size = juce::nextPowerOfTwo(maxDelay + maxBlock + 4);
+        mask = size - 1;
+
+        buffers.resize(static_cast<size_t>(juce::jmax(1, numChannels)));
+
+        for (auto& channelBuffer : buffers)
+            channelBuffer.assign(static_cast<size_t>(2 * size), 0.0f);
+
+        clampedDelays.assign(static_cast<size_t>(maxBlock), 0.0f);
+        tapWeights.assign(static_cast<size_t>(4 * maxBlock), 0.0f);
+        tapIndices.assign(static_cast<size_t>(maxBlock), 0);
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& channelBuffer : buffers)
+            std::fill(channelBuffer.begin(), channelBuffer.end(), 0.0f);
+
+        writePosition = 0;
+    }
+
+    void setInterpolation(Interpolation newInterpolation) noexcept { interpolation = newInterpolation; }
+
+    int getNumChannels() const noexcept { return static_cast<int>(buffers.size()); }
+    int getMaximumDelaySamples() const noexcept { return maxDelay; }
+
+    // In place: channels[ch][i] = line read at delayTrajectories[ch][i] after writing the block
+    void process(float* const* channels, const float* const* delayTrajectories, int numChannels, int numSamples) noexcept
+    {
+        jassert(numChannels <= getNumChannels());
+
+        for (int offset = 0; offset < numSamples; offset += maxBlock)
+        {
+            const int n = juce::jmin(maxBlock, numSamples - offset);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                float* data = channels[channel] + offset;
+                const float* delays = delayTrajectories[channel] + offset;
+                float* line = buffers[static_cast<size_t>(channel)].data();
+
+                // Write the whole block first: every read is at least one sample old
+                for (int i = 0; i < n; ++i)
+                {
+                    const int index = (writePosition + 1 + i) & mask;
+                    line[index] = data[i];
+                    line[index + size] = data[i];
+                }
+
+                if (interpolation == Interpolation::lagrange3rd)
+                    readBlock<Interpolation::lagrange3rd>(line, delays, data, n);
+                else
+                    readBlock<Interpolation::hermite>(line, delays, data, n);
+            }
+
+            writePosition = (writePosition + n) & mask;
+        }
+    }
+
+    // Per-sample write of one frame (one sample per channel)
+    void write(const float* frame, int numChannels) noexcept
+    {
+        writePosition = (writePosition + 1) & mask;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto& line = buffers[static_cast<size_t>(channel)];
+            line[static_cast<size_t>(writePosition)] = frame[channel];
+            line[static_cast<size_t>(writePosition + size)] = frame[channel];
+        }
+    }
+
+    // Tap relative to the last frame passed to write()
+    Tap makeTap(float delaySamples) const noexcept
+    {
+        Tap tap;
+        tap.index = tapIndex(writePosition, delaySamples, tap.weights);
+        return tap;
+    }
+
+    float read(int channel, const Tap& tap) const noexcept
+    {
+        const float* x = buffers[static_cast<size_t>(channel)].data() + tap.index;
+        return x[0] * tap.weights[0] + x[1] * tap.weights[1] + x[2] * tap.weights[2] + x[3] * tap.weights[3];
+    }
+
+private:
+    // Start of the 4 samples around newest - delay (oldest first), plus their weights
+    int tapIndex(int newest, float delaySamples, float* weights) const noexcept
+    {
+        const float d = juce::jlimit(1.0f, static_cast<float>(maxDelay), delaySamples);
+        const int whole = static_cast<int>(d);
+        const float f = d - static_cast<float>(whole);
+
+        if (interpolation == Interpolation::lagrange3rd)
+            lagrangeWeights(f, weights);
+        else
+            hermiteWeights(f, weights);
+
+        return (newest - whole - 2) & mask;
+    }
+
+    // Points oldest first at delays whole+2, whole+1, whole, whole-1; f = 0 returns delay `whole`
+    static void lagrangeWeights(float f, float* w) noexcept
+    {
+        const float fp1 = f + 1.0f, fm1 = f - 1.0f, fm2 = f - 2.0f;
+        w[0] = fp1 * f * fm1 * (1.0f / 6.0f);
+        w[1] = -fp1 * f * fm2 * 0.5f;
+        w[2] = fp1 * fm1 * fm2 * 0.5f;
+        w[3] = -f * fm1 * fm2 * (1.0f / 6.0f);
+    }
+
+    static void hermiteWeights(float f, float* w) noexcept
+    {
+        const float f2 = f * f, f3 = f2 * f;
+        w[0] = 0.5f * (f3 - f2);
+        w[1] = 0.5f * (-3.0f * f3 + 4.0f * f2 + f);
+        w[2] = 0.5f * (3.0f * f3 - 5.0f * f2 + 2.0f);
+        w[3] = 0.5f * (-f3 + 2.0f * f2 - f);
+    }
+
+    // Three passes over the block: clamp the delays, split them into read positions and
+    // weights (both vectorise), then the 4-point gathers, which stay scalar loads.
+    // Each sample's four weights are stored together, next to each other.
+    template <Interpolation kernel>
+    void readBlock(const float* line, const float* delays, float* out, int numSamples) noexcept
+    {
+        const float maximum = static_cast<float>(maxDelay);
+        const int first = writePosition + 1;  // Locals: the index stores could alias the members
+        const int wrap = mask;
+        float* d = clampedDelays.data();
+        float* w = tapWeights.data();
+        int* start = tapIndices.data();
+
+        for (int i = 0; i < numSamples; ++i)
+            d[i] = juce::jlimit(1.0f, maximum, delays[i]);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int whole = static_cast<int>(d[i]);
+            const float f = d[i] - static_cast<float>(whole);
+
+            if constexpr (kernel == Interpolation::lagrange3rd)
+                lagrangeWeights(f, w + 4 * i);
+            else
+                hermiteWeights(f, w + 4 * i);
+
+            start[i] = (first + i - whole - 2) & wrap;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float* x = line + start[i];
+            const float* wi = w + 4 * i;
+            out[i] = x[0] * wi[0] + x[1] * wi[1] + x[2] * wi[2] + x[3] * wi[3];
+        }
+    }
+
+    std::vector<std::vector<float>> buffers;
+    std::vector<float> clampedDelays, tapWeights;  // readBlock() scratch: maxBlock delays, 4 weights each
+    std::vector<int> tapIndices;
+    Interpolation interpolation = Interpolation::lagrange3rd;
+
+    int maxDelay = 1;
+    int maxBlock = 1;
+    int size = 1;
+    int mask = 0;
+    int writePosition = 0;  // Index of the newest frame
+};
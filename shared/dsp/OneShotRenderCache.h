@@ -0,0 +1,358 @@
+#pragma once
+#include <juce_events/juce_events.h>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+// Background pre-render cache for deterministic one-shot voices (kicks, toms).
+//
+// Once per block the audio thread reports a hash of the parameters that shape
+// the sound. While the hash keeps changing the cache is invalid and hits are
+// synthesised live. Once it has been stable for the settle time, the owning
+// TimeSliceThread renders the one-shot for each recently played key, and later
+// hits stream the cached buffer instead.
+//
+// Velocity and level only scale these voices linearly, so a single layer is
+// rendered at full scale and playback applies the gain.
+//
+// Audio thread: setParameterHash(), start(), Playback::nextSample().
+// Everything else: prepare()/releaseStorage() with the render thread stopped
+// or the client removed from it.
+class OneShotRenderCache : public juce::TimeSliceClient
+{
+public:
+    // Renders one full-scale hit for key into dest (called on the render thread).
+    // Returns the number of samples written, or -1 if the hit doesn't fit.
+    using RenderFunction = std::function<int(int key, float* dest, int maxSamples)>;
+
+    struct Slot;
+
+    // A cached hit being played back by a voice. Holds a claim on its slot until it
+    // finishes, stop() is called, it is assigned over or destroyed; move-only, so only
+    // one Playback ever releases a claim. Must not outlive the cache.
+    class Playback
+    {
+    public:
+        Playback() = default;
+        ~Playback() { stop(); }
+
+        Playback(Playback&& other) noexcept { take(other); }
+
+        Playback& operator=(Playback&& other) noexcept
+        {
+            if (this != &other)
+            {
+                stop();
+                take(other);
+            }
+
+            return *this;
+        }
+
+        Playback(const Playback&) = delete;
+        Playback& operator=(const Playback&) = delete;
+
+        bool isActive() const noexcept { return slot != nullptr; }
+
+        float nextSample() noexcept
+        {
+            jassert(isActive());
+            const float sample = data[position++];
+
+            if (position >= length)
+                stop();
+
+            return sample;
+        }
+
+        void stop() noexcept
+        {
+            if (slot != nullptr)
+                slot->users.fetch_sub(1);
+
+            slot = nullptr;
+        }
+
+    private:
+        friend class OneShotRenderCache;
+
+        // Moves other's claim here and leaves other inactive
+        void take(Playback& other) noexcept
+        {
+            slot = other.slot;
+            data = other.data;
+            length = other.length;
+            position = other.position;
+            other.slot = nullptr;
+        }
+
+        Slot* slot = nullptr;
+        const float* data = nullptr;
+        int length = 0;
+        int position = 0;
+    };
+
+    struct Slot
+    {
+        enum State { free, rendering, ready };
+
+        std::vector<float> samples;
+        std::atomic<int> state { free };
+        std::atomic<int> users { 0 };
+        std::atomic<int> key { -1 };
+        std::atomic<juce::uint32> generation { 0 };
+        std::atomic<int> length { 0 };
+    };
+
+    OneShotRenderCache(int maxKeysToCache, RenderFunction renderFunction)
+        : maxKeys(maxKeysToCache)
+        , render(std::move(renderFunction))
+        , wantedKeys(static_cast<size_t>(maxKeysToCache))
+        , slots(static_cast<size_t>(maxKeysToCache * 2))
+        , tooLong(static_cast<size_t>(maxKeysToCache))
+    {
+        for (auto& key : wantedKeys)
+            key.store(-1);
+    }
+
+    // Allocates slot storage. Call with the render thread not using this client.
+    void prepare(double sampleRate, double maxLengthSeconds, double settleSeconds = 0.2)
+    {
+        maxSamples = juce::jmax(1, static_cast<int>(sampleRate * maxLengthSeconds));
+        settleSamples = static_cast<int>(sampleRate * settleSeconds);
+
+        for (auto& slot : slots)
+        {
+            slot.samples.assign(static_cast<size_t>(maxSamples), 0.0f);
+            slot.state.store(Slot::free);
+            slot.users.store(0);
+        }
+
+        lastHash = 0;
+        settleCountdown = settleSamples;
+        generation.store(generation.load() + 1);
+        settledGeneration.store(0);
+    }
+
+    void releaseStorage()
+    {
+        for (auto& slot : slots)
+        {
+            slot.state.store(Slot::free);
+            std::vector<float>().swap(slot.samples);
+        }
+    }
+
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled); }
+    bool isEnabled() const noexcept { return enabled.load(); }
+
+    // Audio thread, once per block before any start() calls
+    void setParameterHash(juce::uint64 hash, int numSamples) noexcept
+    {
+        if (hash != lastHash)
+        {
+            // Knob moving: invalidate cached hits, new hits synthesise live
+            lastHash = hash;
+            settleCountdown = settleSamples;
+            generation.store(generation.load() + 1);
+            settledGeneration.store(0);
+            return;
+        }
+
+        if (settleCountdown > 0)
+        {
+            settleCountdown -= numSamples;
+
+            if (settleCountdown <= 0)
+                settledGeneration.store(generation.load());
+        }
+    }
+
+    // Audio thread: returns an active Playback if key has a valid cached hit,
+    // otherwise an inactive one (the caller synthesises live).
+    Playback start(int key) noexcept
+    {
+        Playback playback;
+
+        if (!enabled.load())
+            return playback;
+
+        markWanted(key);
+
+        const auto currentGeneration = generation.load();
+
+        for (auto& slot : slots)
+        {
+            if (slot.state.load() != Slot::ready || slot.key != key || slot.generation != currentGeneration)
+                continue;
+
+            // Claim, then re-check that the render thread didn't take it back meanwhile.
+            // It may also have re-rendered it for another key or generation in between
+            // (ready -> rendering -> ready), so the whole match is checked again.
+            slot.users.fetch_add(1);
+
+            if (slot.state.load() != Slot::ready || slot.key != key || slot.generation != currentGeneration)
+            {
+                slot.users.fetch_sub(1);
+                continue;
+            }
+
+            playback.slot = &slot;
+            playback.data = slot.samples.data();
+            playback.length = slot.length.load();
+            playback.position = 0;
+
+            if (playback.length <= 0)
+                playback.stop();
+
+            break;
+        }
+
+        return playback;
+    }
+
+    // Hashing helper for the parameters that shape a voice
+    static juce::uint64 hashValues(std::initializer_list<float> values) noexcept
+    {
+        juce::uint64 hash = 14695981039346656037ull;  // FNV-1a
+
+        for (auto value : values)
+        {
+            juce::uint32 bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Render thread
+    int useTimeSlice() override
+    {
+        const auto targetGeneration = settledGeneration.load();
+
+        if (!enabled.load() || targetGeneration == 0 || targetGeneration != generation.load())
+            return 20;
+
+        for (size_t i = 0; i < wantedKeys.size(); ++i)
+        {
+            const int key = wantedKeys[i].load();
+
+            if (key < 0 || hasReadySlot(key, targetGeneration))
+                continue;
+
+            // Already known not to fit with these settings
+            if (tooLong[i].key == key && tooLong[i].generation == targetGeneration)
+                continue;
+
+            auto* slot = claimSlotForRendering(targetGeneration);
+
+            if (slot == nullptr)
+                break;
+
+            const int length = render(key, slot->samples.data(), maxSamples);
+
+            // Parameters moved while rendering, or the hit is too long to cache
+            if (length < 0 || generation.load() != targetGeneration)
+            {
+                if (length < 0)
+                    tooLong[i] = { key, targetGeneration };
+
+                slot->state.store(Slot::free);
+                continue;
+            }
+
+            slot->key.store(key);
+            slot->generation.store(targetGeneration);
+            slot->length.store(length);
+            slot->state.store(Slot::ready);
+        }
+
+        return 20;
+    }
+
+private:
+    void markWanted(int key) noexcept
+    {
+        for (auto& wanted : wantedKeys)
+            if (wanted.load() == key)
+                return;
+
+        // Replace round-robin once all entries are in use
+        wantedKeys[static_cast<size_t>(nextWantedIndex)].store(key);
+        nextWantedIndex = (nextWantedIndex + 1) % maxKeys;
+    }
+
+    bool isWanted(int key) const noexcept
+    {
+        for (auto& wanted : wantedKeys)
+            if (wanted.load() == key)
+                return true;
+
+        return false;
+    }
+
+    bool hasReadySlot(int key, juce::uint32 targetGeneration) const noexcept
+    {
+        for (auto& slot : slots)
+            if (slot.state.load() == Slot::ready && slot.key == key && slot.generation == targetGeneration)
+                return true;
+
+        return false;
+    }
+
+    Slot* claimSlotForRendering(juce::uint32 targetGeneration) noexcept
+    {
+        for (auto& slot : slots)
+        {
+            int expected = Slot::free;
+
+            if (slot.state.compare_exchange_strong(expected, Slot::rendering))
+                return &slot;
+        }
+
+        // Reuse a stale or unwanted hit that no voice is playing
+        for (auto& slot : slots)
+        {
+            if (slot.generation.load() == targetGeneration && isWanted(slot.key.load()))
+                continue;
+
+            int expected = Slot::ready;
+
+            if (!slot.state.compare_exchange_strong(expected, Slot::rendering))
+                continue;
+
+            if (slot.users.load() == 0)
+                return &slot;
+
+            slot.state.store(Slot::ready);
+        }
+
+        return nullptr;
+    }
+
+    const int maxKeys;
+    RenderFunction render;
+
+    std::vector<std::atomic<int>> wantedKeys;
+    int nextWantedIndex = 0;  // Audio thread only
+
+    std::vector<Slot> slots;
+    int maxSamples = 0;
+
+    // Render thread only: keys whose hit exceeded maxSamples for a generation
+    struct UncacheableKey { int key = -1; juce::uint32 generation = 0; };
+    std::vector<UncacheableKey> tooLong;
+
+    // Audio-thread settle tracking
+    juce::uint64 lastHash = 0;
+    int settleSamples = 0;
+    int settleCountdown = 0;
+
+    std::atomic<juce::uint32> generation { 1 };
+    std::atomic<juce::uint32> settledGeneration { 0 };  // 0 = parameters still moving
+    std::atomic<bool> enabled { true };
+
+    JUCE_DECLARE_NON_COPYABLE(OneShotRenderCache)
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+
+// Recursive sine LFO: rotates a (sin, cos) pair by a fixed angle each sample, so a
+// block costs four multiplies per sample instead of a std::sin call. render() and
+// renderAdd() keep four rotations in flight, each a sample apart and stepping four
+// samples at a time, so they do not wait on one rotation after another.
+//
+// The rotation is exact but rounding slowly changes the amplitude; render() corrects
+// it once per block. Changing the frequency keeps the phase (no clicks in modulation).
+class QuadratureOscillator
+{
+public:
+    void setFrequency(double frequencyHz, double sampleRate) noexcept
+    {
+        const double angle = juce::MathConstants<double>::twoPi * frequencyHz / sampleRate;
+        cosDelta = std::cos(angle);
+        sinDelta = std::sin(angle);
+        cosDeltaLanes = std::cos(numLanes * angle);
+        sinDeltaLanes = std::sin(numLanes * angle);
+    }
+
+    void setPhase(double radians) noexcept
+    {
+        sinValue = std::sin(radians);
+        cosValue = std::cos(radians);
+    }
+
+    double getSin() const noexcept { return sinValue; }
+    double getCos() const noexcept { return cosValue; }
+
+    // dest[i] = depth * sin(phase + i * angle)
+    void render(float* dest, int numSamples, float depth) noexcept
+    {
+        process<false>(dest, numSamples, depth);
+    }
+
+    // dest[i] += depth * sin(phase + i * angle)
+    void renderAdd(float* dest, int numSamples, float depth) noexcept
+    {
+        process<true>(dest, numSamples, depth);
+    }
+
+    // sinDest[i] = depth * sin(...), cosDest[i] = depth * cos(...): two LFOs 90 degrees apart
+    void renderQuadrature(float* sinDest, float* cosDest, int numSamples, float depth) noexcept
+    {
+        double s = sinValue;
+        double c = cosValue;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            sinDest[i] = depth * static_cast<float>(s);
+            cosDest[i] = depth * static_cast<float>(c);
+
+            const double nextSin = s * cosDelta + c * sinDelta;
+            c = c * cosDelta - s * sinDelta;
+            s = nextSin;
+        }
+
+        normalise(s, c);
+    }
+
+private:
+    // First-order pull back onto the unit circle
+    void normalise(double s, double c) noexcept
+    {
+        const double correction = 1.5 - 0.5 * (s * s + c * c);
+        sinValue = s * correction;
+        cosValue = c * correction;
+    }
+
+    static constexpr int numLanes = 4;
+
+    template <bool accumulate>
+    static void write(float* dest, float depth, double value) noexcept
+    {
+        if constexpr (accumulate)
+            *dest += depth * static_cast<float>(value);
+        else
+            *dest = depth * static_cast<float>(value);
+    }
+
+    template <bool accumulate>
+    void process(float* dest, int numSamples, float depth) noexcept
+    {
+        // Lane j starts j samples ahead
+        double s[numLanes], c[numLanes];
+        s[0] = sinValue;
+        c[0] = cosValue;
+
+        for (int lane = 1; lane < numLanes; ++lane)
+        {
+            s[lane] = s[lane - 1] * cosDelta + c[lane - 1] * sinDelta;
+            c[lane] = c[lane - 1] * cosDelta - s[lane - 1] * sinDelta;
+        }
+
+        int i = 0;
+
+        for (; i + numLanes <= numSamples; i += numLanes)
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                write<accumulate>(dest + i + lane, depth, s[lane]);
+
+                const double nextSin = s[lane] * cosDeltaLanes + c[lane] * sinDeltaLanes;
+                c[lane] = c[lane] * cosDeltaLanes - s[lane] * sinDeltaLanes;
+                s[lane] = nextSin;
+            }
+        }
+
+        // Lane 0 is at sample i: the rest one sample at a time
+        double sRest = s[0];
+        double cRest = c[0];
+
+        for (; i < numSamples; ++i)
+        {
+            write<accumulate>(dest + i, depth, sRest);
+
+            const double nextSin = sRest * cosDelta + cRest * sinDelta;
+            cRest = cRest * cosDelta - sRest * sinDelta;
+            sRest = nextSin;
+        }
+
+        normalise(sRest, cRest);
+    }
+
+    double sinValue = 0.0, cosValue = 1.0;
+    double sinDelta = 0.0, cosDelta = 1.0;
+    double sinDeltaLanes = 0.0, cosDeltaLanes = 1.0;  // Rotation by numLanes samples
+};
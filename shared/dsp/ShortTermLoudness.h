@@ -0,0 +1,162 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include "BiquadCascade.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Short-term loudness (ITU-R BS.1770-4 K-weighting, EBU R128 400ms window).
+//
+// Each channel is K-weighted a block at a time (high shelf then high-pass, one
+// BiquadCascade stage each) and its squares summed into 10ms bins. A ring of 40
+// bins holds the window, and a running sum adds the bin that completes and drops
+// the one it replaces, so a reading costs nothing however long the window is.
+// The sum is rebuilt from the bins once per lap to shed rounding drift.
+// Channel weights are 1 (mono or stereo). Nothing allocates after prepare().
+class ShortTermLoudness
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr int numBins = 40;  // 400ms in 10ms steps
+
+    // Allocates (not on the audio thread)
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels)
+    {
+        channels = juce::jlimit(1, maxChannels, numChannels);
+        maxBlock = juce::jmax(1, maximumBlockSize);
+        binLength = juce::jmax(1, juce::roundToInt(0.01 * sampleRate));
+
+        for (auto& filter : filters)
+        {
+            filter.setStage(0, makeShelf(sampleRate));
+            filter.setStage(1, makeHighPass(sampleRate));
+        }
+
+        scratch.assign(static_cast<size_t>(maxBlock), 0.0f);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& filter : filters)
+            filter.reset();
+
+        bins.fill(0.0);
+        runningSum = 0.0;
+        binSum = 0.0;
+        binFill = 0;
+        nextBin = 0;
+    }
+
+    // Feeds a block; returns true if a 10ms step completed (the reading moved)
+    bool process(const float* const* data, int numChannels, int numSamples) noexcept
+    {
+        numChannels = juce::jmin(numChannels, channels);
+        bool stepped = false;
+
+        for (int offset = 0; offset < numSamples;)
+        {
+            const int n = juce::jmin(numSamples - offset, maxBlock, binLength - binFill);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                std::copy(data[channel] + offset, data[channel] + offset + n, scratch.begin());
+                filters[static_cast<size_t>(channel)].process(scratch.data(), n);
+                binSum += sumOfSquares(scratch.data(), n);
+            }
+
+            offset += n;
+            binFill += n;
+
+            if (binFill == binLength)
+            {
+                runningSum += binSum - bins[static_cast<size_t>(nextBin)];
+                bins[static_cast<size_t>(nextBin)] = binSum;
+                nextBin = (nextBin + 1) % numBins;
+                binSum = 0.0;
+                binFill = 0;
+                stepped = true;
+
+                if (nextBin == 0)
+                {
+                    runningSum = 0.0;
+
+                    for (const auto bin : bins)
+                        runningSum += bin;
+                }
+            }
+        }
+
+        return stepped;
+    }
+
+    // Channel-summed mean square of the K-weighted signal over the last 400ms
+    // (reads low for the first 400ms after a reset)
+    double getMeanSquare() const noexcept
+    {
+        return juce::jmax(0.0, runningSum) / static_cast<double>(binLength * numBins);
+    }
+
+    // LUFS, floored at -100 for silence
+    float getLoudness() const noexcept { return loudnessFromMeanSquare(getMeanSquare()); }
+
+    static float loudnessFromMeanSquare(double meanSquare) noexcept
+    {
+        return meanSquare > 1.0e-10 ? juce::jmax(-100.0f, static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare))) : -100.0f;
+    }
+
+private:
+    // Four partial sums: independent chains the compiler can keep in one vector register
+    static double sumOfSquares(const float* data, int numSamples) noexcept
+    {
+        float partial[4] {};
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            for (int lane = 0; lane < 4; ++lane)
+                partial[lane] += data[i + lane] * data[i + lane];
+
+        for (; i < numSamples; ++i)
+            partial[0] += data[i] * data[i];
+
+        return static_cast<double>(partial[0] + partial[1]) + static_cast<double>(partial[2] + partial[3]);
+    }
+
+    // BS.1770 pre-filter (head response), from its analogue prototype so it matches
+    // the published 48kHz coefficients and holds at every other rate
+    static std::array<float, 6> makeShelf(double sampleRate) noexcept
+    {
+        const double k = std::tan(juce::MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+        const double q = 0.7071752369554196;
+        const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+
+        return { static_cast<float>(vh + vb * k / q + k * k), static_cast<float>(2.0 * (k * k - vh)),
+                 static_cast<float>(vh - vb * k / q + k * k), static_cast<float>(1.0 + k / q + k * k),
+                 static_cast<float>(2.0 * (k * k - 1.0)), static_cast<float>(1.0 - k / q + k * k) };
+    }
+
+    // BS.1770 RLB weighting: second-order high-pass at 38Hz. The standard keeps the
+    // numerator at {1, -2, 1} (unnormalised), so it is scaled by a0 here to survive
+    // setStage()'s normalisation.
+    static std::array<float, 6> makeHighPass(double sampleRate) noexcept
+    {
+        const double k = std::tan(juce::MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+        const double q = 0.5003270373238773;
+        const double a0 = 1.0 + k / q + k * k;
+
+        return { static_cast<float>(a0), static_cast<float>(-2.0 * a0), static_cast<float>(a0), static_cast<float>(a0),
+                 static_cast<float>(2.0 * (k * k - 1.0)), static_cast<float>(1.0 - k / q + k * k) };
+    }
+
+    std::array<BiquadCascade<float, 2>, maxChannels> filters;
+    std::vector<float> scratch;
+    std::array<double, numBins> bins {};  // Sum of squares per 10ms bin, all channels
+    double runningSum = 0.0;
+    double binSum = 0.0;  // Bin being filled
+    int binFill = 0;
+    int nextBin = 0;
+    int binLength = 480;
+    int channels = maxChannels;
+    int maxBlock = 1;
+};
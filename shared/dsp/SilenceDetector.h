@@ -0,0 +1,137 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Lets a processor sleep while it has nothing left to play.
+//
+// Each input block goes through update() along with the processor's current tail
+// (how long its output keeps ringing after the input stops). Once the input has
+// stayed below the threshold for longer than the tail, the output is below it too:
+// update() returns enteringSleep for one block (reset the DSP there, so the next
+// sound starts from true silence instead of a -90 dB residue) and sleeping after
+// that, until a block crosses the threshold again. Sleeping blocks only clear the
+// output. Effects with feedback that can sustain itself report an infinite tail
+// and never sleep.
+class SilenceDetector
+{
+public:
+    enum class State
+    {
+        processing,
+        enteringSleep,  // First silent block after the tail: reset the DSP, clear the output
+        sleeping        // Clear the output
+    };
+
+    static constexpr float defaultThresholdDb = -90.0f;
+
+    void prepare(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    // Starts awake: the tail after a reset is always processed
+    void reset() noexcept
+    {
+        silentSamples = 0;
+        asleep = false;
+    }
+
+    void setThresholdDecibels(float newThresholdDb) noexcept
+    {
+        threshold = std::pow(10.0f, newThresholdDb / 20.0f);
+    }
+
+    // Tail changes apply to the silence already counted (a longer decay wakes nothing,
+    // it only delays the next sleep)
+    void setTailSeconds(double seconds) noexcept
+    {
+        const double samples = std::ceil(juce::jmax(0.0, seconds) * sampleRate);
+        tailSamples = samples < 1.0e15 ? static_cast<int64_t>(samples) : std::numeric_limits<int64_t>::max();
+    }
+
+    State update(const float* const* channels, int numChannels, int numSamples) noexcept
+    {
+        if (!isBelowThreshold(channels, numChannels, numSamples))
+        {
+            silentSamples = 0;
+            asleep = false;
+            return State::processing;
+        }
+
+        // Sleep only once the whole block lies past the end of the tail
+        const bool tailFinished = silentSamples >= tailSamples;
+
+        if (silentSamples < std::numeric_limits<int64_t>::max() - numSamples)
+            silentSamples += numSamples;
+
+        if (!tailFinished)
+        {
+            asleep = false;
+            return State::processing;
+        }
+
+        if (asleep)
+            return State::sleeping;
+
+        asleep = true;
+        return State::enteringSleep;
+    }
+
+    bool isSleeping() const noexcept { return asleep; }
+
+    // Tail helpers, all measured down to thresholdDb from a 0 dBFS peak
+
+    // Reverb: the level falls 60 dB every rt60Seconds
+    static double reverbTailSeconds(double rt60Seconds, float thresholdDb = defaultThresholdDb) noexcept
+    {
+        return rt60Seconds * static_cast<double>(-thresholdDb) / 60.0;
+    }
+
+    // Envelope exp(-t / timeConstantSeconds)
+    static double exponentialTailSeconds(double timeConstantSeconds, float thresholdDb = defaultThresholdDb) noexcept
+    {
+        return timeConstantSeconds * static_cast<double>(-thresholdDb) / 20.0 * std::log(10.0);
+    }
+
+    // Feedback loop: each pass takes up to loopSeconds and scales the level by loopGain.
+    // A loop gain of 1 or more can sustain itself: the tail is infinite.
+    static double feedbackTailSeconds(double loopSeconds, double loopGain, float thresholdDb = defaultThresholdDb) noexcept
+    {
+        if (loopGain >= 1.0)
+            return std::numeric_limits<double>::infinity();
+
+        if (loopGain <= 0.0)
+            return loopSeconds;
+
+        const double passes = std::ceil(static_cast<double>(thresholdDb) / (20.0 * std::log10(loopGain)));
+        return loopSeconds * (passes + 1.0);
+    }
+
+private:
+    bool isBelowThreshold(const float* const* channels, int numChannels, int numSamples) const noexcept
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float* data = channels[channel];
+            int loud = 0;
+
+            // Branch-free so it vectorises; a silent block is scanned in full anyway
+            for (int i = 0; i < numSamples; ++i)
+                loud |= static_cast<int>(std::abs(data[i]) > threshold);
+
+            if (loud != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    double sampleRate = 44100.0;
+    float threshold = std::pow(10.0f, defaultThresholdDb / 20.0f);
+    int64_t tailSamples = 0;
+    int64_t silentSamples = 0;
+    bool asleep = false;
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cstdint>
+#include <vector>
+
+// Running maximum of the last N values pushed, O(1) per value whatever N is.
+//
+// Monotonic deque: it keeps only the values that can still become the maximum, in
+// decreasing order, so the front is always the answer. Each value enters and leaves
+// once (amortised two comparisons per push). The deque is a preallocated ring, so
+// push() never allocates.
+class SlidingMax
+{
+public:
+    // Allocates (not on the audio thread)
+    void prepare(int maximumWindowLength)
+    {
+        capacity = juce::jmax(1, maximumWindowLength);
+
+        // A full window plus the new value, before the expired front is dropped
+        entries.assign(static_cast<size_t>(capacity + 1), {});
+        setWindowLength(capacity);
+    }
+
+    // Clears the history
+    void setWindowLength(int newLength) noexcept
+    {
+        window = juce::jlimit(1, capacity, newLength);
+        reset();
+    }
+
+    int getWindowLength() const noexcept { return window; }
+
+    void reset() noexcept
+    {
+        head = 0;
+        size = 0;
+        time = 0;
+    }
+
+    // Adds a value; returns the maximum of the last windowLength values (fewer after a reset)
+    float push(float value) noexcept
+    {
+        // Older values no larger than the new one can never be the maximum again
+        while (size > 0 && entries[slot(size - 1)].value <= value)
+            --size;
+
+        entries[slot(size)] = { value, time };
+        ++size;
+
+        // Drop the front once it has left the window
+        if (entries[static_cast<size_t>(head)].time <= time - window)
+        {
+            head = (head + 1) % (capacity + 1);
+            --size;
+        }
+
+        ++time;
+        return entries[static_cast<size_t>(head)].value;
+    }
+
+private:
+    struct Entry
+    {
+        float value = 0.0f;
+        int64_t time = 0;
+    };
+
+    size_t slot(int index) const noexcept { return static_cast<size_t>((head + index) % (capacity + 1)); }
+
+    std::vector<Entry> entries;  // Ring: values decreasing from head, times increasing
+    int capacity = 1;
+    int window = 1;
+    int head = 0;
+    int size = 0;
+    int64_t time = 0;
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+// Block-level on/off switch for one in-place stage of a signal path.
+//
+// A stage that currently adds nothing (a filter in its centre zone, a mix at 0) is
+// not run at all. Switching it on or off crossfades between the stage's input and
+// its output over a few milliseconds, so neither the change in sound nor the cold
+// state the stage restarts from can click. When a fade-out completes, onBypassed()
+// runs: reset the stage there, so the next fade-in starts from clean state instead
+// of whatever was left when it stopped.
+//
+// The stage callable processes the channels passed to process() in place, as one
+// block. A block longer than the prepared size (or with more channels) switches
+// without a fade, as there is no room to keep its input.
+class StageBypass
+{
+public:
+    // Allocates (not on the audio thread)
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels, double fadeSeconds = 0.005)
+    {
+        maxBlock = juce::jmax(1, maximumBlockSize);
+        fadeStep = 1.0f / static_cast<float>(juce::jmax(1.0, fadeSeconds * sampleRate));
+
+        input.resize(static_cast<size_t>(juce::jmax(1, numChannels)));
+
+        for (auto& channel : input)
+            channel.assign(static_cast<size_t>(maxBlock), 0.0f);
+
+        reset(active);
+    }
+
+    // Jumps to the given state without a fade
+    void reset(bool shouldBeActive) noexcept
+    {
+        active = shouldBeActive;
+        gain = active ? 1.0f : 0.0f;
+    }
+
+    void setActive(bool shouldBeActive) noexcept { active = shouldBeActive; }
+    bool isActive() const noexcept { return active; }
+
+    // Off and faded out: process() will not call the stage
+    bool isBypassed() const noexcept { return !active && gain == 0.0f; }
+
+    template <typename Stage, typename OnBypassed>
+    void process(float* const* channels, int numChannels, int numSamples, Stage&& stage, OnBypassed&& onBypassed)
+    {
+        const float target = active ? 1.0f : 0.0f;
+
+        if (gain == target)
+        {
+            if (active)
+                stage();
+
+            return;
+        }
+
+        if (numSamples > maxBlock || numChannels > static_cast<int>(input.size()))
+        {
+            gain = target;
+
+            if (active)
+                stage();
+            else
+                onBypassed();
+
+            return;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            std::copy(channels[channel], channels[channel] + numSamples, input[static_cast<size_t>(channel)].data());
+
+        stage();
+
+        // out = in + g * (stage - in), g ramping linearly towards the target
+        const float start = gain;
+        const float step = active ? fadeStep : -fadeStep;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float* in = input[static_cast<size_t>(channel)].data();
+            float* out = channels[channel];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float g = juce::jlimit(0.0f, 1.0f, start + step * static_cast<float>(i + 1));
+                out[i] = in[i] + g * (out[i] - in[i]);
+            }
+        }
+
+        gain = juce::jlimit(0.0f, 1.0f, start + step * static_cast<float>(numSamples));
+
+        if (gain == 0.0f)
+            onBypassed();
+    }
+
+    template <typename Stage>
+    void process(float* const* channels, int numChannels, int numSamples, Stage&& stage)
+    {
+        process(channels, numChannels, numSamples, stage, [] {});
+    }
+
+private:
+    std::vector<std::vector<float>> input;
+    int maxBlock = 1;
+    float fadeStep = 1.0f;
+    float gain = 1.0f;
+    bool active = true;
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include "AdaaTanh.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// Gain into tanh, with the drive ramped per sample and the output peak measured on
+// the way, as one pass over each channel.
+//
+// Modes trade CPU for alias rejection:
+//   fast  - rational tanh at the host rate (vectorises; aliases like the plain tanh)
+//   adaa  - first-order antiderivative anti-aliasing at the host rate, half a sample late
+//   x2/x4 - rational tanh between polyphase IIR halfband stages (a few samples of
+//           frequency-dependent delay, see getLatencySamples())
+//
+// The peak of the oversampled modes is taken at the oversampled rate, so it also
+// catches the peaks between host-rate samples.
+class TanhDrive
+{
+public:
+    enum class Mode { fast, adaa, x2, x4 };
+
+    static constexpr int maxChannels = 2;
+
+    // Allocates (not on the audio thread)
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels, double rampSeconds = 0.02)
+    {
+        channels = juce::jlimit(1, maxChannels, numChannels);
+
+        for (int index = 0; index < 2; ++index)
+        {
+            oversamplers[static_cast<size_t>(index)] = std::make_unique<juce::dsp::Oversampling<float>>(
+                static_cast<size_t>(channels), static_cast<size_t>(index + 1),
+                juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, false);
+            oversamplers[static_cast<size_t>(index)]->initProcessing(static_cast<size_t>(maximumBlockSize));
+        }
+
+        for (auto& saturator : adaa)
+            saturator.prepare(maximumBlockSize);
+
+        gain.reset(sampleRate, rampSeconds);
+        reset();
+    }
+
+    // Clears the filter and ADAA state and jumps to the target drive
+    void reset() noexcept
+    {
+        for (auto& oversampler : oversamplers)
+            if (oversampler != nullptr)
+                oversampler->reset();
+
+        for (auto& saturator : adaa)
+            saturator.reset();
+
+        gain.setCurrentAndTargetValue(gain.getTargetValue());
+    }
+
+    // A new mode starts from clean state (switching clicks: not meant for automation)
+    void setMode(Mode newMode) noexcept
+    {
+        if (newMode != mode)
+        {
+            mode = newMode;
+            reset();
+        }
+    }
+
+    Mode getMode() const noexcept { return mode; }
+
+    void setDriveDecibels(float decibels) noexcept
+    {
+        gain.setTargetValue(juce::Decibels::decibelsToGain(decibels));
+    }
+
+    // Delay of the wet signal this adds, in host-rate samples (fractional)
+    float getLatencySamples() const noexcept
+    {
+        if (mode == Mode::adaa)
+            return 0.5f;
+
+        const auto& oversampler = oversamplers[mode == Mode::x4 ? 1 : 0];
+        return mode != Mode::fast && oversampler != nullptr ? oversampler->getLatencyInSamples() : 0.0f;
+    }
+
+    // In place; returns the peak magnitude of the output
+    float process(juce::dsp::AudioBlock<float>& block) noexcept
+    {
+        const int numChannels = juce::jmin(channels, static_cast<int>(block.getNumChannels()));
+        const int numSamples = static_cast<int>(block.getNumSamples());
+
+        if (numSamples == 0)
+            return 0.0f;
+
+        // The ramp is linear, so the whole block is described by its start and step
+        const float gainStart = gain.getCurrentValue();
+        const float gainEnd = gain.skip(numSamples);
+        const float gainStep = (gainEnd - gainStart) / static_cast<float>(numSamples);
+
+        float peak = 0.0f;
+
+        if (mode == Mode::fast || mode == Mode::adaa)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                float* data = block.getChannelPointer(static_cast<size_t>(channel));
+
+                peak = juce::jmax(peak, mode == Mode::fast
+                                            ? driveKernel(data, numSamples, gainStart, gainStep)
+                                            : adaa[static_cast<size_t>(channel)].process(data, numSamples, gainStart, 1.0f, gainStep));
+            }
+
+            return peak;
+        }
+
+        auto& oversampler = *oversamplers[mode == Mode::x2 ? 0 : 1];
+        const float factor = static_cast<float>(oversampler.getOversamplingFactor());
+
+        auto stereoBlock = block.getSubsetChannelBlock(0, static_cast<size_t>(numChannels));
+        auto oversampledBlock = oversampler.processSamplesUp(stereoBlock);
+        const int numOversampled = static_cast<int>(oversampledBlock.getNumSamples());
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            peak = juce::jmax(peak, driveKernel(oversampledBlock.getChannelPointer(static_cast<size_t>(channel)),
+                                                numOversampled, gainStart, gainStep / factor));
+
+        oversampler.processSamplesDown(stereoBlock);
+        return peak;
+    }
+
+    // data[i] = tanh((gain + i * gainStep) * data[i]), returns the output peak.
+    // Branch-free so it vectorises: selects for the clamp, and the peak kept as the
+    // bit pattern of |y| (ordered like the value for non-negative floats), since an
+    // integer max reduction vectorises where a float one needs -ffast-math.
+    static float driveKernel(float* data, int numSamples, float gain, float gainStep) noexcept
+    {
+        uint32_t peakBits = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Rational tanh is accurate to +-5 (tanh(5) is 1 - 9e-5)
+            float x = (gain + gainStep * static_cast<float>(i)) * data[i];
+            x = x < -5.0f ? -5.0f : x;
+            x = x > 5.0f ? 5.0f : x;
+
+            const float y = juce::dsp::FastMathApproximations::tanh(x);
+            data[i] = y;
+
+            uint32_t bits;
+            std::memcpy(&bits, &y, sizeof(bits));
+            bits &= 0x7fffffffu;
+            peakBits = bits > peakBits ? bits : peakBits;
+        }
+
+        float peak;
+        std::memcpy(&peak, &peakBits, sizeof(peak));
+        return peak;
+    }
+
+private:
+    Mode mode = Mode::fast;
+    int channels = maxChannels;
+
+    juce::SmoothedValue<float> gain { 1.0f };
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, 2> oversamplers;  // 2x, 4x
+    std::array<AdaaTanh, maxChannels> adaa;
+};
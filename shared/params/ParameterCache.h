@@ -0,0 +1,78 @@
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
+#include <initializer_list>
+#include <vector>
+
+// Typed, per-block view of a processor's parameters, without string lookups on the
+// audio thread.
+//
+// Values is a plain struct with one float, int (choice index) or bool field per
+// parameter. Each field is bound to its parameter ID once, when the processor is
+// constructed:
+//
+//   struct TapeAgeParameters { float drive; float mix; int saturationMode; bool lowLatency; };
+//
+//   ParameterCache<TapeAgeParameters> parameterCache { parameters, { { "drive", &TapeAgeParameters::drive },
+//                                                                    { "mix", &TapeAgeParameters::mix }, ... } };
+//
+// load() then fills a Values from the raw parameter values in one pass: one relaxed
+// atomic load per field and no allocation or locking, so it can run at the top of
+// processBlock (or anywhere else: it is safe on any thread). Choices are rounded to
+// their index and toggles are on above 0.5, as getRawParameterValue() callers did.
+template <typename Values>
+class ParameterCache
+{
+public:
+    class Binding
+    {
+    public:
+        Binding(const char* parameterID, float Values::* field) noexcept : id(parameterID), asFloat(field) {}
+        Binding(const char* parameterID, int Values::* field) noexcept : id(parameterID), asInt(field) {}
+        Binding(const char* parameterID, bool Values::* field) noexcept : id(parameterID), asBool(field) {}
+
+    private:
+        friend class ParameterCache;
+
+        const char* id = nullptr;
+        std::atomic<float>* source = nullptr;
+        float Values::* asFloat = nullptr;
+        int Values::* asInt = nullptr;
+        bool Values::* asBool = nullptr;
+    };
+
+    // Allocates (not on the audio thread). The state must outlive the cache.
+    ParameterCache(juce::AudioProcessorValueTreeState& state, std::initializer_list<Binding> fields)
+        : bindings(fields)
+    {
+        for (auto& binding : bindings)
+        {
+            binding.source = state.getRawParameterValue(binding.id);
+            jassert(binding.source != nullptr);  // ID missing from the parameter layout
+        }
+    }
+
+    Values load() const noexcept
+    {
+        Values values {};
+
+        for (const auto& binding : bindings)
+        {
+            const float raw = binding.source->load(std::memory_order_relaxed);
+
+            if (binding.asFloat != nullptr)
+                values.*binding.asFloat = raw;
+            else if (binding.asInt != nullptr)
+                values.*binding.asInt = juce::roundToInt(raw);
+            else
+                values.*binding.asBool = raw > 0.5f;
+        }
+
+        return values;
+    }
+
+private:
+    std::vector<Binding> bindings;
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterCache)
+};
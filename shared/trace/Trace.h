@@ -0,0 +1,265 @@
+#pragma once
+
+// Scoped stage markers for processBlock, exported as Chrome trace-event JSON
+// (chrome://tracing, ui.perfetto.dev).
+//
+//   PFS_TRACE_SESSION("TapeAge")          // processor member: exports while any instance lives
+//   PFS_TRACE_SCOPE("TapeAge", "oversample")  // a stage: from here to the end of the scope
+//
+// Off unless built with -DPFS_TRACE=ON (defines PFS_TRACE_ENABLED=1 for pfs_shared
+// users). Off, both macros expand to static_assert(true, "") and nothing is compiled in.
+//
+// On, each scope writes one complete event (category and name, which must be string
+// literals, start and duration) into its thread's ring: single producer, single
+// consumer, no locks and no allocation once the thread has its ring. Rings come from
+// a fixed pool (maxThreads of them, claimed on a thread's first event); a full ring
+// drops events and counts them. A background thread drains every ring each 50ms into
+// pfs-trace-<plugin>-<date>-<time>.json in the temp directory (or $PFS_TRACE_DIR), in
+// the JSON array format, which needs no closing bracket to load after a crash.
+
+#ifndef PFS_TRACE_ENABLED
+ #define PFS_TRACE_ENABLED 0
+#endif
+
+#if PFS_TRACE_ENABLED
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace pfs::trace
+{
+
+struct Event
+{
+    const char* category = nullptr;
+    const char* name = nullptr;
+    std::int64_t startNs = 0;
+    std::int64_t durationNs = 0;
+};
+
+inline std::int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// One thread's events: written by that thread, read by the exporter
+class Ring
+{
+public:
+    static constexpr std::uint32_t capacity = 8192;  // Power of two
+
+    void push(const Event& event) noexcept
+    {
+        const auto write = writeIndex.load(std::memory_order_relaxed);
+
+        if (write - readIndex.load(std::memory_order_acquire) >= capacity)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        events[write & (capacity - 1)] = event;
+        writeIndex.store(write + 1, std::memory_order_release);
+    }
+
+    // Exporter side: hands every pending event to the callback, oldest first
+    template <typename Callback>
+    void drain(Callback&& callback)
+    {
+        const auto write = writeIndex.load(std::memory_order_acquire);
+        auto read = readIndex.load(std::memory_order_relaxed);
+
+        for (; read != write; ++read)
+            callback(events[read & (capacity - 1)]);
+
+        readIndex.store(read, std::memory_order_release);
+    }
+
+    std::uint32_t getDropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::array<Event, capacity> events {};
+    std::atomic<std::uint32_t> writeIndex { 0 };
+    std::atomic<std::uint32_t> readIndex { 0 };
+    std::atomic<std::uint32_t> dropped { 0 };
+};
+
+// Process-wide (per plugin binary) state, constant-initialised: no guard on access
+struct Registry
+{
+    static constexpr int maxThreads = 16;
+
+    std::array<Ring, maxThreads> rings;
+    std::atomic<int> numClaimed { 0 };
+    std::atomic<bool> recording { false };
+};
+
+inline Registry registry;
+
+// The calling thread's ring, claimed on first use (nullptr once the pool is used up)
+inline Ring* getThreadRing() noexcept
+{
+    thread_local Ring* ring = []
+    {
+        const int index = registry.numClaimed.fetch_add(1, std::memory_order_relaxed);
+        return index < Registry::maxThreads ? &registry.rings[static_cast<size_t>(index)] : nullptr;
+    }();
+
+    return ring;
+}
+
+class ScopedEvent
+{
+public:
+    ScopedEvent(const char* category, const char* name) noexcept
+        : event { category, name, registry.recording.load(std::memory_order_relaxed) ? now() : -1, 0 }
+    {
+    }
+
+    ~ScopedEvent() noexcept
+    {
+        if (event.startNs < 0)
+            return;
+
+        if (auto* ring = getThreadRing())
+        {
+            event.durationNs = now() - event.startNs;
+            ring->push(event);
+        }
+    }
+
+    ScopedEvent(const ScopedEvent&) = delete;
+    ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+private:
+    Event event;
+};
+
+// Drains the rings into the trace file
+class Exporter : private juce::Thread
+{
+public:
+    explicit Exporter(const juce::String& pluginName)
+        : juce::Thread("PFS trace export")
+    {
+        const auto directory = juce::SystemStats::getEnvironmentVariable("PFS_TRACE_DIR", {});
+        const auto folder = directory.isNotEmpty() ? juce::File(directory)
+                                                   : juce::File::getSpecialLocation(juce::File::tempDirectory);
+        file = folder.getChildFile("pfs-trace-" + pluginName + "-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+        stream = std::make_unique<juce::FileOutputStream>(file);
+
+        if (stream->openedOk())
+        {
+            stream->setPosition(0);
+            stream->truncate();
+            *stream << "[\n";
+        }
+
+        origin = now();
+        registry.recording.store(true);
+        startThread(juce::Thread::Priority::low);
+    }
+
+    ~Exporter() override
+    {
+        registry.recording.store(false);
+        stopThread(1000);
+        drain();
+
+        if (stream->openedOk())
+        {
+            for (int index = 0; index < juce::jmin(registry.numClaimed.load(), Registry::maxThreads); ++index)
+                *stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << index
+                        << ",\"args\":{\"name\":\"thread " << index << " (" << static_cast<int>(registry.rings[static_cast<size_t>(index)].getDropped())
+                        << " events dropped)\"}},\n";
+
+            *stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":\"" << file.getFileNameWithoutExtension() << "\"}}\n]\n";
+            stream->flush();
+        }
+    }
+
+private:
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wait(50);
+            drain();
+        }
+    }
+
+    void drain()
+    {
+        if (!stream->openedOk())
+            return;
+
+        const int numRings = juce::jmin(registry.numClaimed.load(), Registry::maxThreads);
+
+        for (int index = 0; index < numRings; ++index)
+        {
+            registry.rings[static_cast<size_t>(index)].drain([&](const Event& event)
+            {
+                *stream << "{\"cat\":\"" << event.category << "\",\"name\":\"" << event.name
+                        << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << index
+                        << ",\"ts\":" << juce::String(static_cast<double>(event.startNs - origin) * 1.0e-3, 3)
+                        << ",\"dur\":" << juce::String(static_cast<double>(event.durationNs) * 1.0e-3, 3) << "},\n";
+            });
+        }
+
+        stream->flush();
+    }
+
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    std::int64_t origin = 0;
+    const int pid = 1;  // One process per file
+};
+
+// Held by each processor: the first one starts the exporter, the last one stops it.
+// Constructed and destroyed on the message thread.
+class Session
+{
+public:
+    explicit Session(const char* pluginName)
+    {
+        const std::lock_guard<std::mutex> lock(getMutex());
+
+        if (getCount()++ == 0)
+            getExporter() = std::make_unique<Exporter>(pluginName);
+    }
+
+    ~Session()
+    {
+        const std::lock_guard<std::mutex> lock(getMutex());
+
+        if (--getCount() == 0)
+            getExporter().reset();
+    }
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+private:
+    static std::mutex& getMutex() { static std::mutex mutex; return mutex; }
+    static int& getCount() { static int count = 0; return count; }
+    static std::unique_ptr<Exporter>& getExporter() { static std::unique_ptr<Exporter> exporter; return exporter; }
+};
+
+} // namespace pfs::trace
+
+ #define PFS_TRACE_CONCAT_INNER(a, b) a##b
+ #define PFS_TRACE_CONCAT(a, b) PFS_TRACE_CONCAT_INNER(a, b)
+ #define PFS_TRACE_SCOPE(category, name) const pfs::trace::ScopedEvent PFS_TRACE_CONCAT(pfsTraceEvent, __LINE__) { category, name }
+ #define PFS_TRACE_SESSION(pluginName) pfs::trace::Session pfsTraceSession { pluginName }
+
+#else
+
+ #define PFS_TRACE_SCOPE(category, name) static_assert(true, "")
+ #define PFS_TRACE_SESSION(pluginName) static_assert(true, "")
+
+#endif